@@ -47,29 +47,30 @@ Config_File::read( const string& file_name )
 
 	unsigned       line_count = 0;
 	string         line;   // single line from file
+	string         var;    // variable name (first word on the line)
 	vector<string> words;  // whitespace-delimited words found on a single line
+	vector<string> values; // words after the variable
 
 	// read and store each line of the configuration file
 	while( getline( config_file, line ) )
 	{
 		++line_count;
 
-		// strip comments from each line, split lines into words,
-		// and skip empty lines
-		remove_comments( line, "#" );
-		words = split_string( line );
-		if( words.empty() )
+		// strip comments from each line, split lines into words (combining
+		// quoted words into single strings, e.g., '~/some dir'), and skip empty
+		// lines
+		const unsigned num_words = lex_line( line, words, "#" );
+		if( num_words == 0 )
 		{
 			continue;
 		}
 
-		// use the first word, in lower case, as the variable to assign;
-		// combine quoted words into single strings, e.g., '~/some dir'
-		const string var = words[0];
-		words.erase( words.begin(), words.begin() + 1 );
-		words = merge_quoted_words( words );
+		// use the first word as the variable to assign and the rest as its
+		// values (copied into values' strings, which are reused like words')
+		var.swap( words[0] );
+		values.assign( words.begin() + 1, words.begin() + num_words );
 
-		set_variables( var, words, line_count );
+		set_variables( var, values, line_count );
 	}
 	verify_parameters();
 }
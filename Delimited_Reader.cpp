@@ -0,0 +1,554 @@
+/**
+	@file   Delimited_Reader.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Class Delimited_Reader.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#include "Delimited_Reader.hpp"
+
+// c++ headers
+#include <algorithm>
+#include <charconv>
+#include <limits>
+
+// tools headers
+#include "parallel.hpp"
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+using namespace ws_tools;
+
+/// Smallest piece of a file given to a thread by read_columns()
+static const size_t min_chunk_size = 1 << 20;
+
+/**
+	Convert field to double.
+
+	Surrounding blanks and a leading '+' are allowed. An empty field is a
+	missing value and becomes NaN.
+
+	@param[in] field Field to convert
+	@param[out] value Converted value (NaN if not a number)
+	@retval ok Whether the field was a number or empty
+ */
+static inline bool
+field_to_double( string_view field, double* value )
+{
+	const char* begin = field.data();
+	const char* end   = begin + field.size();
+	while( begin != end && (*begin == ' ' || *begin == '\t') )
+	{
+		++begin;
+	}
+	while( begin != end && (end[-1] == ' ' || end[-1] == '\t') )
+	{
+		--end;
+	}
+
+	*value = std::numeric_limits<double>::quiet_NaN();
+	if( begin == end )
+	{
+		return( true );
+	}
+	if( *begin == '+' )
+	{
+		++begin;
+	}
+
+	std::from_chars_result result = std::from_chars( begin, end, *value );
+	if( result.ec != std::errc() || result.ptr != end )
+	{
+		*value = std::numeric_limits<double>::quiet_NaN();
+		return( false );
+	}
+	return( true );
+}
+
+/**
+	Construct reader for the given file, which is memory mapped.
+	@param[in] file_name File to read from
+	@param[in] separator Character between fields, e.g., ',' or '\t'
+	@param[in] quote Character around quoted fields ('\0' for none)
+	@param[in] escape Character inside quoted fields that makes the next
+		character literal, e.g., '\\' ('\0' for none)
+ */
+Delimited_Reader::Delimited_Reader( const string& file_name, char separator,
+		char quote, char escape )
+: _file( file_name ), _begin( _file.data() ),
+	_end( _file.data() + _file.size() ), _pos( _begin ), _line_num(0),
+	_next_line(1), _separator( separator ), _quote( quote ), _escape( escape )
+{
+	_file.advise_sequential();
+}
+
+/**
+	Construct reader for text already in memory, which must remain valid while
+	the reader is used.
+	@param[in] data Text to read
+	@param[in] size Number of bytes of text
+	@param[in] separator Character between fields, e.g., ',' or '\t'
+	@param[in] quote Character around quoted fields ('\0' for none)
+	@param[in] escape Character inside quoted fields that makes the next
+		character literal, e.g., '\\' ('\0' for none)
+ */
+Delimited_Reader::Delimited_Reader( const char* data, size_t size,
+		char separator, char quote, char escape )
+: _begin( data ), _end( data + size ), _pos( data ), _line_num(0),
+	_next_line(1), _separator( separator ), _quote( quote ), _escape( escape )
+{ }
+
+/**
+	Read the next record.
+
+	@param[out] row Fields of the record, which are valid until the next call
+		to next_row() and while the reader exists
+	@retval found Whether a record was read (false at the end of the text)
+ */
+bool
+Delimited_Reader::next_row( Row& row )
+{
+	size_t num_blank    = 0;
+	size_t num_newlines = 0;
+	_pos = parse_record( _pos, _end, _end, _state, row, num_blank,
+			num_newlines );
+
+	_line_num   = _next_line + num_blank;
+	_next_line += num_newlines;
+	return( !row.empty() );
+}
+
+/**
+	Parse a single record.
+
+	Leading empty lines are skipped first; if that reaches record_limit, no
+	record is parsed, which lets a thread stop exactly where the next thread's
+	chunk begins.
+
+	@param[in] p Start of the record (or of empty lines before it)
+	@param[in] record_limit Position at which no new record may start
+	@param[in] end End of the text (a record may run past record_limit)
+	@param[in,out] state Buffers for the fields
+	@param[out] row Fields of the record (empty if there is none)
+	@param[out] num_blank Number of empty lines skipped
+	@param[out] num_newlines Number of newlines consumed, including those that
+		were skipped and those inside quoted fields
+	@retval p Start of the next record
+ */
+const char*
+Delimited_Reader::parse_record( const char* p, const char* record_limit,
+		const char* end, Parse_State& state, Row& row, size_t& num_blank,
+		size_t& num_newlines ) const
+{
+	state.spans.clear();
+	state.scratch.clear();
+	row.clear();
+	num_blank    = 0;
+	num_newlines = 0;
+
+	// skip empty lines
+	while( p < record_limit && (*p == '\n' || *p == '\r') )
+	{
+		if( *p == '\n' )
+		{
+			++num_blank;
+		}
+		++p;
+	}
+	num_newlines = num_blank;
+	if( p >= record_limit )
+	{
+		return( p );
+	}
+
+	// parse each field
+	while( true )
+	{
+		Field_Span span = { false, static_cast<size_t>( p - _begin ), 0 };
+
+		if( _quote != '\0' && p != end && *p == _quote )
+		{
+			// quoted field: runs to the matching quote
+			const char* start  = ++p;
+			bool        closed = false;
+			span.offset = p - _begin;
+			while( true )
+			{
+				if( p == end )
+				{
+					err_warn( "Delimited_Reader: Missing matching quote at end of "
+							"text\n" );
+					break;
+				}
+
+				const char c = *p;
+				const bool is_doubled_quote = (c == _quote && p + 1 != end
+						&& p[1] == _quote);
+				const bool is_escape = (_escape != '\0' && c == _escape
+						&& p + 1 != end);
+
+				if( c == _quote && !is_doubled_quote )
+				{
+					++p;  // closing quote
+					closed = true;
+					break;
+				}
+				else if( is_doubled_quote || is_escape )
+				{
+					// the field now differs from the text, so build it in the
+					// scratch buffer
+					if( !span.in_scratch )
+					{
+						span.in_scratch = true;
+						span.offset     = state.scratch.size();
+						state.scratch.append( start, p );
+					}
+					if( p[1] == '\n' )
+					{
+						++num_newlines;
+					}
+					state.scratch += p[1];
+					p += 2;
+				}
+				else
+				{
+					if( c == '\n' )
+					{
+						++num_newlines;
+					}
+					if( span.in_scratch )
+					{
+						state.scratch += c;
+					}
+					++p;
+				}
+			}
+			if( !span.in_scratch )
+			{
+				span.length = (p - start) - (closed ? 1 : 0);
+			}
+
+			// any text between the closing quote and the separator is kept
+			while( p != end && *p != _separator && *p != '\n'
+					&& !(*p == '\r' && (p + 1 == end || p[1] == '\n')) )
+			{
+				if( !span.in_scratch )
+				{
+					span.in_scratch = true;
+					const size_t offset = state.scratch.size();
+					state.scratch.append( _begin + span.offset, span.length );
+					span.offset = offset;
+				}
+				state.scratch += *p++;
+			}
+			if( span.in_scratch )
+			{
+				span.length = state.scratch.size() - span.offset;
+			}
+		}
+		else
+		{
+			// unquoted field: runs to the separator or end of line
+			const char* start = p;
+			while( p != end && *p != _separator && *p != '\n' )
+			{
+				++p;
+			}
+			const char* field_end = p;
+			if( field_end != start && field_end[-1] == '\r'
+					&& (p == end || *p == '\n') )
+			{
+				--field_end;
+			}
+			span.length = field_end - start;
+		}
+
+		state.spans.push_back( span );
+
+		// stop at the end of the record
+		if( p == end )
+		{
+			break;
+		}
+		else if( *p == _separator )
+		{
+			++p;
+			continue;
+		}
+
+		if( *p == '\r' )
+		{
+			++p;
+		}
+		if( p != end && *p == '\n' )
+		{
+			++num_newlines;
+			++p;
+		}
+		break;
+	}
+
+	// the scratch buffer is complete, so views into it are now stable
+	for( size_t i = 0; i != state.spans.size(); ++i )
+	{
+		const Field_Span& span = state.spans[i];
+		const char* base = span.in_scratch ? state.scratch.data() : _begin;
+		row.push_back( string_view( base + span.offset, span.length ) );
+	}
+	return( p );
+}
+
+/**
+	Find the start of the first record at or after the given position.
+
+	@param[in] p Position, which need not be at the start of a record
+	@param[in] end End of the text
+	@param[in] in_quote Whether p is inside a quoted field
+	@retval start Position just after the first newline outside quotes
+ */
+const char*
+Delimited_Reader::find_record_start( const char* p, const char* end,
+		bool in_quote ) const
+{
+	for( ; p != end; ++p )
+	{
+		if( *p == _quote && _quote != '\0' )
+		{
+			in_quote = !in_quote;
+		}
+		else if( *p == '\n' && !in_quote )
+		{
+			return( p + 1 );
+		}
+	}
+	return( end );
+}
+
+/**
+	Parse records in a range of the text and convert the given columns.
+
+	@param[in] p Start of the first record
+	@param[in] record_limit Position at which no new record may start
+	@param[in] columns Indices of the columns to convert (0 based)
+	@param[out] values values[c][r] is set to column columns[c] of row r
+	@param[in] num_columns Number of columns
+	@param[in] max_rows Maximum number of rows to convert
+	@param[out] num_rows Number of rows converted
+	@param[in,out] num_bad Incremented for each field that is not a number
+	@retval p Start of the record after the last one converted
+ */
+const char*
+Delimited_Reader::read_range( const char* p, const char* record_limit,
+		const unsigned* columns, double* const* values, unsigned num_columns,
+		size_t max_rows, size_t& num_rows, size_t& num_bad ) const
+{
+	Parse_State state;
+	Row         row;
+	size_t      num_blank    = 0;
+	size_t      num_newlines = 0;
+
+	num_rows = 0;
+	while( num_rows != max_rows && p < record_limit )
+	{
+		p = parse_record( p, record_limit, _end, state, row, num_blank,
+				num_newlines );
+		if( row.empty() )
+		{
+			break;
+		}
+
+		for( unsigned c = 0; c != num_columns; ++c )
+		{
+			const unsigned col = columns[c];
+			if( col < row.size() )
+			{
+				if( !field_to_double( row[col], &values[c][num_rows] ) )
+				{
+					++num_bad;
+				}
+			}
+			else
+			{
+				values[c][num_rows] = std::numeric_limits<double>::quiet_NaN();
+			}
+		}
+		++num_rows;
+	}
+	return( p );
+}
+
+/**
+	Convert a single column of the remaining records to numbers.
+
+	@param[in] column Index of the column (0 based)
+	@param[out] values Array of at least max_rows values
+	@param[in] max_rows Maximum number of rows to read
+	@retval num_rows Number of rows read
+ */
+size_t
+Delimited_Reader::read_column( unsigned column, double* values,
+		size_t max_rows )
+{
+	return( read_columns( &column, &values, 1, max_rows ) );
+}
+
+/**
+	Convert columns of the remaining records to numbers.
+
+	Empty fields and fields missing from short rows become NaN, as do fields
+	that are not numbers (which are also reported with a warning).
+
+	With more than one thread, the text is split into chunks of at least 1 MB
+	that are parsed at the same time. Each chunk boundary is moved forward to
+	the next record: the quote characters in all chunks are counted first, so
+	the parity of the counts before a boundary tells whether the boundary is
+	inside a quoted field. This requires that quotes only appear around fields
+	(as in RFC 4180), so it is not done when an escape character is used.
+
+	@param[in] columns Indices of the columns to convert (0 based)
+	@param[out] values values[c] is an array of at least max_rows values for
+		column columns[c]
+	@param[in] num_columns Number of columns
+	@param[in] max_rows Maximum number of rows to read
+	@param[in] num_threads Number of threads to use (0 means one per processor)
+	@retval num_rows Number of rows read
+ */
+size_t
+Delimited_Reader::read_columns( const unsigned* columns, double* const* values,
+		unsigned num_columns, size_t max_rows, unsigned num_threads )
+{
+	const char* const start = _pos;
+	const size_t      size  = _end - _pos;
+	size_t            num_rows = 0;
+	size_t            num_bad  = 0;
+
+	if( num_threads == 0 )
+	{
+		num_threads = default_num_threads();
+	}
+
+	size_t num_chunks = 1;
+	if( num_threads > 1 && _escape == '\0' && size >= 2 * min_chunk_size )
+	{
+		num_chunks = std::min<size_t>( 4 * num_threads, size / min_chunk_size );
+	}
+
+	if( num_chunks == 1 )
+	{
+		_pos = read_range( _pos, _end, columns, values, num_columns, max_rows,
+				num_rows, num_bad );
+	}
+	else
+	{
+		// chunks are parsed a wave of num_threads at a time so that no more
+		// of the file than needed is read when max_rows is small
+		const size_t chunk_size = size / num_chunks;
+		vector<const char*> bounds( num_chunks + 1 );
+		bounds[0]            = start;
+		bounds[ num_chunks ] = _end;
+
+		vector<unsigned char>    odd_quotes( num_threads );
+		vector< vector<double> > chunk_values( num_threads * num_columns );
+		vector<const char*>      chunk_ends( num_threads );
+		vector<size_t>           chunk_rows( num_threads );
+		vector<size_t>           chunk_bad( num_threads );
+		bool                     in_quote = false;
+		for( size_t first = 0; first != num_chunks && num_rows != max_rows; )
+		{
+			const size_t last      = std::min( first + num_threads, num_chunks );
+			const size_t num_wave  = last - first;
+			const size_t rows_left = max_rows - num_rows;
+
+			// count quotes in each chunk (at its original boundaries) to find
+			// which of the following boundaries are quoted
+			if( _quote != '\0' )
+			{
+				parallel_for( num_wave, num_threads,
+					[&]( size_t i )
+					{
+						const size_t k = first + i;
+						const char*  b = start + k * chunk_size;
+						const char*  e = (k + 1 == num_chunks) ? _end : b + chunk_size;
+						odd_quotes[i] = std::count( b, e, _quote ) & 1;
+					} );
+			}
+
+			// move each boundary to the start of the next record
+			for( size_t k = first + 1; k != last + 1 && k != num_chunks; ++k )
+			{
+				in_quote ^= odd_quotes[ k - 1 - first ];
+				const char* b = find_record_start( start + k * chunk_size, _end,
+						in_quote );
+				bounds[k] = std::max( b, bounds[ k - 1 ] );
+			}
+
+			// parse each chunk into its own buffers
+			parallel_for( num_wave, num_threads,
+				[&]( size_t i )
+				{
+					const size_t k = first + i;
+
+					// a rough row count from the number of newlines
+					const size_t guess = std::min<size_t>( rows_left,
+						std::count( bounds[k], bounds[k + 1], '\n' ) + 1 );
+					vector<double*> chunk_ptrs( num_columns );
+					for( unsigned c = 0; c != num_columns; ++c )
+					{
+						vector<double>& v = chunk_values[ i * num_columns + c ];
+						v.resize( guess );
+						chunk_ptrs[c] = v.empty() ? 0 : &v[0];
+					}
+					chunk_rows[i] = 0;
+					chunk_bad[i]  = 0;
+					chunk_ends[i] = read_range( bounds[k], bounds[k + 1], columns,
+							&chunk_ptrs[0], num_columns, guess, chunk_rows[i],
+							chunk_bad[i] );
+				} );
+
+			// gather the chunks in order
+			for( size_t i = 0; i != num_wave && num_rows != max_rows; ++i )
+			{
+				const size_t n = std::min( chunk_rows[i], max_rows - num_rows );
+				for( unsigned c = 0; c != num_columns; ++c )
+				{
+					std::copy( chunk_values[ i * num_columns + c ].begin(),
+							chunk_values[ i * num_columns + c ].begin() + n,
+							values[c] + num_rows );
+				}
+				num_rows += n;
+				num_bad  += chunk_bad[i];
+
+				if( n != chunk_rows[i] )
+				{
+					// stopped inside this chunk: find where the next record starts
+					size_t skipped = 0;
+					size_t bad     = 0;
+					_pos = read_range( bounds[ first + i ], _end, 0, 0, 0, n,
+							skipped, bad );
+				}
+				else
+				{
+					// the chunk's end, or where it stopped if max_rows was hit
+					_pos = chunk_ends[i];
+				}
+			}
+			first = last;
+		}
+	}
+
+	_next_line += std::count( start, _pos, '\n' );
+	if( num_bad != 0 )
+	{
+		err_warn( "Delimited_Reader: %lu fields were not numbers\n",
+				static_cast<unsigned long>( num_bad ) );
+	}
+	return( num_rows );
+}
@@ -0,0 +1,142 @@
+/**
+	@file   Delimited_Reader.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Class Delimited_Reader.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _DELIMITED_READER_HPP
+#define _DELIMITED_READER_HPP
+
+// c++ headers
+#include <string>
+#include <string_view>
+#include <vector>
+
+// c headers
+#include <cstddef>
+
+// tools headers
+#include "Mapped_File.hpp"
+#include "util.hpp"
+#include "err_mesg.h"
+
+namespace ws_tools
+{
+
+/**
+	@brief Streaming reader for delimited text such as CSV and TSV files.
+
+	Records are separated by newlines ("\n" or "\r\n") and fields by the
+	separator character. A field that starts with the quote character may
+	contain separators and newlines; inside it, a doubled quote stands for one
+	quote (RFC 4180) and, if an escape character is given, the escape character
+	makes the next character literal. Empty lines are skipped.
+
+	Fields are returned as string views into the file itself, so nothing is
+	copied unless a quoted field contains escaped characters, in which case the
+	unescaped field is kept in a buffer that is valid until the next call to
+	next_row().
+
+	Example:
+		Delimited_Reader reader( "data.csv" );
+		Delimited_Reader::Row row;
+		reader.next_row( row );  // skip the header
+		std::vector<double> x( num_rows );
+		num_rows = reader.read_column( 2, &x[0], num_rows );
+ */
+class Delimited_Reader
+{
+
+public:
+
+	/// Fields of a single record
+	typedef std::vector<std::string_view> Row;
+
+	Delimited_Reader( const std::string&, char = ',', char = '"', char = '\0' );
+	Delimited_Reader( const char*, std::size_t, char = ',', char = '"',
+			char = '\0' );
+
+	/**
+		Destructor does nothing since the file is unmapped by its own object.
+	 */
+	virtual ~Delimited_Reader( )
+	{ }
+
+	bool next_row( Row& );
+
+	/**
+		Start reading again from the first record.
+	 */
+	inline void rewind( )
+	{
+		_pos       = _begin;
+		_line_num  = 0;
+		_next_line = 1;
+	}
+
+	/**
+		Return the line number of the start of the most recent record (1 for the
+		first line of the file).
+		@retval line_num Line number
+	 */
+	inline std::size_t line_num( ) const
+	{
+		return( _line_num );
+	}
+
+	std::size_t read_column( unsigned, double*, std::size_t );
+	std::size_t read_columns( const unsigned*, double* const*, unsigned,
+			std::size_t, unsigned = 1 );
+
+private:
+
+	/**
+		@brief Location of a field while its record is being parsed.
+	 */
+	struct Field_Span
+	{
+		bool        in_scratch;  //< Whether field is in the scratch buffer
+		std::size_t offset;      //< Offset into the data or scratch buffer
+		std::size_t length;      //< Number of characters
+	};
+
+	/**
+		@brief Per-thread state for parsing records.
+	 */
+	struct Parse_State
+	{
+		std::vector<Field_Span> spans;    //< Fields of the current record
+		std::string             scratch;  //< Unescaped quoted fields
+	};
+
+	const char* parse_record( const char*, const char*, const char*,
+			Parse_State&, Row&, std::size_t&, std::size_t& ) const;
+	const char* find_record_start( const char*, const char*, bool ) const;
+
+	const char* read_range( const char*, const char*, const unsigned*,
+			double* const*, unsigned, std::size_t, std::size_t&,
+			std::size_t& ) const;
+
+	Mapped_File _file;       //< File being read (unused for memory buffers)
+	const char* _begin;      //< First byte of the text
+	const char* _end;        //< One past the last byte of the text
+	const char* _pos;        //< Start of the next record
+	std::size_t _line_num;   //< Line number of the most recent record
+	std::size_t _next_line;  //< Line number at _pos
+	char        _separator;  //< Character between fields
+	char        _quote;      //< Character around quoted fields
+	char        _escape;     //< Character that escapes the next one ('\0' for
+	                         //  none)
+	Parse_State _state;      //< State for next_row()
+
+};
+
+} // namespace ws_tools
+
+#endif // _DELIMITED_READER_HPP
@@ -0,0 +1,305 @@
+/**
+	@file   Dir_Walker.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Class Dir_Walker.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#include "Dir_Walker.hpp"
+
+// c headers
+#include <cstring>
+
+// system headers
+#include <fcntl.h>
+#include <unistd.h>
+
+// tools headers
+#include "string_sort.hpp"
+
+using std::string;
+using std::vector;
+
+using namespace ws_tools;
+
+/**
+	Start walking the given directory.
+	@param[in] directory_name Name of directory to walk
+	@param[in] recursive Whether to walk subdirectories (true) or only list the
+		top directory's regular files, as dir_open() does (false)
+	@param[in] sorted Whether each directory's entries are visited in name
+		order, which returns files in tree order (see sort_paths()), and each
+		directory is walked once however many soft links lead to it
+	@param[in] filter Predicate function invoked on all regular files--only those
+		file names for which the predicate is true are returned
+ */
+Dir_Walker::Dir_Walker( const string& directory_name, bool recursive,
+	bool sorted, bool (*filter)( const string& ) )
+: _recursive( recursive ), _sorted( sorted ), _filter( filter )
+{
+	if( directory_name == "" )
+	{
+		return;
+	}
+
+	// remove slash from end of directory name and add home area if present
+	string dir_name = sub_home( directory_name );
+	string::size_type slash_pos = dir_name.find_last_of( '/' );
+	if( slash_pos == dir_name.size() - 1 && slash_pos != 0 )
+	{
+		dir_name.erase( slash_pos );
+	}
+
+	struct stat stat_buf;
+	if( stat( dir_name.c_str(), &stat_buf ) < 0 )
+	{
+		err_warn( "Unable to access file '%s'\n", dir_name.c_str() );
+		return;
+	}
+	else if( access( dir_name.c_str(), R_OK ) < 0 )
+	{
+		err_warn( "Unable to read file '%s'\n", dir_name.c_str() );
+		return;
+	}
+
+	if( S_ISREG( stat_buf.st_mode ) )
+	{
+		_top_file = dir_name;
+		_top_stat = stat_buf;
+	}
+	else if( S_ISDIR( stat_buf.st_mode ) )
+	{
+		push( AT_FDCWD, dir_name.c_str(), dir_name, stat_buf );
+	}
+}
+
+/**
+	Close the directories still open.
+ */
+Dir_Walker::~Dir_Walker( )
+{
+	for( unsigned i = 0; i != _levels.size(); ++i )
+	{
+		closedir( _levels[i].dir );
+	}
+}
+
+/**
+	Open a directory and make it the one being read.
+	@param[in] parent_fd Descriptor of the directory that name is relative to
+	@param[in] name Name of the directory
+	@param[in] path Path of the directory
+	@param[in] stat_buf Status of the directory
+ */
+void
+Dir_Walker::push( int parent_fd, const char* name, const string& path,
+	const struct stat& stat_buf )
+{
+	const int fd = openat( parent_fd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+	DIR* dir = (fd < 0) ? 0 : fdopendir( fd );
+	if( dir == 0 )
+	{
+		if( fd >= 0 )
+		{
+			close( fd );
+		}
+		err_warn( "Unable to open directory %s\n", path.c_str() );
+		return;
+	}
+
+	Level level;
+	level.dir  = dir;
+	level.dev  = stat_buf.st_dev;
+	level.ino  = stat_buf.st_ino;
+	level.path = path;
+	if( path != "/" )
+	{
+		level.path += '/';
+	}
+	level.next = 0;
+
+	if( _sorted )
+	{
+		_walked.insert( std::make_pair( stat_buf.st_dev, stat_buf.st_ino ) );
+		dirent* dep;
+		while( (dep = readdir( dir )) != NULL )
+		{
+			if( strcmp( dep->d_name, "." ) != 0
+					&& strcmp( dep->d_name, ".." ) != 0 )
+			{
+				level.names.push_back( dep->d_name );
+			}
+		}
+		sort_strings( level.names );
+	}
+
+	_levels.push_back( std::move( level ) );
+}
+
+/**
+	Return the name of the next entry of a directory.
+	@param[in,out] level Directory being read
+	@retval name Name of the entry or 0 if there are no more
+ */
+const char*
+Dir_Walker::next_name( Level& level )
+{
+	if( _sorted )
+	{
+		return( (level.next == level.names.size()) ? 0
+			: level.names[ level.next++ ].c_str() );
+	}
+
+	dirent* dep;
+	while( (dep = readdir( level.dir )) != NULL )
+	{
+		if( strcmp( dep->d_name, "." ) != 0 && strcmp( dep->d_name, ".." ) != 0 )
+		{
+			return( dep->d_name );
+		}
+	}
+	return( 0 );
+}
+
+/**
+	Determine whether a directory is open already, i.e., whether entering it
+	would go around a cycle of soft links.
+	@param[in] stat_buf Status of the directory
+	@retval on_path Whether the directory is on the current path
+ */
+bool
+Dir_Walker::on_path( const struct stat& stat_buf ) const
+{
+	for( unsigned i = 0; i != _levels.size(); ++i )
+	{
+		if( _levels[i].dev == stat_buf.st_dev
+				&& _levels[i].ino == stat_buf.st_ino )
+		{
+			return( true );
+		}
+	}
+	return( false );
+}
+
+/**
+	Determine whether a directory was walked already: in sorted mode, whether
+	it was entered at any point of the walk, as dir_traverse() checks, or
+	otherwise whether it is on the current path.
+	@param[in] stat_buf Status of the directory
+	@retval walked Whether the directory was walked already
+ */
+bool
+Dir_Walker::walked( const struct stat& stat_buf ) const
+{
+	if( _sorted )
+	{
+		return( _walked.count( std::make_pair( stat_buf.st_dev,
+						stat_buf.st_ino ) ) != 0 );
+	}
+	return( on_path( stat_buf ) );
+}
+
+/**
+	Find the next file.
+	@param[out] file_name Path of the file
+	@param[out] stat_buf Status of the file (following soft links) if not null
+	@retval found Whether a file was found (false once the walk is done)
+ */
+bool
+Dir_Walker::next( string& file_name, struct stat* stat_buf )
+{
+	if( !_top_file.empty() )
+	{
+		file_name.swap( _top_file );
+		_top_file.clear();
+		if( _filter( file_name ) )
+		{
+			if( stat_buf != 0 )
+			{
+				*stat_buf = _top_stat;
+			}
+			return( true );
+		}
+	}
+
+	while( !_levels.empty() )
+	{
+		Level& level = _levels.back();
+		const char* name = next_name( level );
+		if( name == 0 )
+		{
+			closedir( level.dir );
+			_levels.pop_back();
+			continue;
+		}
+		const int dir_fd = dirfd( level.dir );
+		file_name.assign( level.path ).append( name );
+
+		// read file information into status buffer
+		struct stat file_stat;
+		if( fstatat( dir_fd, name, &file_stat, AT_SYMLINK_NOFOLLOW ) < 0 )
+		{
+			err_warn( "Unable to access file '%s'\n", file_name.c_str() );
+			continue;
+		}
+
+		// test for read permission
+		else if( faccessat( dir_fd, name, R_OK, 0 ) < 0 )
+		{
+			err_warn( "Unable to read file '%s'\n", file_name.c_str() );
+			continue;
+		}
+
+		// follow soft links when recursing (dir_open() skips them); a soft link
+		// to nothing is skipped
+		if( S_ISLNK( file_stat.st_mode ) )
+		{
+			if( !_recursive || fstatat( dir_fd, name, &file_stat, 0 ) < 0 )
+			{
+				continue;
+			}
+		}
+
+		if( S_ISREG( file_stat.st_mode ) )
+		{
+			if( _filter( file_name ) )
+			{
+				if( stat_buf != 0 )
+				{
+					*stat_buf = file_stat;
+				}
+				return( true );
+			}
+		}
+		else if( S_ISDIR( file_stat.st_mode ) )
+		{
+			if( _recursive && !walked( file_stat ) )
+			{
+				push( dir_fd, name, file_name, file_stat );
+			}
+		}
+		else if( S_ISCHR( file_stat.st_mode ) )
+		{
+			err_warn( "Ignoring character special file: '%s'\n",
+				file_name.c_str() );
+		}
+		else if( S_ISBLK( file_stat.st_mode ) )
+		{
+			err_warn( "Ignoring block special file: '%s'\n", file_name.c_str() );
+		}
+		else if( S_ISFIFO( file_stat.st_mode ) )
+		{
+			err_warn( "Ignoring pipe file: '%s'\n", file_name.c_str() );
+		}
+		else if( S_ISSOCK( file_stat.st_mode ) )
+		{
+			err_warn( "Ignoring socket file: '%s'\n", file_name.c_str() );
+		}
+	}
+	return( false );
+}
@@ -0,0 +1,133 @@
+/**
+	@file   Dir_Walker.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Class Dir_Walker.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _DIR_WALKER_HPP
+#define _DIR_WALKER_HPP
+
+// c++ headers
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+// c headers
+#include <cstddef>
+
+// system headers
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+// tools headers
+#include "util.hpp"
+#include "err_mesg.h"
+
+namespace ws_tools
+{
+
+/**
+	@brief Depth-first walk over the files of a directory tree, one file at a
+	time.
+
+	Only the directories from the top directory down to the current one are
+	open, each as a DIR* whose entries are read as they are needed, so memory
+	grows with the depth of the tree rather than with the number of files in
+	it (in sorted mode, each open directory's entry names are also kept, so
+	memory grows with depth times fan-out). Entries are examined relative to
+	their directory's descriptor, so the kernel does not resolve each full
+	path again.
+
+	Files are chosen as in dir_traverse(): regular files that pass the filter,
+	following soft links to files and directories. Sorted walkers remember
+	every directory entered (by its device and inode numbers), so, as in
+	dir_traverse(), a directory that several soft links lead to is walked only
+	the first time it is reached. Unsorted walkers keep memory bounded by the
+	depth instead by remembering only the directories on the current path, so
+	a link back to one of them is not followed, but a directory that several
+	links lead to from elsewhere is walked once for each. Non-recursive walkers
+	list the regular files of the top directory only, as dir_open() does.
+
+	Example:
+		Dir_Walker walker( "logs" );
+		std::string file_name;
+		while( walker.next( file_name ) )
+		{
+			process( file_name );
+		}
+ */
+class Dir_Walker
+{
+
+public:
+
+	Dir_Walker( const std::string&, bool = true, bool = false,
+			bool (*)( const std::string& ) = all_true );
+
+	virtual ~Dir_Walker( );
+
+	bool next( std::string&, struct stat* = 0 );
+
+	/**
+		Return the number of directories currently open, i.e., the depth of the
+		walk below the top directory plus one.
+		@retval depth Number of open directories
+	 */
+	inline std::size_t depth( ) const
+	{
+		return( _levels.size() );
+	}
+
+private:
+
+	/**
+		@brief Directory being read.
+	 */
+	struct Level
+	{
+		DIR*                     dir;    //< Open directory
+		dev_t                    dev;    //< Device of directory
+		ino_t                    ino;    //< Inode of directory
+		std::string              path;   //< Path of directory ending in '/'
+		std::vector<std::string> names;  //< Sorted entry names (sorted mode)
+		std::size_t              next;   //< Next name to return (sorted mode)
+	};
+
+	// copying would close the directories twice
+	Dir_Walker( const Dir_Walker& );
+	Dir_Walker& operator=( const Dir_Walker& );
+
+	void push( int, const char*, const std::string&, const struct stat& );
+	const char* next_name( Level& );
+	bool on_path( const struct stat& ) const;
+	bool walked( const struct stat& ) const;
+
+	/// Directories from the top directory down to the one being read
+	std::vector<Level> _levels;
+
+	/// Device and inode numbers of every directory entered (sorted mode)
+	std::set< std::pair<dev_t, ino_t> > _walked;
+
+	bool _recursive;  //< Whether to descend into subdirectories
+	bool _sorted;     //< Whether to return each directory's entries by name
+
+	/// Predicate that files must satisfy to be returned
+	bool (*_filter)( const std::string& );
+
+	/// Top directory if it is a regular file instead, to be returned once
+	std::string _top_file;
+	struct stat _top_stat;  //< Status of _top_file
+
+};
+
+} // namespace ws_tools
+
+#endif // _DIR_WALKER_HPP
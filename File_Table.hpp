@@ -0,0 +1,283 @@
+/**
+	@file   File_Table.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Class File_Table.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _FILE_TABLE_HPP
+#define _FILE_TABLE_HPP
+
+// c++ headers
+#include <string>
+#include <string_view>
+#include <vector>
+
+// c headers
+#include <cstddef>
+#include <cstdint>
+
+// system headers
+#include <sys/stat.h>
+#include <sys/types.h>
+
+// tools headers
+#include "Dir_Walker.hpp"
+#include "util.hpp"
+
+namespace ws_tools
+{
+
+/**
+	@brief Columns of file status that a File_Table can collect.
+ */
+enum File_Field
+{
+	File_Size  = 1 << 0,  //< st_size
+	File_Mtime = 1 << 1,  //< st_mtim in nanoseconds since the epoch
+	File_Mode  = 1 << 2,  //< st_mode
+	File_Ino   = 1 << 3,  //< st_ino
+	File_Dev   = 1 << 4,  //< st_dev
+	File_Nlink = 1 << 5,  //< st_nlink
+	File_All   = (1 << 6) - 1
+};
+
+/**
+	@brief Paths and status of the files in a directory tree, stored by
+	column.
+
+	Paths are stored end to end in a single buffer, and each chosen field is
+	a separate array indexed by file number, so scanning one field (e.g.,
+	summing sizes or finding old files) reads only that field's memory. The
+	status comes from the traversal itself, so no file is stat()'d twice.
+
+	Fields is a bitwise OR of File_Field values; fields not chosen take no
+	space, and asking for one is a compile-time error.
+
+	Example:
+		File_Table<File_Size | File_Mtime> table( "data" );
+		uint64_t total = 0;
+		for( std::size_t i = 0; i != table.num_files(); ++i )
+		{
+			total += table.size( i );
+		}
+ */
+template<unsigned Fields>
+class File_Table
+{
+
+public:
+
+	/**
+		Create empty table.
+	 */
+	File_Table( )
+	{
+		clear();
+	}
+
+	/**
+		Create table of the files in a directory tree.
+		@param[in] directory_name Directory to walk
+		@param[in] sorted Whether files are in tree order (see sort_paths())
+		@param[in] filter Predicate function invoked on all regular files--only
+			those files for which the predicate is true are added
+	 */
+	File_Table( const std::string& directory_name, bool sorted = false,
+			bool (*filter)( const std::string& ) = all_true )
+	{
+		clear();
+		add_dir( directory_name, sorted, filter );
+	}
+
+	/**
+		Destructor does nothing.
+	 */
+	virtual ~File_Table( )
+	{ }
+
+	/**
+		Remove all files.
+	 */
+	void clear( )
+	{
+		_paths.clear();
+		_path_offsets.assign( 1, 0 );
+		_sizes.clear();
+		_mtimes.clear();
+		_modes.clear();
+		_inos.clear();
+		_devs.clear();
+		_nlinks.clear();
+	}
+
+	/**
+		Add the files in a directory tree (walked with Dir_Walker).
+		@param[in] directory_name Directory to walk
+		@param[in] sorted Whether files are added in tree order
+		@param[in] filter Predicate function invoked on all regular files--only
+			those files for which the predicate is true are added
+	 */
+	void add_dir( const std::string& directory_name, bool sorted = false,
+			bool (*filter)( const std::string& ) = all_true )
+	{
+		Dir_Walker walker( directory_name, true, sorted, filter );
+		std::string file_name;
+		struct stat stat_buf;
+		while( walker.next( file_name, &stat_buf ) )
+		{
+			add( file_name, stat_buf );
+		}
+	}
+
+	/**
+		Add a file.
+		@param[in] path Path of file
+		@param[in] stat_buf Status of file
+	 */
+	void add( std::string_view path, const struct stat& stat_buf )
+	{
+		_paths.append( path.data(), path.size() );
+		_path_offsets.push_back( _paths.size() );
+
+		if constexpr( (Fields & File_Size) != 0 )
+		{
+			_sizes.push_back( stat_buf.st_size );
+		}
+		if constexpr( (Fields & File_Mtime) != 0 )
+		{
+			_mtimes.push_back( static_cast<int64_t>( stat_buf.st_mtim.tv_sec )
+					* 1000000000 + stat_buf.st_mtim.tv_nsec );
+		}
+		if constexpr( (Fields & File_Mode) != 0 )
+		{
+			_modes.push_back( stat_buf.st_mode );
+		}
+		if constexpr( (Fields & File_Ino) != 0 )
+		{
+			_inos.push_back( stat_buf.st_ino );
+		}
+		if constexpr( (Fields & File_Dev) != 0 )
+		{
+			_devs.push_back( stat_buf.st_dev );
+		}
+		if constexpr( (Fields & File_Nlink) != 0 )
+		{
+			_nlinks.push_back( stat_buf.st_nlink );
+		}
+	}
+
+	/**
+		Return the number of files.
+		@retval num_files Number of files
+	 */
+	inline std::size_t num_files( ) const
+	{
+		return( _path_offsets.size() - 1 );
+	}
+
+	/**
+		Return the path of a file.
+		@param[in] i Index of file
+		@retval path Path of file (valid until the next file is added)
+	 */
+	inline std::string_view path( std::size_t i ) const
+	{
+		return( std::string_view( _paths.data() + _path_offsets[i],
+				_path_offsets[i + 1] - _path_offsets[i] ) );
+	}
+
+	/// @name Fields of a single file
+	/// @{
+	inline uint64_t size( std::size_t i ) const
+	{
+		return( sizes()[i] );
+	}
+
+	inline int64_t mtime( std::size_t i ) const
+	{
+		return( mtimes()[i] );
+	}
+
+	inline mode_t mode( std::size_t i ) const
+	{
+		return( modes()[i] );
+	}
+
+	inline ino_t ino( std::size_t i ) const
+	{
+		return( inos()[i] );
+	}
+
+	inline dev_t dev( std::size_t i ) const
+	{
+		return( devs()[i] );
+	}
+
+	inline nlink_t nlink( std::size_t i ) const
+	{
+		return( nlinks()[i] );
+	}
+	/// @}
+
+	/// @name Whole columns
+	/// @{
+	inline const std::vector<uint64_t>& sizes( ) const
+	{
+		static_assert( (Fields & File_Size) != 0, "File_Size not collected" );
+		return( _sizes );
+	}
+
+	inline const std::vector<int64_t>& mtimes( ) const
+	{
+		static_assert( (Fields & File_Mtime) != 0, "File_Mtime not collected" );
+		return( _mtimes );
+	}
+
+	inline const std::vector<mode_t>& modes( ) const
+	{
+		static_assert( (Fields & File_Mode) != 0, "File_Mode not collected" );
+		return( _modes );
+	}
+
+	inline const std::vector<ino_t>& inos( ) const
+	{
+		static_assert( (Fields & File_Ino) != 0, "File_Ino not collected" );
+		return( _inos );
+	}
+
+	inline const std::vector<dev_t>& devs( ) const
+	{
+		static_assert( (Fields & File_Dev) != 0, "File_Dev not collected" );
+		return( _devs );
+	}
+
+	inline const std::vector<nlink_t>& nlinks( ) const
+	{
+		static_assert( (Fields & File_Nlink) != 0, "File_Nlink not collected" );
+		return( _nlinks );
+	}
+	/// @}
+
+private:
+
+	std::string           _paths;         //< All paths end to end
+	std::vector<uint64_t> _path_offsets;  //< Start of each path, plus the end
+
+	std::vector<uint64_t> _sizes;   //< Size of each file in bytes
+	std::vector<int64_t>  _mtimes;  //< Modification time of each file (ns)
+	std::vector<mode_t>   _modes;   //< Type and permissions of each file
+	std::vector<ino_t>    _inos;    //< Inode number of each file
+	std::vector<dev_t>    _devs;    //< Device of each file
+	std::vector<nlink_t>  _nlinks;  //< Number of hard links to each file
+
+};
+
+} // namespace ws_tools
+
+#endif // _FILE_TABLE_HPP
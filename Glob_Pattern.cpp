@@ -0,0 +1,613 @@
+/**
+	@file   Glob_Pattern.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Class Glob_Pattern.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#include "Glob_Pattern.hpp"
+
+// c++ headers
+#include <algorithm>
+
+// c headers
+#include <cstring>
+
+// system headers
+#include <dirent.h>
+#include <sys/stat.h>
+
+// tools headers
+#include "string_sort.hpp"
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+using namespace ws_tools;
+
+/**
+	Compile a pattern.
+	@param[in] pattern Pattern to compile
+ */
+Glob_Pattern::Glob_Pattern( const string& pattern )
+: _pattern( pattern ), _absolute( false )
+{
+	const string path = sub_home( pattern );
+	_absolute = (!path.empty() && path[0] == '/');
+
+	// split at each '/' that is not inside braces, skipping empty segments
+	size_t start = 0;
+	while( start <= path.size() )
+	{
+		size_t end   = start;
+		int    depth = 0;
+		for( ; end != path.size(); ++end )
+		{
+			if( path[end] == '\\' && end + 1 != path.size() )
+			{
+				++end;
+			}
+			else if( path[end] == '{' )
+			{
+				++depth;
+			}
+			else if( path[end] == '}' && depth > 0 )
+			{
+				--depth;
+			}
+			else if( path[end] == '/' && depth == 0 )
+			{
+				break;
+			}
+		}
+		const string text = path.substr( start, end - start );
+		start = end + 1;
+		if( text.empty() )
+		{
+			continue;
+		}
+
+		Segment segment;
+		segment.is_double_star = (text == "**");
+		segment.is_literal     = !segment.is_double_star;
+		if( !segment.is_double_star )
+		{
+			const vector<string> alternatives = expand_braces( text );
+			for( unsigned i = 0; i != alternatives.size(); ++i )
+			{
+				if( alternatives[i].find( '/' ) != string::npos )
+				{
+					err_quit( "Braces in pattern '%s' contain '/'\n",
+							pattern.c_str() );
+				}
+				bool is_literal = true;
+				segment.alternatives.push_back(
+						compile_alternative( alternatives[i], is_literal ) );
+				segment.is_literal = segment.is_literal && is_literal;
+			}
+			if( segment.is_literal )
+			{
+				for( unsigned i = 0; i != segment.alternatives.size(); ++i )
+				{
+					const Token_List& tokens = segment.alternatives[i];
+					string name;
+					for( unsigned j = 0; j != tokens.size(); ++j )
+					{
+						name += tokens[j].c;
+					}
+					segment.literals.push_back( name );
+				}
+				std::sort( segment.literals.begin(), segment.literals.end() );
+				segment.literals.erase( std::unique( segment.literals.begin(),
+							segment.literals.end() ), segment.literals.end() );
+			}
+		}
+
+		// '**' after '**' adds nothing
+		if( !(segment.is_double_star && !_segments.empty()
+					&& _segments.back().is_double_star) )
+		{
+			_segments.push_back( std::move( segment ) );
+		}
+	}
+}
+
+/**
+	Expand the braces in one segment of a pattern into the alternatives they
+	represent, e.g., "a{b,c{d,e}}" to "ab", "acd", and "ace".
+	Unmatched braces are literal.
+	@param[in] text Segment of pattern
+	@retval alternatives Segments without braces
+ */
+vector<string>
+Glob_Pattern::expand_braces( const string& text )
+{
+	// find the first top-level '{' and its matching '}'
+	size_t open = string::npos;
+	size_t close = string::npos;
+	vector<size_t> commas;
+	int depth = 0;
+	for( size_t i = 0; i != text.size() && close == string::npos; ++i )
+	{
+		if( text[i] == '\\' )
+		{
+			++i;
+			if( i == text.size() )
+			{
+				break;
+			}
+		}
+		else if( text[i] == '{' )
+		{
+			if( depth++ == 0 )
+			{
+				open = i;
+				commas.clear();
+			}
+		}
+		else if( text[i] == '}' && depth > 0 )
+		{
+			if( --depth == 0 )
+			{
+				close = i;
+			}
+		}
+		else if( text[i] == ',' && depth == 1 )
+		{
+			commas.push_back( i );
+		}
+	}
+	if( close == string::npos )
+	{
+		return( vector<string>( 1, text ) );
+	}
+
+	// expand each alternative along with the rest of the segment
+	const string prefix = text.substr( 0, open );
+	const string suffix = text.substr( close + 1 );
+	commas.push_back( close );
+	vector<string> alternatives;
+	size_t start = open + 1;
+	for( unsigned i = 0; i != commas.size(); ++i )
+	{
+		const vector<string> expanded = expand_braces(
+				prefix + text.substr( start, commas[i] - start ) + suffix );
+		alternatives.insert( alternatives.end(), expanded.begin(),
+				expanded.end() );
+		start = commas[i] + 1;
+	}
+	return( alternatives );
+}
+
+/**
+	Compile one brace alternative of a segment into tokens.
+	@param[in] text Segment without braces
+	@param[out] is_literal Whether the segment has no wildcards
+	@retval tokens Tokens
+ */
+Glob_Pattern::Token_List
+Glob_Pattern::compile_alternative( const string& text, bool& is_literal )
+{
+	Token_List tokens;
+	is_literal = true;
+	for( size_t i = 0; i != text.size(); ++i )
+	{
+		Token token;
+		token.kind = Token::Literal;
+		token.c    = text[i];
+		if( text[i] == '\\' && i + 1 != text.size() )
+		{
+			token.c = text[++i];
+		}
+		else if( text[i] == '?' )
+		{
+			token.kind = Token::Any_Char;
+		}
+		else if( text[i] == '*' )
+		{
+			token.kind = Token::Any_String;
+			if( !tokens.empty() && tokens.back().kind == Token::Any_String )
+			{
+				continue;
+			}
+		}
+		else if( text[i] == '[' )
+		{
+			// a ']' right after '[' or the negation is part of the set
+			size_t j = i + 1;
+			const bool negate = (j != text.size()
+					&& (text[j] == '!' || text[j] == '^'));
+			if( negate )
+			{
+				++j;
+			}
+			if( j != text.size() && text[j] == ']' )
+			{
+				++j;
+			}
+			j = text.find( ']', j );
+
+			// a '[' without a ']' is literal
+			if( j != string::npos )
+			{
+				token.kind = Token::Char_Set;
+				size_t k = i + 1 + (negate ? 1 : 0);
+				while( k != j )
+				{
+					const unsigned char low = text[k];
+					unsigned char high = low;
+					if( k + 2 < j && text[k + 1] == '-' )
+					{
+						high = text[k + 2];
+						k += 2;
+					}
+					for( unsigned c = low; c <= high; ++c )
+					{
+						token.chars.set( c );
+					}
+					++k;
+				}
+				if( negate )
+				{
+					token.chars.flip();
+				}
+				token.chars.reset( '/' );
+				i = j;
+			}
+		}
+		is_literal = is_literal && (token.kind == Token::Literal);
+		tokens.push_back( token );
+	}
+	return( tokens );
+}
+
+/**
+	Determine whether tokens match a whole name.
+	@param[in] tokens Tokens
+	@param[in] name Name
+	@retval matches Whether the tokens match
+ */
+bool
+Glob_Pattern::match_tokens( const Token_List& tokens, string_view name )
+{
+	// a wildcard does not match a leading '.'
+	if( !name.empty() && name[0] == '.'
+			&& (tokens.empty() || tokens[0].kind != Token::Literal) )
+	{
+		return( false );
+	}
+
+	// on a mismatch, let the last '*' match one more character and retry
+	size_t t = 0;
+	size_t i = 0;
+	size_t star_t = string::npos;
+	size_t star_i = 0;
+	while( i != name.size() )
+	{
+		if( t != tokens.size() )
+		{
+			const Token& token = tokens[t];
+			if( token.kind == Token::Any_String )
+			{
+				star_t = t++;
+				star_i = i;
+				continue;
+			}
+			if( (token.kind == Token::Literal && token.c == name[i])
+					|| token.kind == Token::Any_Char
+					|| (token.kind == Token::Char_Set
+						&& token.chars.test(
+							static_cast<unsigned char>( name[i] ) )) )
+			{
+				++t;
+				++i;
+				continue;
+			}
+		}
+		if( star_t == string::npos )
+		{
+			return( false );
+		}
+		t = star_t + 1;
+		i = ++star_i;
+	}
+	while( t != tokens.size() && tokens[t].kind == Token::Any_String )
+	{
+		++t;
+	}
+	return( t == tokens.size() );
+}
+
+/**
+	Determine whether a segment matches a path component.
+	@param[in] segment Segment that is not '**'
+	@param[in] name Path component
+	@retval matches Whether the segment matches
+ */
+bool
+Glob_Pattern::match_segment( const Segment& segment, string_view name ) const
+{
+	if( segment.is_literal )
+	{
+		return( std::binary_search( segment.literals.begin(),
+					segment.literals.end(), name ) );
+	}
+	for( unsigned i = 0; i != segment.alternatives.size(); ++i )
+	{
+		if( match_tokens( segment.alternatives[i], name ) )
+		{
+			return( true );
+		}
+	}
+	return( false );
+}
+
+/**
+	Determine whether the segments from s on match the components from p on.
+	@param[in] s Index of first segment
+	@param[in] components Path components
+	@param[in] p Index of first component
+	@retval matches Whether they match
+ */
+bool
+Glob_Pattern::match_from( size_t s, const vector<string_view>& components,
+		size_t p ) const
+{
+	for( ; s != _segments.size(); ++s, ++p )
+	{
+		if( _segments[s].is_double_star )
+		{
+			// try each number of directories, none of which may be hidden
+			for( size_t q = p; q <= components.size(); ++q )
+			{
+				if( match_from( s + 1, components, q ) )
+				{
+					return( true );
+				}
+				if( q != components.size() && !components[q].empty()
+						&& components[q][0] == '.' )
+				{
+					return( false );
+				}
+			}
+			return( false );
+		}
+		if( p == components.size()
+				|| !match_segment( _segments[s], components[p] ) )
+		{
+			return( false );
+		}
+	}
+	return( p == components.size() );
+}
+
+/**
+	Determine whether the pattern matches a path. A leading "./" is ignored.
+	@param[in] path Path
+	@retval matches Whether the pattern matches
+ */
+bool
+Glob_Pattern::match( const string& path ) const
+{
+	if( path.empty() || (path[0] == '/') != _absolute )
+	{
+		return( false );
+	}
+
+	vector<string_view> components;
+	const string_view text( path );
+	size_t start = 0;
+	while( start <= text.size() )
+	{
+		size_t end = text.find( '/', start );
+		if( end == string_view::npos )
+		{
+			end = text.size();
+		}
+		const string_view component = text.substr( start, end - start );
+		if( !component.empty() && !(component == "." && components.empty()) )
+		{
+			components.push_back( component );
+		}
+		start = end + 1;
+	}
+	return( match_from( 0, components, 0 ) );
+}
+
+/**
+	Add the segments that '**' segments reach by matching no directories.
+	@param[in,out] states Indices of segments, with the number of segments
+		meaning the whole pattern has matched
+ */
+void
+Glob_Pattern::add_empty_matches( vector<size_t>& states ) const
+{
+	for( unsigned i = 0; i != states.size(); ++i )
+	{
+		const size_t s = states[i];
+		if( s != _segments.size() && _segments[s].is_double_star
+				&& std::find( states.begin(), states.end(), s + 1 )
+					== states.end() )
+		{
+			states.push_back( s + 1 );
+		}
+	}
+}
+
+/**
+	Find the files that match the pattern.
+	@param[out] num_dirs_read Number of directories whose entries were read
+		(if not 0)
+	@retval files Matching regular files in tree order (see sort_paths())
+ */
+vector<string>
+Glob_Pattern::expand( size_t* num_dirs_read ) const
+{
+	vector<string> files;
+	size_t num_dirs = 0;
+	if( !_segments.empty() )
+	{
+		vector<size_t> states( 1, 0 );
+		expand_dir( _absolute ? "/" : "", states, files, num_dirs );
+	}
+	if( num_dirs_read != 0 )
+	{
+		*num_dirs_read = num_dirs;
+	}
+	return( files );
+}
+
+/**
+	Find the files in a directory that match the pattern.
+
+	Each state is the index of a segment that the directory's entries must
+	match. An entry matched by the last segment is a result; an entry that is
+	a directory is descended into with the states that follow its matches. If
+	every state is a literal segment, the names are looked up directly without
+	reading the directory.
+
+	@param[in] dir_path Path of directory with a trailing '/' or "" for the
+		working directory
+	@param[in,out] states Segments for the directory's entries
+	@param[in,out] files Matching files
+	@param[in,out] num_dirs Number of directories read
+ */
+void
+Glob_Pattern::expand_dir( const string& dir_path, vector<size_t>& states,
+		vector<string>& files, size_t& num_dirs ) const
+{
+	add_empty_matches( states );
+	const size_t last = _segments.size() - 1;
+
+	// names of entries to consider: only the literals unless a wildcard or
+	// '**' must be matched against every entry
+	bool all_literal = true;
+	for( unsigned i = 0; i != states.size(); ++i )
+	{
+		all_literal = all_literal && (states[i] == _segments.size()
+				|| _segments[states[i]].is_literal);
+	}
+	vector<string> names;
+	if( all_literal )
+	{
+		for( unsigned i = 0; i != states.size(); ++i )
+		{
+			if( states[i] != _segments.size() )
+			{
+				const vector<string>& literals = _segments[states[i]].literals;
+				names.insert( names.end(), literals.begin(), literals.end() );
+			}
+		}
+		std::sort( names.begin(), names.end() );
+		names.erase( std::unique( names.begin(), names.end() ), names.end() );
+	}
+	else
+	{
+		DIR* dir = opendir( dir_path.empty() ? "." : dir_path.c_str() );
+		if( dir == 0 )
+		{
+			err_warn( "Unable to open directory %s\n",
+					dir_path.empty() ? "." : dir_path.c_str() );
+			return;
+		}
+		++num_dirs;
+		dirent* dep;
+		while( (dep = readdir( dir )) != NULL )
+		{
+			if( strcmp( dep->d_name, "." ) != 0
+					&& strcmp( dep->d_name, ".." ) != 0 )
+			{
+				names.push_back( dep->d_name );
+			}
+		}
+		closedir( dir );
+	}
+	sort_strings( names );
+
+	vector<size_t> next_states;
+	vector<size_t> stay_states;
+	for( unsigned n = 0; n != names.size(); ++n )
+	{
+		const string& name   = names[n];
+		const bool    hidden = (name[0] == '.');
+		bool matched = false;
+		next_states.clear();
+		stay_states.clear();
+		for( unsigned i = 0; i != states.size(); ++i )
+		{
+			const size_t s = states[i];
+			if( s == _segments.size() )
+			{
+				continue;
+			}
+			if( _segments[s].is_double_star )
+			{
+				if( !hidden )
+				{
+					matched = matched || (s == last);
+					stay_states.push_back( s );
+				}
+			}
+			else if( match_segment( _segments[s], name ) )
+			{
+				matched = matched || (s == last);
+				if( s != last )
+				{
+					next_states.push_back( s + 1 );
+				}
+			}
+		}
+		if( !matched && next_states.empty() && stay_states.empty() )
+		{
+			continue;
+		}
+
+		const string path = dir_path + name;
+		struct stat stat_buf;
+		if( stat( path.c_str(), &stat_buf ) < 0 )
+		{
+			// a missing literal name is not an error
+			if( !all_literal )
+			{
+				err_warn( "Unable to access file '%s'\n", path.c_str() );
+			}
+			continue;
+		}
+		if( S_ISREG( stat_buf.st_mode ) )
+		{
+			if( matched )
+			{
+				files.push_back( path );
+			}
+			continue;
+		}
+		else if( !S_ISDIR( stat_buf.st_mode ) )
+		{
+			continue;
+		}
+
+		// '**' does not follow links to directories, which could cycle
+		struct stat link_buf;
+		if( !stay_states.empty() && (lstat( path.c_str(), &link_buf ) < 0
+					|| !S_ISLNK( link_buf.st_mode )) )
+		{
+			next_states.insert( next_states.end(), stay_states.begin(),
+					stay_states.end() );
+		}
+		if( !next_states.empty() )
+		{
+			std::sort( next_states.begin(), next_states.end() );
+			next_states.erase( std::unique( next_states.begin(),
+						next_states.end() ), next_states.end() );
+			vector<size_t> child_states = next_states;
+			expand_dir( path + '/', child_states, files, num_dirs );
+		}
+	}
+}
@@ -0,0 +1,142 @@
+/**
+	@file   Glob_Pattern.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Class Glob_Pattern.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _GLOB_PATTERN_HPP
+#define _GLOB_PATTERN_HPP
+
+// c++ headers
+#include <bitset>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// c headers
+#include <cstddef>
+
+// tools headers
+#include "util.hpp"
+#include "err_mesg.h"
+
+namespace ws_tools
+{
+
+/**
+	@brief Compiled shell-style pattern for selecting files, such as the
+	JPEG and PGM images in any directory under those named data/2024-*
+	(data/2024-* followed by a '**' segment and a *.{jpg,pgm} segment).
+
+	The pattern is split at each '/' into segments that each match one path
+	component:
+		'*'       any characters
+		'?'       any one character
+		'[a-z]'   any character in the set ('[!a-z]' or '[^a-z]' for those not
+		          in it)
+		'{a,b}'   either alternative (which may contain the above and nest,
+		          but not '/')
+		'**'      as a whole segment, any number of directories (including
+		          none)
+		'\\'      makes the next character literal
+	As in the shell, a wildcard does not match a '.' at the start of a name,
+	and '**' does not enter directories whose names start with '.'.
+
+	expand() walks only the directories that the pattern can still match: a
+	segment without wildcards is looked up directly instead of reading its
+	directory, and a directory is read only while some segment (or '**') can
+	match its entries.
+ */
+class Glob_Pattern
+{
+
+public:
+
+	Glob_Pattern( const std::string& );
+
+	/**
+		Destructor does nothing.
+	 */
+	virtual ~Glob_Pattern( )
+	{ }
+
+	bool match( const std::string& ) const;
+
+	std::vector<std::string> expand( std::size_t* = 0 ) const;
+
+	/**
+		Return the pattern as given.
+		@retval pattern Pattern
+	 */
+	inline const std::string& get_pattern( ) const
+	{
+		return( _pattern );
+	}
+
+private:
+
+	/**
+		@brief Part of a segment that matches one character or, for
+		Any_String, any number of characters.
+	 */
+	struct Token
+	{
+		enum Kind { Literal, Any_Char, Any_String, Char_Set };
+
+		Kind                kind;   //< What the token matches
+		char                c;      //< Character for Literal
+		std::bitset<256>    chars;  //< Characters for Char_Set
+	};
+
+	/// Sequence of tokens that matches a whole path component
+	typedef std::vector<Token> Token_List;
+
+	/**
+		@brief Pattern for one path component.
+	 */
+	struct Segment
+	{
+		bool                     is_double_star;  //< Whether segment is '**'
+		bool                     is_literal;      //< Whether it has no wildcards
+		std::vector<Token_List>  alternatives;    //< Brace alternatives
+		std::vector<std::string> literals;        //< Names if is_literal
+	};
+
+	static std::vector<std::string> expand_braces( const std::string& );
+	static Token_List compile_alternative( const std::string&, bool& );
+	static bool match_tokens( const Token_List&, std::string_view );
+
+	bool match_segment( const Segment&, std::string_view ) const;
+	bool match_from( std::size_t, const std::vector<std::string_view>&,
+			std::size_t ) const;
+
+	void add_empty_matches( std::vector<std::size_t>& ) const;
+	void expand_dir( const std::string&, std::vector<std::size_t>&,
+			std::vector<std::string>&, std::size_t& ) const;
+
+	std::string          _pattern;   //< Pattern as given
+	bool                 _absolute;  //< Whether the pattern starts at '/'
+	std::vector<Segment> _segments;  //< Pattern for each path component
+
+};
+
+/**
+	Find the files that match a pattern (see Glob_Pattern).
+	@param[in] pattern Pattern to match
+	@retval files Matching regular files in tree order
+ */
+inline std::vector<std::string>
+glob_expand( const std::string& pattern )
+{
+	return( Glob_Pattern( pattern ).expand() );
+}
+
+} // namespace ws_tools
+
+#endif // _GLOB_PATTERN_HPP
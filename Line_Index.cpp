@@ -0,0 +1,305 @@
+/**
+	@file   Line_Index.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Class Line_Index.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#include "Line_Index.hpp"
+
+// tools headers
+#include "parallel.hpp"
+
+// vector instructions for finding newlines
+#include "cpu_features.hpp"
+#ifdef __SSE2__
+	#include <emmintrin.h>
+#endif // __SSE2__
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+using namespace ws_tools;
+
+/// Size of each segment whose offsets share the same upper 32 bits
+static const uint64_t segment_size = 1ULL << 32;
+
+/// Smallest piece of a file given to a thread
+static const size_t min_chunk_size = 1 << 20;
+
+#ifdef WS_TOOLS_X86_DISPATCH
+/**
+	Call f(i) for the position i of each newline in the whole 32-byte blocks of
+	p[i, n) using AVX2.
+	@param[in] p Text
+	@param[in] i Position to start at
+	@param[in] n Number of bytes
+	@param[in] f Function called with the position of each newline
+	@retval i Position after the last block
+ */
+template<typename Function>
+static WS_TOOLS_TARGET( "avx2" ) size_t
+for_each_newline_avx2( const char* p, size_t i, size_t n, Function& f )
+{
+	const __m256i newline_32 = _mm256_set1_epi8( '\n' );
+	for( ; i + 32 <= n; i += 32 )
+	{
+		const __m256i v = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>( p + i ) );
+		uint32_t mask = static_cast<uint32_t>(
+				_mm256_movemask_epi8( _mm256_cmpeq_epi8( v, newline_32 ) ) );
+		while( mask != 0 )
+		{
+			f( i + __builtin_ctz( mask ) );
+			mask &= mask - 1;
+		}
+	}
+	return( i );
+}
+#endif // WS_TOOLS_X86_DISPATCH
+
+/**
+	Call f(i) for the position i of each newline in p[0, n).
+
+	Newlines are found 32 (AVX2, if the processor has it) or 16 (SSE2) bytes at
+	a time: a compare gives a bit mask of the newlines in the block, and each
+	set bit is visited with a count-trailing-zeros instruction, so blocks
+	without newlines cost a single compare.
+
+	@param[in] p Text
+	@param[in] n Number of bytes
+	@param[in] f Function called with the position of each newline
+ */
+template<typename Function>
+static inline void
+for_each_newline( const char* p, size_t n, Function f )
+{
+	size_t i = 0;
+
+#ifdef WS_TOOLS_X86_DISPATCH
+	if( cpu_has_avx2() )
+	{
+		i = for_each_newline_avx2( p, i, n, f );
+	}
+#endif // WS_TOOLS_X86_DISPATCH
+
+#ifdef __SSE2__
+	const __m128i newline_16 = _mm_set1_epi8( '\n' );
+	for( ; i + 16 <= n; i += 16 )
+	{
+		const __m128i v = _mm_loadu_si128(
+				reinterpret_cast<const __m128i*>( p + i ) );
+		uint32_t mask = static_cast<uint32_t>(
+				_mm_movemask_epi8( _mm_cmpeq_epi8( v, newline_16 ) ) );
+		while( mask != 0 )
+		{
+			f( i + __builtin_ctz( mask ) );
+			mask &= mask - 1;
+		}
+	}
+#endif // __SSE2__
+
+	// remaining bytes (or all of them without SSE2)
+	while( i != n )
+	{
+		const void* found = memchr( p + i, '\n', n - i );
+		if( found == 0 )
+		{
+			break;
+		}
+		i = static_cast<const char*>( found ) - p;
+		f( i++ );
+	}
+}
+
+/**
+	Index the lines of the given file.
+	@param[in] file_name File to index
+	@param[in] num_threads Number of threads to scan the file with (0 means one
+		per processor)
+ */
+Line_Index::Line_Index( const string& file_name, unsigned num_threads )
+: _file( file_name ), _data( _file.data() ), _size( _file.size() )
+{
+	build( num_threads );
+}
+
+/**
+	Index the lines of text already in memory, which must remain valid while
+	the index is used.
+	@param[in] data Text to index
+	@param[in] size Number of bytes of text
+	@param[in] num_threads Number of threads to scan the text with (0 means one
+		per processor)
+ */
+Line_Index::Line_Index( const char* data, size_t size, unsigned num_threads )
+: _data( data ), _size( size )
+{
+	build( num_threads );
+}
+
+/**
+	Find the start of every line.
+
+	The text is split into chunks, none of which crosses a 4 GB boundary. Each
+	chunk's line starts are counted in parallel, a prefix sum gives where each
+	chunk's offsets go, and then each chunk writes its offsets in parallel.
+	Position j starts a line if j is 0 or the byte before it is a newline, so a
+	chunk [b, e) looks for newlines in [b - 1, e - 1).
+
+	@param[in] num_threads Number of threads to use (0 means one per processor)
+ */
+void
+Line_Index::build( unsigned num_threads )
+{
+	_low_offsets.clear();
+	_segment_starts.assign( 1, 0 );
+	if( _size == 0 )
+	{
+		return;
+	}
+
+	if( num_threads == 0 )
+	{
+		num_threads = default_num_threads();
+	}
+
+	// split each 4 GB segment into chunks
+	size_t chunk_size = _size;
+	if( num_threads > 1 && _size >= 2 * min_chunk_size )
+	{
+		chunk_size = std::max( min_chunk_size, _size / (4 * num_threads) );
+	}
+	vector<uint64_t> bounds;
+	for( uint64_t segment = 0; segment < _size; segment += segment_size )
+	{
+		const uint64_t segment_end = std::min<uint64_t>( segment + segment_size,
+				_size );
+		for( uint64_t b = segment; b < segment_end; b += chunk_size )
+		{
+			bounds.push_back( b );
+		}
+	}
+	bounds.push_back( _size );
+	const size_t num_chunks = bounds.size() - 1;
+
+	// count the lines that start in each chunk
+	vector<size_t> counts( num_chunks + 1, 0 );
+	parallel_for( num_chunks, num_threads,
+		[&]( size_t c )
+		{
+			const uint64_t first = (bounds[c] == 0) ? 0 : bounds[c] - 1;
+			size_t count = (bounds[c] == 0) ? 1 : 0;
+			for_each_newline( _data + first, bounds[c + 1] - 1 - first,
+				[&count]( size_t ) { ++count; } );
+			counts[c + 1] = count;
+		} );
+	for( size_t c = 0; c != num_chunks; ++c )
+	{
+		counts[c + 1] += counts[c];
+	}
+
+	// write the offsets of each chunk's lines
+	_low_offsets.resize( counts[ num_chunks ] );
+	parallel_for( num_chunks, num_threads,
+		[&]( size_t c )
+		{
+			uint32_t* out = &_low_offsets[0] + counts[c];
+			if( bounds[c] == 0 )
+			{
+				*out++ = 0;
+			}
+			const uint64_t first = (bounds[c] == 0) ? 0 : bounds[c] - 1;
+			for_each_newline( _data + first, bounds[c + 1] - 1 - first,
+				[&out, first]( size_t i )
+				{
+					*out++ = static_cast<uint32_t>( first + i + 1 );
+				} );
+		} );
+
+	// record the first line of each 4 GB segment, whose chunks start exactly
+	// at the segment boundary
+	for( size_t c = 1; c != num_chunks; ++c )
+	{
+		if( bounds[c] % segment_size == 0 )
+		{
+			_segment_starts.push_back( counts[c] );
+		}
+	}
+}
+
+/**
+	Return the given line without its newline.
+	@param[in] n Line number (0 based)
+	@retval line Text of the line
+ */
+string_view
+Line_Index::line( size_t n ) const
+{
+	const uint64_t begin = line_offset( n );
+	uint64_t       end   = (n + 1 < num_lines()) ? line_offset( n + 1 ) - 1
+		: _size;
+	if( end > begin && end == _size && _data[ end - 1 ] == '\n' )
+	{
+		--end;  // newline at the end of the file
+	}
+	if( end > begin && _data[ end - 1 ] == '\r' )
+	{
+		--end;
+	}
+	return( string_view( _data + begin, end - begin ) );
+}
+
+/**
+	Return a range of lines as a single piece of text, including the newlines
+	between the lines but not the newline after the last one.
+	@param[in] first First line number (0 based)
+	@param[in] last One past the last line number
+	@retval lines Text of the lines
+ */
+string_view
+Line_Index::lines( size_t first, size_t last ) const
+{
+	if( first >= last )
+	{
+		return( string_view() );
+	}
+	const string_view last_line = line( last - 1 );
+	const char* begin = _data + line_offset( first );
+	return( string_view( begin,
+			(last_line.data() + last_line.size()) - begin ) );
+}
+
+/**
+	Find the line that contains the given offset.
+	@param[in] offset Offset from the start of the text
+	@retval n Line number (0 based)
+ */
+size_t
+Line_Index::line_number( uint64_t offset ) const
+{
+	// first line that starts after the offset, minus one
+	size_t first = 0;
+	size_t count = num_lines();
+	while( count > 0 )
+	{
+		const size_t step = count / 2;
+		if( line_offset( first + step ) <= offset )
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else
+		{
+			count = step;
+		}
+	}
+	return( (first == 0) ? 0 : first - 1 );
+}
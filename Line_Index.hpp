@@ -0,0 +1,158 @@
+/**
+	@file   Line_Index.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Class Line_Index.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _LINE_INDEX_HPP
+#define _LINE_INDEX_HPP
+
+// c++ headers
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// c headers
+#include <cstddef>
+#include <cstdint>
+
+// tools headers
+#include "Mapped_File.hpp"
+#include "util.hpp"
+#include "err_mesg.h"
+
+namespace ws_tools
+{
+
+/**
+	@brief Index of where each line of a text file starts.
+
+	The file is mapped and scanned once for newlines, after which any line can
+	be returned in constant time without reading the lines before it, e.g., to
+	binary search a sorted log or to pick random lines.
+
+	Lines are separated by '\n'; a '\r' before the '\n' is not part of the
+	line, and a newline at the very end of the file does not start another
+	line. Line numbers here are 0 based.
+
+	Offsets are stored in 32 bits each. Files of 4 GB or more are handled by
+	also keeping, for each 4 GB segment of the file, the number of the first
+	line that starts in it.
+ */
+class Line_Index
+{
+
+public:
+
+	Line_Index( const std::string&, unsigned = 1 );
+	Line_Index( const char*, std::size_t, unsigned = 1 );
+
+	/**
+		Destructor does nothing since the file is unmapped by its own object.
+	 */
+	virtual ~Line_Index( )
+	{ }
+
+	/**
+		Return the number of lines.
+		@retval num_lines Number of lines
+	 */
+	inline std::size_t num_lines( ) const
+	{
+		return( _low_offsets.size() );
+	}
+
+	/**
+		Return the offset of the first character of the given line.
+		@param[in] n Line number (0 based)
+		@retval offset Offset from the start of the text
+	 */
+	inline uint64_t line_offset( std::size_t n ) const
+	{
+		// number of 4 GB segments before the line's segment
+		const uint64_t segment = std::upper_bound( _segment_starts.begin(),
+				_segment_starts.end(), n ) - _segment_starts.begin() - 1;
+		return( (segment << 32) | _low_offsets[n] );
+	}
+
+	std::string_view line( std::size_t ) const;
+	std::string_view lines( std::size_t, std::size_t ) const;
+	std::size_t line_number( uint64_t ) const;
+
+	/**
+		Find the first line that is not less than the given key, assuming the
+		lines are sorted by the given comparison.
+		@param[in] key Value to search for
+		@param[in] less Comparison less( line, key ) that returns whether line
+			comes before key
+		@retval n Number of the first line not less than key (num_lines() if
+			there is none)
+	 */
+	template<typename Key, typename Less>
+	std::size_t lower_bound( const Key& key, Less less ) const
+	{
+		std::size_t first = 0;
+		std::size_t count = num_lines();
+		while( count > 0 )
+		{
+			const std::size_t step = count / 2;
+			if( less( line( first + step ), key ) )
+			{
+				first += step + 1;
+				count -= step + 1;
+			}
+			else
+			{
+				count = step;
+			}
+		}
+		return( first );
+	}
+
+	/**
+		Find the first line that is not less than the given key, assuming the
+		lines are sorted in byte order.
+		@param[in] key Value to search for
+		@retval n Number of the first line not less than key
+	 */
+	inline std::size_t lower_bound( std::string_view key ) const
+	{
+		return( lower_bound( key,
+			[]( std::string_view a, std::string_view b ) { return( a < b ); } ) );
+	}
+
+	/**
+		Return the indexed text.
+		@retval text Text
+	 */
+	inline std::string_view text( ) const
+	{
+		return( std::string_view( _data, _size ) );
+	}
+
+private:
+
+	void build( unsigned );
+
+	Mapped_File _file;  //< File being indexed (unused for memory buffers)
+	const char* _data;  //< Text being indexed
+	std::size_t _size;  //< Number of bytes of text
+
+	/// Low 32 bits of the offset of each line
+	std::vector<uint32_t> _low_offsets;
+
+	/// Number of the first line that starts in each 4 GB segment
+	std::vector<std::size_t> _segment_starts;
+
+};
+
+} // namespace ws_tools
+
+#endif // _LINE_INDEX_HPP
@@ -0,0 +1,531 @@
+/**
+	@file   Literal_Matcher.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Class Literal_Matcher.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#include "Literal_Matcher.hpp"
+
+// c++ headers
+#include <algorithm>
+
+// vector instructions for filtering candidate positions
+#include "cpu_features.hpp"
+#ifdef __SSE2__
+	#include <emmintrin.h>
+#endif // __SSE2__
+
+using std::size_t;
+using std::string;
+using std::vector;
+
+using namespace ws_tools;
+
+/**
+	Create matcher for a single pattern.
+	@param[in] pattern Pattern to find
+ */
+Literal_Matcher::Literal_Matcher( const string& pattern )
+: _patterns( 1, pattern )
+{
+	compile();
+}
+
+/**
+	Create matcher for several patterns.
+	@param[in] patterns Patterns to find
+ */
+Literal_Matcher::Literal_Matcher( const vector<string>& patterns )
+: _patterns( patterns )
+{
+	compile();
+}
+
+/**
+	Group the patterns into buckets and build the fingerprint tables.
+
+	Patterns are sorted by their first bytes before being split into buckets so
+	that patterns sharing a prefix share a bucket, which keeps each bucket's
+	fingerprint specific.
+ */
+void
+Literal_Matcher::compile( )
+{
+	if( _patterns.empty() )
+	{
+		err_quit( "Literal_Matcher: No patterns given\n" );
+	}
+
+	_fingerprint_len = max_fingerprint_len;
+	for( unsigned i = 0; i != _patterns.size(); ++i )
+	{
+		if( _patterns[i].empty() )
+		{
+			err_quit( "Literal_Matcher: Pattern %u is empty\n", i );
+		}
+		_fingerprint_len = std::min<unsigned>( _fingerprint_len,
+				_patterns[i].size() );
+	}
+
+	vector<unsigned> order( _patterns.size() );
+	for( unsigned i = 0; i != order.size(); ++i )
+	{
+		order[i] = i;
+	}
+	std::stable_sort( order.begin(), order.end(),
+		[this]( unsigned a, unsigned b )
+		{
+			return( _patterns[a].compare( 0, _fingerprint_len, _patterns[b], 0,
+					_fingerprint_len ) < 0 );
+		} );
+
+	for( unsigned b = 0; b != num_buckets; ++b )
+	{
+		_buckets[b].clear();
+	}
+	for( unsigned i = 0; i != order.size(); ++i )
+	{
+		// contiguous groups of the sorted patterns
+		const unsigned b = (i * num_buckets) / order.size();
+		_buckets[b].push_back( order[i] );
+	}
+
+	std::fill( &_byte_masks[0][0], &_byte_masks[0][0] + sizeof(_byte_masks), 0 );
+	std::fill( &_low_nibble_masks[0][0],
+			&_low_nibble_masks[0][0] + sizeof(_low_nibble_masks), 0 );
+	std::fill( &_high_nibble_masks[0][0],
+			&_high_nibble_masks[0][0] + sizeof(_high_nibble_masks), 0 );
+	for( unsigned b = 0; b != num_buckets; ++b )
+	{
+		for( unsigned i = 0; i != _buckets[b].size(); ++i )
+		{
+			const string& pattern = _patterns[ _buckets[b][i] ];
+			for( unsigned k = 0; k != _fingerprint_len; ++k )
+			{
+				const unsigned char c = pattern[k];
+				_byte_masks[k][c]                |= 1 << b;
+				_low_nibble_masks[k][c & 0x0F]   |= 1 << b;
+				_high_nibble_masks[k][c >> 4]    |= 1 << b;
+			}
+		}
+	}
+}
+
+/**
+	Find every occurrence of the patterns in the text.
+
+	Matches are appended in order of their offsets; overlapping matches and
+	matches of different patterns at the same offset are all reported.
+
+	@param[in] p Text
+	@param[in] n Number of bytes of text
+	@param[out] matches Matches found (appended to)
+	@param[in] max_matches Stop after finding this many matches
+	@retval num_matches Number of matches found
+ */
+size_t
+Literal_Matcher::find_all( const char* p, size_t n, vector<Match>& matches,
+		size_t max_matches ) const
+{
+	if( max_matches == 0 )
+	{
+		return( 0 );
+	}
+	if( _patterns.size() == 1 )
+	{
+		return( find_single( p, n, matches, max_matches ) );
+	}
+	return( find_multiple( p, n, matches, max_matches ) );
+}
+
+#ifdef WS_TOOLS_X86_DISPATCH
+/**
+	Find the next 32-byte block of positions where a pattern's first and last
+	bytes both match, using AVX2.
+	@param[in] p Text
+	@param[in] i Position to start at
+	@param[in] end One past the last position a match can start at
+	@param[in] first First byte of the pattern
+	@param[in] last Last byte of the pattern
+	@param[in] last_offset Offset of the last byte in the pattern
+	@param[out] mask Positions in the block where both bytes match
+	@retval i Start of the block, or a position with fewer than 32 left
+ */
+static WS_TOOLS_TARGET( "avx2" ) size_t
+find_pair_avx2( const char* p, size_t i, size_t end, char first, char last,
+		size_t last_offset, uint32_t& mask )
+{
+	const __m256i first_32 = _mm256_set1_epi8( first );
+	const __m256i last_32  = _mm256_set1_epi8( last );
+	for( ; i + 32 <= end; i += 32 )
+	{
+		const __m256i a = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>( p + i ) );
+		const __m256i b = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>( p + i + last_offset ) );
+		mask = static_cast<uint32_t>( _mm256_movemask_epi8(
+				_mm256_and_si256( _mm256_cmpeq_epi8( a, first_32 ),
+					_mm256_cmpeq_epi8( b, last_32 ) ) ) );
+		if( mask != 0 )
+		{
+			return( i );
+		}
+	}
+	mask = 0;
+	return( i );
+}
+
+/**
+	Find the next 32-byte block of positions with candidate buckets, using
+	AVX2 nibble shuffles.
+	@param[in] p Text
+	@param[in] i Position to start at
+	@param[in] end One past the last position whose fingerprint is in the text
+	@param[in] low_masks Buckets for each low nibble at each position
+	@param[in] high_masks Buckets for each high nibble at each position
+	@param[in] len Number of fingerprint positions
+	@param[out] buckets Candidate buckets at each position of the block
+	@param[out] mask Positions in the block with candidate buckets
+	@retval i Start of the block, or a position with fewer than 32 left
+ */
+static WS_TOOLS_TARGET( "avx2" ) size_t
+teddy_avx2( const char* p, size_t i, size_t end, const uint8_t (*low_masks)[16],
+		const uint8_t (*high_masks)[16], unsigned len, uint8_t* buckets,
+		uint32_t& mask )
+{
+	__m256i low_tables[ Literal_Matcher::max_fingerprint_len ];
+	__m256i high_tables[ Literal_Matcher::max_fingerprint_len ];
+	for( unsigned k = 0; k != len; ++k )
+	{
+		low_tables[k] = _mm256_broadcastsi128_si256( _mm_loadu_si128(
+				reinterpret_cast<const __m128i*>( low_masks[k] ) ) );
+		high_tables[k] = _mm256_broadcastsi128_si256( _mm_loadu_si128(
+				reinterpret_cast<const __m128i*>( high_masks[k] ) ) );
+	}
+	const __m256i nibble = _mm256_set1_epi8( 0x0F );
+
+	for( ; i + 32 <= end; i += 32 )
+	{
+		__m256i candidates = _mm256_set1_epi8( -1 );
+		for( unsigned k = 0; k != len; ++k )
+		{
+			const __m256i v = _mm256_loadu_si256(
+					reinterpret_cast<const __m256i*>( p + i + k ) );
+			const __m256i low  = _mm256_and_si256( v, nibble );
+			const __m256i high = _mm256_and_si256(
+					_mm256_srli_epi16( v, 4 ), nibble );
+			candidates = _mm256_and_si256( candidates, _mm256_and_si256(
+					_mm256_shuffle_epi8( low_tables[k], low ),
+					_mm256_shuffle_epi8( high_tables[k], high ) ) );
+		}
+		mask = ~static_cast<uint32_t>( _mm256_movemask_epi8(
+				_mm256_cmpeq_epi8( candidates, _mm256_setzero_si256() ) ) );
+		if( mask != 0 )
+		{
+			_mm256_storeu_si256( reinterpret_cast<__m256i*>( buckets ),
+					candidates );
+			return( i );
+		}
+	}
+	mask = 0;
+	return( i );
+}
+
+/**
+	Find the next 16-byte block of positions with candidate buckets, using
+	SSSE3 nibble shuffles.
+	@param[in] p Text
+	@param[in] i Position to start at
+	@param[in] end One past the last position whose fingerprint is in the text
+	@param[in] low_masks Buckets for each low nibble at each position
+	@param[in] high_masks Buckets for each high nibble at each position
+	@param[in] len Number of fingerprint positions
+	@param[out] buckets Candidate buckets at each position of the block
+	@param[out] mask Positions in the block with candidate buckets
+	@retval i Start of the block, or a position with fewer than 16 left
+ */
+static WS_TOOLS_TARGET( "ssse3" ) size_t
+teddy_ssse3( const char* p, size_t i, size_t end,
+		const uint8_t (*low_masks)[16], const uint8_t (*high_masks)[16],
+		unsigned len, uint8_t* buckets, uint32_t& mask )
+{
+	__m128i low_tables[ Literal_Matcher::max_fingerprint_len ];
+	__m128i high_tables[ Literal_Matcher::max_fingerprint_len ];
+	for( unsigned k = 0; k != len; ++k )
+	{
+		low_tables[k] = _mm_loadu_si128(
+				reinterpret_cast<const __m128i*>( low_masks[k] ) );
+		high_tables[k] = _mm_loadu_si128(
+				reinterpret_cast<const __m128i*>( high_masks[k] ) );
+	}
+	const __m128i nibble = _mm_set1_epi8( 0x0F );
+
+	for( ; i + 16 <= end; i += 16 )
+	{
+		__m128i candidates = _mm_set1_epi8( -1 );
+		for( unsigned k = 0; k != len; ++k )
+		{
+			const __m128i v = _mm_loadu_si128(
+					reinterpret_cast<const __m128i*>( p + i + k ) );
+			const __m128i low  = _mm_and_si128( v, nibble );
+			const __m128i high = _mm_and_si128( _mm_srli_epi16( v, 4 ),
+					nibble );
+			candidates = _mm_and_si128( candidates, _mm_and_si128(
+					_mm_shuffle_epi8( low_tables[k], low ),
+					_mm_shuffle_epi8( high_tables[k], high ) ) );
+		}
+		mask = 0xFFFF & ~static_cast<uint32_t>( _mm_movemask_epi8(
+				_mm_cmpeq_epi8( candidates, _mm_setzero_si128() ) ) );
+		if( mask != 0 )
+		{
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( buckets ), candidates );
+			return( i );
+		}
+	}
+	mask = 0;
+	return( i );
+}
+#endif // WS_TOOLS_X86_DISPATCH
+
+/**
+	Find the only pattern.
+
+	With SIMD, the pattern's first and last bytes are compared against 32 or 16
+	consecutive positions at once, and the middle of the pattern is compared
+	only where both match. The remaining positions are found with memchr() on
+	the first byte.
+
+	@param[in] p Text
+	@param[in] n Number of bytes of text
+	@param[out] matches Matches found (appended to)
+	@param[in] max_matches Stop after finding this many matches
+	@retval num_matches Number of matches found
+ */
+size_t
+Literal_Matcher::find_single( const char* p, size_t n, vector<Match>& matches,
+		size_t max_matches ) const
+{
+	const string& pattern = _patterns[0];
+	const size_t  m       = pattern.size();
+	if( m > n )
+	{
+		return( 0 );
+	}
+
+	const size_t last_start = n - m;  // last position a match can start at
+	size_t       num_found  = 0;
+	size_t       i          = 0;
+
+#ifdef WS_TOOLS_X86_DISPATCH
+	if( m > 1 && cpu_has_avx2() )
+	{
+		uint32_t mask = 0;
+		while( (i = find_pair_avx2( p, i, last_start + 1, pattern[0],
+				pattern[m - 1], m - 1, mask )) + 32 <= last_start + 1 )
+		{
+			while( mask != 0 )
+			{
+				const size_t j = i + __builtin_ctz( mask );
+				if( memcmp( p + j + 1, pattern.data() + 1, m - 2 ) == 0 )
+				{
+					matches.push_back( Match{ j, 0 } );
+					if( ++num_found == max_matches )
+					{
+						return( num_found );
+					}
+				}
+				mask &= mask - 1;
+			}
+			i += 32;
+		}
+	}
+#endif // WS_TOOLS_X86_DISPATCH
+
+#ifdef __SSE2__
+	if( m > 1 )
+	{
+		const __m128i first = _mm_set1_epi8( pattern[0] );
+		const __m128i last  = _mm_set1_epi8( pattern[m - 1] );
+		for( ; i + 16 <= last_start + 1; i += 16 )
+		{
+			const __m128i a = _mm_loadu_si128(
+					reinterpret_cast<const __m128i*>( p + i ) );
+			const __m128i b = _mm_loadu_si128(
+					reinterpret_cast<const __m128i*>( p + i + m - 1 ) );
+			uint32_t mask = static_cast<uint32_t>( _mm_movemask_epi8(
+					_mm_and_si128( _mm_cmpeq_epi8( a, first ),
+						_mm_cmpeq_epi8( b, last ) ) ) );
+			while( mask != 0 )
+			{
+				const size_t j = i + __builtin_ctz( mask );
+				if( memcmp( p + j + 1, pattern.data() + 1, m - 2 ) == 0 )
+				{
+					matches.push_back( Match{ j, 0 } );
+					if( ++num_found == max_matches )
+					{
+						return( num_found );
+					}
+				}
+				mask &= mask - 1;
+			}
+		}
+	}
+#endif // __SSE2__
+
+	// remaining positions (or all of them without SSE2)
+	while( i <= last_start )
+	{
+		const void* found = memchr( p + i, pattern[0], last_start + 1 - i );
+		if( found == 0 )
+		{
+			break;
+		}
+		i = static_cast<const char*>( found ) - p;
+		if( memcmp( p + i + 1, pattern.data() + 1, m - 1 ) == 0 )
+		{
+			matches.push_back( Match{ i, 0 } );
+			if( ++num_found == max_matches )
+			{
+				return( num_found );
+			}
+		}
+		++i;
+	}
+	return( num_found );
+}
+
+/**
+	Compare the patterns in the given buckets against the text at position i.
+	@param[in] p Text
+	@param[in] n Number of bytes of text
+	@param[in] i Position to compare at
+	@param[in] buckets Bit mask of the buckets to check
+	@param[out] matches Matches found (appended to)
+	@param[in] max_matches Stop after the total number of matches is this
+	@retval done Whether max_matches was reached
+ */
+inline bool
+Literal_Matcher::verify( const char* p, size_t n, size_t i, unsigned buckets,
+		vector<Match>& matches, size_t max_matches ) const
+{
+	while( buckets != 0 )
+	{
+		const vector<unsigned>& bucket = _buckets[ __builtin_ctz( buckets ) ];
+		for( unsigned k = 0; k != bucket.size(); ++k )
+		{
+			const string& pattern = _patterns[ bucket[k] ];
+			if( pattern.size() <= n - i
+					&& memcmp( p + i, pattern.data(), pattern.size() ) == 0 )
+			{
+				matches.push_back( Match{ i, bucket[k] } );
+				if( --max_matches == 0 )
+				{
+					return( true );
+				}
+			}
+		}
+		buckets &= buckets - 1;
+	}
+	return( false );
+}
+
+/**
+	Find several patterns.
+
+	For each position, the buckets that may match are the AND over the first
+	_fingerprint_len bytes of the buckets having that byte at that position of
+	one of their patterns. If the processor has SSSE3, the byte is split into
+	nibbles that index two 16-entry tables with a shuffle, so 16 (or 32 with
+	AVX2) positions are filtered at once; this is less exact than the byte tables
+	used for the remaining positions, but any false candidates are rejected
+	when the patterns are compared.
+
+	@param[in] p Text
+	@param[in] n Number of bytes of text
+	@param[out] matches Matches found (appended to)
+	@param[in] max_matches Stop after finding this many matches
+	@retval num_matches Number of matches found
+ */
+size_t
+Literal_Matcher::find_multiple( const char* p, size_t n,
+		vector<Match>& matches, size_t max_matches ) const
+{
+	const size_t start_size = matches.size();
+	const size_t len        = _fingerprint_len;
+	if( len > n )
+	{
+		return( 0 );
+	}
+
+	// last position whose fingerprint is inside the text
+	const size_t last_start = n - len;
+	size_t       i          = 0;
+
+#ifdef WS_TOOLS_X86_DISPATCH
+	if( cpu_has_ssse3() )
+	{
+		const bool avx2 = cpu_has_avx2();
+		uint8_t    buckets[32];
+		uint32_t   mask = 0;
+		while( true )
+		{
+			// next block of 32 (AVX2) or 16 positions with candidates
+			size_t block_size = 32;
+			if( avx2 )
+			{
+				i = teddy_avx2( p, i, last_start + 1, _low_nibble_masks,
+						_high_nibble_masks, len, buckets, mask );
+			}
+			if( !avx2 || i + 32 > last_start + 1 )
+			{
+				block_size = 16;
+				i = teddy_ssse3( p, i, last_start + 1, _low_nibble_masks,
+						_high_nibble_masks, len, buckets, mask );
+				if( i + 16 > last_start + 1 )
+				{
+					break;
+				}
+			}
+
+			while( mask != 0 )
+			{
+				const unsigned j = __builtin_ctz( mask );
+				if( verify( p, n, i + j, buckets[j], matches,
+						max_matches - (matches.size() - start_size) ) )
+				{
+					return( matches.size() - start_size );
+				}
+				mask &= mask - 1;
+			}
+			i += block_size;
+		}
+	}
+#endif // WS_TOOLS_X86_DISPATCH
+
+	// remaining positions (or all of them without SSSE3)
+	const unsigned char* u = reinterpret_cast<const unsigned char*>( p );
+	for( ; i <= last_start; ++i )
+	{
+		unsigned buckets = _byte_masks[0][ u[i] ];
+		if( buckets == 0 )
+		{
+			continue;
+		}
+		for( unsigned k = 1; k != len; ++k )
+		{
+			buckets &= _byte_masks[k][ u[i + k] ];
+		}
+		if( buckets != 0 && verify( p, n, i, buckets, matches,
+				max_matches - (matches.size() - start_size) ) )
+		{
+			break;
+		}
+	}
+	return( matches.size() - start_size );
+}
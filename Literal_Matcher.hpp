@@ -0,0 +1,143 @@
+/**
+	@file   Literal_Matcher.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Class Literal_Matcher.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _LITERAL_MATCHER_HPP
+#define _LITERAL_MATCHER_HPP
+
+// c++ headers
+#include <string>
+#include <vector>
+
+// c headers
+#include <cstddef>
+#include <cstdint>
+
+// tools headers
+#include "util.hpp"
+#include "err_mesg.h"
+
+namespace ws_tools
+{
+
+/**
+	@brief Finds every occurrence of one or more literal strings in a buffer.
+
+	A single pattern is found by comparing its first and last bytes against
+	16 or 32 positions at once and checking the rest only where both match
+	(memchr() is used when there is no SIMD support).
+
+	Several patterns are found with the Teddy approach: patterns are grouped
+	into 8 buckets, and the first few bytes at each position are looked up in
+	small per-bucket tables (a nibble shuffle with SSSE3/AVX2, a byte table
+	otherwise) to get the buckets that could match there. Only those buckets'
+	patterns are then compared in full, so text without near matches is
+	skipped quickly regardless of the number of patterns.
+
+	Example:
+		Literal_Matcher matcher( patterns );
+		std::vector<Literal_Matcher::Match> matches;
+		matcher.find_all( text.data(), text.size(), matches );
+ */
+class Literal_Matcher
+{
+
+public:
+
+	/// Most bytes at each position used to pick the buckets
+	static const unsigned max_fingerprint_len = 3;
+
+	/**
+		@brief Location of a pattern in the text.
+	 */
+	struct Match
+	{
+		std::size_t offset;   //< Offset of the first byte of the match
+		unsigned    pattern;  //< Index of the pattern that matched
+	};
+
+	Literal_Matcher( const std::string& );
+	Literal_Matcher( const std::vector<std::string>& );
+
+	/**
+		Destructor does nothing.
+	 */
+	virtual ~Literal_Matcher( )
+	{ }
+
+	std::size_t find_all( const char*, std::size_t, std::vector<Match>&,
+			std::size_t = std::string::npos ) const;
+
+	/**
+		Return whether any pattern occurs in the text.
+		@param[in] p Text
+		@param[in] n Number of bytes of text
+		@retval found Whether a pattern was found
+	 */
+	inline bool contains( const char* p, std::size_t n ) const
+	{
+		std::vector<Match> matches;
+		return( find_all( p, n, matches, 1 ) != 0 );
+	}
+
+	/**
+		Return the number of patterns.
+		@retval num_patterns Number of patterns
+	 */
+	inline unsigned num_patterns( ) const
+	{
+		return( _patterns.size() );
+	}
+
+	/**
+		Return the given pattern.
+		@param[in] i Index of pattern
+		@retval pattern Pattern
+	 */
+	inline const std::string& get_pattern( unsigned i ) const
+	{
+		return( _patterns[i] );
+	}
+
+private:
+
+	/// Number of buckets patterns are grouped into
+	static const unsigned num_buckets = 8;
+
+	void compile( );
+
+	std::size_t find_single( const char*, std::size_t, std::vector<Match>&,
+			std::size_t ) const;
+	std::size_t find_multiple( const char*, std::size_t, std::vector<Match>&,
+			std::size_t ) const;
+	bool verify( const char*, std::size_t, std::size_t, unsigned,
+			std::vector<Match>&, std::size_t ) const;
+
+	std::vector<std::string> _patterns;  //< Patterns to find
+
+	/// Number of bytes at each position used to pick the buckets
+	unsigned _fingerprint_len;
+
+	/// Indices of the patterns in each bucket
+	std::vector<unsigned> _buckets[ num_buckets ];
+
+	/// Buckets with a pattern having each byte at each fingerprint position
+	uint8_t _byte_masks[ max_fingerprint_len ][ 256 ];
+
+	/// Buckets with a pattern whose byte has the given low or high nibble
+	uint8_t _low_nibble_masks[ max_fingerprint_len ][ 16 ];
+	uint8_t _high_nibble_masks[ max_fingerprint_len ][ 16 ];
+
+};
+
+} // namespace ws_tools
+
+#endif // _LITERAL_MATCHER_HPP
@@ -0,0 +1,152 @@
+/**
+	@file   Mapped_File.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Class Mapped_File.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#include "Mapped_File.hpp"
+
+// system headers
+#include <fcntl.h>
+#include <sys/mman.h>
+
+using std::string;
+
+using namespace ws_tools;
+
+/**
+	Map the given file.
+	@param[in] file_name File to map
+ */
+Mapped_File::Mapped_File( const string& file_name )
+: _data(0), _size(0), _is_mapped(false)
+{
+	open( file_name );
+}
+
+/**
+	Unmap the file.
+ */
+Mapped_File::~Mapped_File( )
+{
+	close();
+}
+
+/**
+	Map the given file, replacing any file already mapped.
+	Exits if the file cannot be opened or read.
+	@param[in] file_name File to map
+ */
+void
+Mapped_File::open( const string& file_name )
+{
+	if( !try_open( file_name ) )
+	{
+		err_quit( "Unable to read file '%s'\n", file_name.c_str() );
+	}
+}
+
+/**
+	Map the given file, replacing any file already mapped.
+
+	Unlike open(), failure is left for the caller to handle, e.g., when
+	scanning many files one of which may be removed while it is scanned.
+
+	@param[in] file_name File to map
+	@retval success Whether the file was opened and read (the view is empty
+		otherwise)
+ */
+bool
+Mapped_File::try_open( const string& file_name )
+{
+	close();
+	_file_name = sub_home( file_name );
+
+	const int fd = ::open( _file_name.c_str(), O_RDONLY );
+	if( fd < 0 )
+	{
+		return( false );
+	}
+
+	struct stat stat_buf;
+	if( fstat( fd, &stat_buf ) == 0 && S_ISREG( stat_buf.st_mode ) )
+	{
+		_size = static_cast<std::size_t>( stat_buf.st_size );
+
+		// mmap() does not accept empty files, which need no data anyway
+		if( _size == 0 )
+		{
+			::close( fd );
+			return( true );
+		}
+
+		void* addr = mmap( 0, _size, PROT_READ, MAP_PRIVATE, fd, 0 );
+		if( addr != MAP_FAILED )
+		{
+			_data      = static_cast<const char*>( addr );
+			_is_mapped = true;
+			::close( fd );
+			return( true );
+		}
+	}
+
+	// unable to map: read the whole file into the buffer instead
+	_size = 0;
+	char    buf[ BUFSIZ ];
+	ssize_t num_bytes = 0;
+	while( (num_bytes = read( fd, buf, BUFSIZ )) != 0 )
+	{
+		if( num_bytes < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			::close( fd );
+			close();
+			return( false );
+		}
+		_buffer.insert( _buffer.end(), buf, buf + num_bytes );
+	}
+	::close( fd );
+
+	_data = _buffer.empty() ? 0 : &_buffer[0];
+	_size = _buffer.size();
+	return( true );
+}
+
+/**
+	Unmap the file (if any).
+ */
+void
+Mapped_File::close( )
+{
+	if( _is_mapped )
+	{
+		munmap( const_cast<char*>( _data ), _size );
+	}
+	_data      = 0;
+	_size      = 0;
+	_is_mapped = false;
+	_buffer.clear();
+	_file_name.clear();
+}
+
+/**
+	Tell the kernel that the file will be read from front to back, so that it
+	reads ahead aggressively.
+ */
+void
+Mapped_File::advise_sequential( ) const
+{
+	if( _is_mapped )
+	{
+		madvise( const_cast<char*>( _data ), _size, MADV_SEQUENTIAL );
+	}
+}
@@ -0,0 +1,129 @@
+/**
+	@file   Mapped_File.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Class Mapped_File.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _MAPPED_FILE_HPP
+#define _MAPPED_FILE_HPP
+
+// c++ headers
+#include <string>
+#include <string_view>
+#include <vector>
+
+// c headers
+#include <cstddef>
+
+// tools headers
+#include "util.hpp"
+#include "err_mesg.h"
+
+namespace ws_tools
+{
+
+/**
+	@brief Read-only view of a file's contents.
+
+	The file is mapped into memory with mmap() when possible, so its pages are
+	read on demand by the kernel and never copied through stdio. Files that
+	cannot be mapped (e.g., pipes or files on some special file systems) are
+	read into a buffer instead, so callers see the same interface either way.
+ */
+class Mapped_File
+{
+
+public:
+
+	/**
+		Default constructor creates an empty view.
+	 */
+	Mapped_File( )
+	: _data(0), _size(0), _is_mapped(false)
+	{ }
+
+	/**
+		Map the given file.
+		@param[in] file_name File to map
+	 */
+	Mapped_File( const std::string& );
+
+	/**
+		Unmap the file.
+	 */
+	~Mapped_File( );
+
+	void open( const std::string& );
+	bool try_open( const std::string& );
+	void close( );
+
+	/**
+		Return pointer to the first byte of the file.
+		@retval data Pointer to the file's contents
+	 */
+	inline const char* data( ) const
+	{
+		return( _data );
+	}
+
+	/**
+		Return the number of bytes in the file.
+		@retval size Size of the file
+	 */
+	inline std::size_t size( ) const
+	{
+		return( _size );
+	}
+
+	/**
+		Return the file's contents as a string view.
+		@retval view Contents of the file
+	 */
+	inline std::string_view view( ) const
+	{
+		return( std::string_view( _data, _size ) );
+	}
+
+	/**
+		Return whether the file is mapped (true) or was read into a buffer.
+		@retval is_mapped Whether the file is mapped
+	 */
+	inline bool is_mapped( ) const
+	{
+		return( _is_mapped );
+	}
+
+	/**
+		Return name of the file.
+		@retval file_name Name of file
+	 */
+	inline const std::string& get_file_name( ) const
+	{
+		return( _file_name );
+	}
+
+	void advise_sequential( ) const;
+
+private:
+
+	// copying would unmap the file twice
+	Mapped_File( const Mapped_File& );
+	Mapped_File& operator=( const Mapped_File& );
+
+	const char*       _data;       //< Contents of file
+	std::size_t       _size;       //< Number of bytes in file
+	bool              _is_mapped;  //< Whether _data is mapped or in _buffer
+	std::vector<char> _buffer;     //< Contents of file if it was not mapped
+	std::string       _file_name;  //< Name of file
+
+};
+
+} // namespace ws_tools
+
+#endif // _MAPPED_FILE_HPP
@@ -0,0 +1,99 @@
+/**
+	@file   Random_Distribution.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Distributions and generators resolved at compile time.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#include "Random_Distribution.hpp"
+
+using std::size_t;
+using std::vector;
+
+using namespace ws_tools;
+
+/**
+	Rebuild the alias table with new weights using Vose's method: columns whose
+	scaled probability is below 1 are filled up by columns above 1, one pair
+	at a time, so that each column is finished in one step.
+	@param[in] weights Nonnegative weight of each index
+	@param[in] n Number of indices
+ */
+void
+Discrete_Distribution::weights( const double* weights, size_t n )
+{
+	if( n == 0 )
+	{
+		err_quit( "Discrete_Distribution::weights: no weights\n" );
+	}
+	double sum = 0;
+	for( size_t i = 0; i != n; ++i )
+	{
+		if( !(weights[i] >= 0) )
+		{
+			err_quit( "Discrete_Distribution::weights: weight %lu (%lf) < 0\n",
+					(unsigned long) i, weights[i] );
+		}
+		sum += weights[i];
+	}
+	if( !(sum > 0) || sum > 1e300 )
+	{
+		err_quit( "Discrete_Distribution::weights: sum of weights (%lf) is"
+				" not positive and finite\n", sum );
+	}
+
+	_columns.resize( n );
+	_probabilities.resize( n );
+	_scaled.resize( n );
+	_small.clear();
+	_large.clear();
+	for( size_t i = 0; i != n; ++i )
+	{
+		_probabilities[i] = weights[i] / sum;
+		_scaled[i]        = _probabilities[i] * n;
+		if( _scaled[i] < 1 )
+		{
+			_small.push_back( i );
+		}
+		else
+		{
+			_large.push_back( i );
+		}
+	}
+
+	// 2^64 as a double: the threshold of a probability p is p * 2^64
+	const double two_64 = 18446744073709551616.0;
+	while( !_small.empty() && !_large.empty() )
+	{
+		const size_t small = _small.back();
+		const size_t large = _large.back();
+		_small.pop_back();
+		_columns[small].threshold = uint64_t( _scaled[small] * two_64 );
+		_columns[small].alias     = large;
+
+		// the large column gives up the rest of the small column
+		_scaled[large] = (_scaled[large] + _scaled[small]) - 1;
+		if( _scaled[large] < 1 )
+		{
+			_large.pop_back();
+			_small.push_back( large );
+		}
+	}
+
+	// the remaining columns are full up to rounding
+	for( size_t i = 0; i != _large.size(); ++i )
+	{
+		_columns[_large[i]].threshold = ~uint64_t( 0 );
+		_columns[_large[i]].alias     = _large[i];
+	}
+	for( size_t i = 0; i != _small.size(); ++i )
+	{
+		_columns[_small[i]].threshold = ~uint64_t( 0 );
+		_columns[_small[i]].alias     = _small[i];
+	}
+}
@@ -0,0 +1,1080 @@
+/**
+	@file   Random_Distribution.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Distributions and generators resolved at compile time.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _RANDOM_DISTRIBUTION_HPP
+#define _RANDOM_DISTRIBUTION_HPP
+
+// c++ headers
+#include <algorithm>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// c headers
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// tools headers
+#include "Random_Engine.hpp"
+#include "Ziggurat.hpp"
+#include "err_mesg.h"
+
+namespace ws_tools
+{
+
+/*
+	A distribution is a small value type whose const member function template
+		template<typename Engine> result_type operator()( Engine& ) const
+	turns 64-bit numbers from any engine (a class whose operator() returns
+	uint64_t, such as Xoshiro256ss_Engine) into one random number. Since the
+	engine and distribution types are both known at compile time, a sample
+	inlines into the caller's loop without any virtual or indirect call. The
+	Random_Number classes are adapters that hold a distribution and call it
+	with their engine.
+ */
+
+/**
+	@brief Uniform distribution over [min, max).
+ */
+class Uniform_Distribution
+{
+
+public:
+
+	typedef double result_type;
+
+	/**
+		Construct a distribution.
+		@param[in] min Minimum value in the distribution's range
+		@param[in] max Maximum value in the distribution's range
+	 */
+	explicit Uniform_Distribution( double min = 0.0, double max = 1.0 )
+	: _min( min ), _width( max - min )
+	{ }
+
+	/**
+		Return a random number.
+		@param[in,out] engine Source of random bits
+		@retval number Random number
+	 */
+	template<typename Engine>
+	inline double operator()( Engine& engine ) const
+	{
+		return( _min + _width * to_unit_double( bit_engine( engine )() ) );
+	}
+
+	/**
+		Return minimum value in the distribution's range.
+		@retval min Minimum value in the distribution's range
+	 */
+	inline double min( ) const
+	{
+		return( _min );
+	}
+
+	/**
+		Return maximum value in the distribution's range.
+		@retval max Maximum value in the distribution's range
+	 */
+	inline double max( ) const
+	{
+		return( _min + _width );
+	}
+
+private:
+
+	double _min;    //< Minimum value in the distribution's range
+	double _width;  //< Width of the range
+};
+
+/**
+	@brief Normal distribution, sampled with the ziggurat method.
+ */
+class Normal_Distribution
+{
+
+public:
+
+	typedef double result_type;
+
+	/**
+		Construct a distribution.
+		@param[in] mean Mean
+		@param[in] std_dev Standard deviation
+	 */
+	explicit Normal_Distribution( double mean = 0.0, double std_dev = 1.0 )
+	: _mean( mean ), _std_dev( std_dev )
+	{ }
+
+	/**
+		Return a random number.
+		@param[in,out] engine Source of random bits
+		@retval number Random number
+	 */
+	template<typename Engine>
+	inline double operator()( Engine& engine ) const
+	{
+		return( _mean + _std_dev * ziggurat_normal( engine ) );
+	}
+
+	/**
+		Return the mean.
+		@retval mean Mean
+	 */
+	inline double mean( ) const
+	{
+		return( _mean );
+	}
+
+	/**
+		Return the standard deviation.
+		@retval std_dev Standard deviation
+	 */
+	inline double std_dev( ) const
+	{
+		return( _std_dev );
+	}
+
+private:
+
+	double _mean;     //< Mean
+	double _std_dev;  //< Standard deviation
+};
+
+/**
+	@brief Exponential distribution, sampled with the ziggurat method.
+ */
+class Exponential_Distribution
+{
+
+public:
+
+	typedef double result_type;
+
+	/**
+		Construct a distribution.
+		@param[in] rate Rate (the reciprocal of the mean)
+	 */
+	explicit Exponential_Distribution( double rate = 1.0 )
+	: _rate( rate ), _mean( 1 / rate )
+	{
+		if( !(_rate > 0) )
+		{
+			err_quit( "Exponential_Distribution: rate (%lf) <= 0\n", _rate );
+		}
+	}
+
+	/**
+		Return a random number.
+		@param[in,out] engine Source of random bits
+		@retval number Random number
+	 */
+	template<typename Engine>
+	inline double operator()( Engine& engine ) const
+	{
+		return( _mean * ziggurat_exponential( engine ) );
+	}
+
+	/**
+		Return the rate.
+		@retval rate Rate
+	 */
+	inline double rate( ) const
+	{
+		return( _rate );
+	}
+
+private:
+
+	double _rate;  //< Rate
+	double _mean;  //< Mean
+};
+
+/**
+	@brief Gamma distribution, sampled with the method of Marsaglia and Tsang.
+
+	Each attempt uses one normal and one uniform number and is accepted over
+	95% of the time, usually by a squeeze that needs no logarithm. A shape
+	below 1 is sampled with shape + 1 and scaled by U^(1 / shape).
+ */
+class Gamma_Distribution
+{
+
+public:
+
+	typedef double result_type;
+
+	/**
+		Construct a distribution.
+		@param[in] shape Shape (k or alpha)
+		@param[in] scale Scale (theta, the reciprocal of the rate)
+	 */
+	explicit Gamma_Distribution( double shape = 1.0, double scale = 1.0 )
+	: _shape( shape ), _scale( scale )
+	{
+		if( !(_shape > 0) || !(_scale > 0) )
+		{
+			err_quit( "Gamma_Distribution: shape (%lf) or scale (%lf) <= 0\n",
+					_shape, _scale );
+		}
+		_d = (_shape < 1 ? _shape + 1 : _shape) - 1.0 / 3;
+		_c = 1 / std::sqrt( 9 * _d );
+		_inverse_shape = 1 / _shape;
+	}
+
+	/**
+		Return a random number.
+		@param[in,out] engine Source of random bits
+		@retval number Random number
+	 */
+	template<typename Engine>
+	inline double operator()( Engine& engine ) const
+	{
+		auto& bits = bit_engine( engine );
+		double number;
+		while( true )
+		{
+			const double x = ziggurat_normal( bits );
+			double v = 1 + _c * x;
+			if( v <= 0 )
+			{
+				continue;
+			}
+			v = v * v * v;
+			const double u  = 1 - to_unit_double( bits() );
+			const double x2 = x * x;
+			if( u < 1 - 0.0331 * x2 * x2
+					|| std::log( u ) < 0.5 * x2 + _d * (1 - v + std::log( v )) )
+			{
+				number = _d * v;
+				break;
+			}
+		}
+		if( _shape < 1 )
+		{
+			number *= std::pow( 1 - to_unit_double( bits() ), _inverse_shape );
+		}
+		return( _scale * number );
+	}
+
+	/**
+		Return the shape.
+		@retval shape Shape
+	 */
+	inline double shape( ) const
+	{
+		return( _shape );
+	}
+
+	/**
+		Return the scale.
+		@retval scale Scale
+	 */
+	inline double scale( ) const
+	{
+		return( _scale );
+	}
+
+private:
+
+	double _shape;          //< Shape
+	double _scale;          //< Scale
+	double _d;              //< Shape (at least 1) minus 1/3
+	double _c;              //< 1 / sqrt(9 d)
+	double _inverse_shape;  //< 1 / shape
+};
+
+/**
+	@brief Poisson distribution, sampled by inversion for a small mean and with
+	the transformed rejection method PTRS (Hoermann) otherwise.
+
+	Both methods take a constant expected time: inversion uses one uniform
+	number and at most a few dozen multiplications for a mean below 10, and
+	PTRS uses two uniform numbers per attempt and accepts about 90% of them,
+	evaluating lgamma() only for the few that are not settled by its squeeze.
+ */
+class Poisson_Distribution
+{
+
+public:
+
+	typedef uint64_t result_type;
+
+	/**
+		Construct a distribution.
+		@param[in] mean Mean (lambda)
+	 */
+	explicit Poisson_Distribution( double mean = 1.0 )
+	: _mean( mean )
+	{
+		if( !(_mean >= 0) )
+		{
+			err_quit( "Poisson_Distribution: mean (%lf) < 0\n", _mean );
+		}
+		_exp_mean = std::exp( -_mean );
+		if( _mean >= INVERSION_LIMIT )
+		{
+			const double sqrt_mean = std::sqrt( _mean );
+			_log_mean  = std::log( _mean );
+			_b         = 0.931 + 2.53 * sqrt_mean;
+			_a         = -0.059 + 0.02483 * _b;
+			_log_alpha = std::log( 1.1239 + 1.1328 / (_b - 3.4) );
+			_v_r       = 0.9277 - 3.6224 / (_b - 2);
+		}
+	}
+
+	/**
+		Return a random number.
+		@param[in,out] engine Source of random bits
+		@retval number Random number
+	 */
+	template<typename Engine>
+	inline uint64_t operator()( Engine& engine ) const
+	{
+		auto& bits = bit_engine( engine );
+		if( _mean < INVERSION_LIMIT )
+		{
+			return( inversion( bits ) );
+		}
+		return( ptrs( bits ) );
+	}
+
+	/**
+		Return the mean.
+		@retval mean Mean
+	 */
+	inline double mean( ) const
+	{
+		return( _mean );
+	}
+
+private:
+
+	/// Mean below which inversion is used
+	static constexpr double INVERSION_LIMIT = 10;
+
+	/**
+		Return a random number by searching the cumulative distribution from 0.
+		@param[in,out] engine Source of random bits
+		@retval number Random number
+	 */
+	template<typename Engine>
+	uint64_t inversion( Engine& engine ) const
+	{
+		while( true )
+		{
+			double   u = to_unit_double( engine() );
+			double   p = _exp_mean;
+			uint64_t k = 0;
+			while( u > p )
+			{
+				u -= p;
+				p *= _mean / ++k;
+				if( p == 0 )
+				{
+					break;  // rounding left u beyond the tail: try again
+				}
+			}
+			if( u <= p )
+			{
+				return( k );
+			}
+		}
+	}
+
+	/**
+		Return a random number with PTRS.
+		@param[in,out] engine Source of random bits
+		@retval number Random number
+	 */
+	template<typename Engine>
+	uint64_t ptrs( Engine& engine ) const
+	{
+		while( true )
+		{
+			const double u   = to_unit_double( engine() ) - 0.5;
+			const double v   = 1 - to_unit_double( engine() );
+			const double u_s = 0.5 - std::fabs( u );
+			const double k   = std::floor(
+					(2 * _a / u_s + _b) * u + _mean + 0.43 );
+			if( u_s >= 0.07 && v <= _v_r )
+			{
+				return( uint64_t( k ) );
+			}
+			if( k < 0 || (u_s < 0.013 && v > u_s) )
+			{
+				continue;
+			}
+			if( std::log( v ) + _log_alpha - std::log( _a / (u_s * u_s) + _b )
+					<= -_mean + k * _log_mean - std::lgamma( k + 1 ) )
+			{
+				return( uint64_t( k ) );
+			}
+		}
+	}
+
+	double _mean;       //< Mean
+	double _exp_mean;   //< exp(-mean)
+	double _log_mean;   //< log(mean)
+	double _a;          //< PTRS constant a
+	double _b;          //< PTRS constant b
+	double _log_alpha;  //< log of PTRS constant 1 / alpha
+	double _v_r;        //< PTRS limit of v for immediate acceptance
+};
+
+/**
+	@brief Binomial distribution, sampled by inversion for a small mean and with
+	the transformed rejection method BTRD (Hoermann) otherwise.
+
+	The smaller of p and 1 - p is sampled so that the mean n * p is at most
+	n / 2. Below a mean of 10, inversion uses one uniform number; otherwise,
+	BTRD accepts most attempts immediately and settles the rest with a
+	recursion over at most 15 terms or a Stirling approximation of the
+	probability.
+ */
+class Binomial_Distribution
+{
+
+public:
+
+	typedef uint64_t result_type;
+
+	/**
+		Construct a distribution.
+		@param[in] trials Number of trials (n)
+		@param[in] p Probability of success of each trial
+	 */
+	explicit Binomial_Distribution( uint64_t trials = 1, double p = 0.5 )
+	: _trials( trials ), _p( p )
+	{
+		if( !(_p >= 0 && _p <= 1) )
+		{
+			err_quit( "Binomial_Distribution: p (%lf) is not in [0,1]\n", _p );
+		}
+		_flip = _p > 0.5;
+		const double p_s = _flip ? 1 - _p : _p;
+		const double q   = 1 - p_s;
+		const double n   = double( _trials );
+		_r  = p_s / q;
+		_nr = (n + 1) * _r;
+		_inversion = n * p_s < INVERSION_LIMIT;
+		if( _inversion )
+		{
+			_q_n = std::pow( q, n );
+			return;
+		}
+		_npq       = n * p_s * q;
+		const double sqrt_npq = std::sqrt( _npq );
+		_m         = std::floor( (n + 1) * p_s );
+		_b         = 1.15 + 2.53 * sqrt_npq;
+		_a         = -0.0873 + 0.0248 * _b + 0.01 * p_s;
+		_c         = n * p_s + 0.5;
+		_alpha     = (2.83 + 5.1 / _b) * sqrt_npq;
+		_v_r       = 0.92 - 4.2 / _b;
+		_u_rv_r    = 0.86 * _v_r;
+		const double nm = n - _m + 1;
+		_h = (_m + 0.5) * std::log( (_m + 1) / (_r * nm) )
+			+ stirling_correction( _m ) + stirling_correction( n - _m );
+	}
+
+	/**
+		Return a random number.
+		@param[in,out] engine Source of random bits
+		@retval number Random number
+	 */
+	template<typename Engine>
+	inline uint64_t operator()( Engine& engine ) const
+	{
+		auto& bits = bit_engine( engine );
+		const uint64_t k = _inversion ? inversion( bits ) : btrd( bits );
+		return( _flip ? _trials - k : k );
+	}
+
+	/**
+		Return the number of trials.
+		@retval trials Number of trials
+	 */
+	inline uint64_t trials( ) const
+	{
+		return( _trials );
+	}
+
+	/**
+		Return the probability of success of each trial.
+		@retval p Probability
+	 */
+	inline double p( ) const
+	{
+		return( _p );
+	}
+
+private:
+
+	/// Mean below which inversion is used
+	static constexpr double INVERSION_LIMIT = 10;
+
+	/**
+		Return the error of Stirling's approximation of log(k!), i.e.,
+		log(k!) - (k + 1/2) log(k + 1) + (k + 1) - log(2 pi) / 2.
+		@param[in] k Integer
+		@retval correction Correction
+	 */
+	static double stirling_correction( double k )
+	{
+		static const double table[10] = {
+			0.08106146679532726, 0.04134069595540929, 0.02767792568499834,
+			0.02079067210376509, 0.01664469118982119, 0.01387612882307075,
+			0.01189670994589177, 0.01041126526197209, 0.00925546218271273,
+			0.00833056343336287 };
+		if( k < 10 )
+		{
+			return( table[unsigned( k )] );
+		}
+		const double k_1   = k + 1;
+		const double k_1_2 = k_1 * k_1;
+		return( (1.0 / 12 - (1.0 / 360 - 1.0 / 1260 / k_1_2) / k_1_2) / k_1 );
+	}
+
+	/**
+		Return a random number by searching the cumulative distribution from 0.
+		@param[in,out] engine Source of random bits
+		@retval number Random number
+	 */
+	template<typename Engine>
+	uint64_t inversion( Engine& engine ) const
+	{
+		while( true )
+		{
+			double   u = to_unit_double( engine() );
+			double   p = _q_n;
+			uint64_t k = 0;
+			while( u > p && k != _trials )
+			{
+				u -= p;
+				++k;
+				p *= _nr / k - _r;
+			}
+			if( u <= p )
+			{
+				return( k );
+			}
+		}
+	}
+
+	/**
+		Return a random number with BTRD.
+		@param[in,out] engine Source of random bits
+		@retval number Random number
+	 */
+	template<typename Engine>
+	uint64_t btrd( Engine& engine ) const
+	{
+		const double n = double( _trials );
+		while( true )
+		{
+			double v = to_unit_double( engine() );
+			double u;
+			if( v <= _u_rv_r )
+			{
+				u = v / _v_r - 0.43;
+				return( uint64_t( std::floor(
+						(2 * _a / (0.5 - std::fabs( u )) + _b) * u + _c ) ) );
+			}
+			if( v >= _v_r )
+			{
+				u = to_unit_double( engine() ) - 0.5;
+			}
+			else
+			{
+				u = v / _v_r - 0.93;
+				u = (u < 0 ? -0.5 : 0.5) - u;
+				v = to_unit_double( engine() ) * _v_r;
+			}
+
+			const double u_s = 0.5 - std::fabs( u );
+			const double k   = std::floor( (2 * _a / u_s + _b) * u + _c );
+			if( k < 0 || k > n )
+			{
+				continue;
+			}
+			v *= _alpha / (_a / (u_s * u_s) + _b);
+			const double k_m = std::fabs( k - _m );
+			if( k_m <= 15 )
+			{
+				// recursive evaluation of f(k) / f(m)
+				double f = 1;
+				if( _m < k )
+				{
+					for( double i = _m + 1; i <= k; ++i )
+					{
+						f *= _nr / i - _r;
+					}
+				}
+				else
+				{
+					for( double i = k + 1; i <= _m; ++i )
+					{
+						v *= _nr / i - _r;
+					}
+				}
+				if( v <= f )
+				{
+					return( uint64_t( k ) );
+				}
+				continue;
+			}
+
+			// squeeze with the normal approximation, then the exact test
+			v = std::log( v );
+			const double rho = (k_m / _npq) * (((k_m / 3 + 0.625) * k_m + 1.0 / 6)
+					/ _npq + 0.5);
+			const double t = -k_m * k_m / (2 * _npq);
+			if( v < t - rho )
+			{
+				return( uint64_t( k ) );
+			}
+			if( v > t + rho )
+			{
+				continue;
+			}
+			const double nm = n - _m + 1;
+			const double nk = n - k + 1;
+			if( v <= _h + (n + 1) * std::log( nm / nk )
+					+ (k + 0.5) * std::log( nk * _r / (k + 1) )
+					- stirling_correction( k ) - stirling_correction( n - k ) )
+			{
+				return( uint64_t( k ) );
+			}
+		}
+	}
+
+	uint64_t _trials;    //< Number of trials
+	double   _p;         //< Probability of success of each trial
+	bool     _flip;      //< Whether 1 - p is sampled since p > 1/2
+	bool     _inversion;  //< Whether inversion is used rather than BTRD
+	double   _r;         //< p / q of the sampled probability
+	double   _nr;        //< (n + 1) r
+	double   _q_n;       //< q^n, the probability of 0 (inversion)
+	double   _npq;       //< Variance (BTRD)
+	double   _m;         //< Mode (BTRD)
+	double   _a;         //< BTRD constant a
+	double   _b;         //< BTRD constant b
+	double   _c;         //< BTRD constant c, the mean plus 1/2
+	double   _alpha;     //< BTRD constant alpha
+	double   _v_r;       //< BTRD limit of v for the hat's center
+	double   _u_rv_r;    //< BTRD limit of v for immediate acceptance
+	double   _h;         //< BTRD log of the mode's probability, less constants
+};
+
+/**
+	@brief Distribution over the indices 0, ..., n - 1 with given weights,
+	sampled in constant time with an alias table (Walker; Vose's construction).
+
+	The table has one column per index. Column i keeps index i with some
+	probability and otherwise gives its alias, another index. Each sample uses
+	one 64-bit number: the upper half of its product with n selects a column,
+	and the lower half decides between the column's index and its alias.
+	Building the table takes O(n) time, and rebuilding it with new weights
+	reuses its memory.
+
+	Example:
+		Discrete_Distribution d( weights );
+		Xoshiro256ss_Engine engine( seed );
+		std::size_t item = d( engine );
+ */
+class Discrete_Distribution
+{
+
+public:
+
+	typedef std::size_t result_type;
+
+	/**
+		Construct a distribution with a single index.
+	 */
+	Discrete_Distribution( )
+	{
+		const double weight = 1;
+		weights( &weight, 1 );
+	}
+
+	/**
+		Construct a distribution.
+		@param[in] weights Nonnegative weight of each index
+	 */
+	explicit Discrete_Distribution( const std::vector<double>& weights )
+	{
+		this->weights( weights );
+	}
+
+	/**
+		Construct a distribution.
+		@param[in] weights Nonnegative weight of each index
+		@param[in] n Number of indices
+	 */
+	Discrete_Distribution( const double* weights, std::size_t n )
+	{
+		this->weights( weights, n );
+	}
+
+	/**
+		Rebuild the table with new weights.
+		@param[in] weights Nonnegative weight of each index
+	 */
+	inline void weights( const std::vector<double>& weights )
+	{
+		this->weights( weights.empty() ? 0 : &weights[0], weights.size() );
+	}
+
+	void weights( const double*, std::size_t );
+
+	/**
+		Return a random index.
+		@param[in,out] engine Source of random bits
+		@retval index Random index
+	 */
+	template<typename Engine>
+	inline std::size_t operator()( Engine& engine ) const
+	{
+		const unsigned __int128 product
+			= (unsigned __int128)( bit_engine( engine )() ) * _columns.size();
+		const Column& column = _columns[std::size_t( product >> 64 )];
+		return( uint64_t( product ) < column.threshold
+				? std::size_t( product >> 64 ) : column.alias );
+	}
+
+	/**
+		Fill an array with random indices.
+
+		Drawing from Lane_Bits gives the bits from the bulk lanes.
+		@param[in,out] engine Source of random bits
+		@param[out] out Array
+		@param[in] n Number of elements
+	 */
+	template<typename Engine>
+	void sample( Engine& engine, std::size_t* out, std::size_t n ) const
+	{
+		for( std::size_t i = 0; i != n; ++i )
+		{
+			out[i] = (*this)( engine );
+		}
+	}
+
+	/**
+		Return the number of indices.
+		@retval size Number of indices
+	 */
+	inline std::size_t size( ) const
+	{
+		return( _columns.size() );
+	}
+
+	/**
+		Return the probability of an index.
+		@param[in] index Index
+		@retval probability Probability
+	 */
+	inline double probability( std::size_t index ) const
+	{
+		return( _probabilities[index] );
+	}
+
+private:
+
+	/// Column of the alias table
+	struct Column
+	{
+		uint64_t    threshold;  //< Keep the index if the lower bits are below
+		std::size_t alias;      //< Index otherwise
+	};
+
+	std::vector<Column>      _columns;        //< Alias table
+	std::vector<double>      _probabilities;  //< Probability of each index
+	std::vector<double>      _scaled;         //< Scratch: n times probability
+	std::vector<std::size_t> _small;          //< Scratch: columns below 1
+	std::vector<std::size_t> _large;          //< Scratch: columns at least 1
+};
+
+/**
+	Return a random integer in [0, bound) using Lemire's nearly divisionless
+	method: the upper half of the 128-bit product of 64 random bits and the
+	bound is the number, which is exact once products whose lower half falls
+	in the first 2^64 mod bound values are rejected. The remainder is only
+	computed in the rare case that the lower half is below the bound.
+	@param[in,out] engine Source of 64-bit random numbers
+	@param[in] bound Number of possible values (must be positive)
+	@retval number Random integer
+ */
+template<typename Engine>
+inline uint64_t
+random_below( Engine& engine, uint64_t bound )
+{
+	auto& bits = bit_engine( engine );
+	static_assert( is_bit_engine<std::remove_reference_t<decltype( bits )> >::value,
+			"random_below: Engine must return uint64_t" );
+	unsigned __int128 product = (unsigned __int128)( bits() ) * bound;
+	if( __builtin_expect( uint64_t( product ) < bound, 0 ) )
+	{
+		const uint64_t threshold = (0 - bound) % bound;
+		while( uint64_t( product ) < threshold )
+		{
+			product = (unsigned __int128)( bits() ) * bound;
+		}
+	}
+	return( uint64_t( product >> 64 ) );
+}
+
+/**
+	@brief Uniform distribution over the integers in [min, max].
+
+	Any range of a 64-bit type can be sampled exactly, including the full
+	range. Numbers come from random_below(), with the remainder computed once
+	when the distribution is constructed so that sampling never divides.
+
+	Example:
+		Uniform_Int_Distribution<int> die( 1, 6 );
+		Xoshiro256ss_Engine engine( seed );
+		int roll = die( engine );
+ */
+template<typename Integer = int64_t>
+class Uniform_Int_Distribution
+{
+
+public:
+
+	typedef Integer result_type;
+
+	/**
+		Construct a distribution.
+		@param[in] min Minimum value in the distribution's range
+		@param[in] max Maximum value in the distribution's range (inclusive)
+	 */
+	explicit Uniform_Int_Distribution( Integer min = 0, Integer max = 1 )
+	: _min( min ), _range( uint64_t( max ) - uint64_t( min ) )
+	{
+		if( max < min )
+		{
+			err_quit( "Uniform_Int_Distribution: min (%lld) > max (%lld)\n",
+					(long long) min, (long long) max );
+		}
+		_bound     = _range + 1;
+		_threshold = _bound == 0 ? 0 : (0 - _bound) % _bound;
+	}
+
+	/**
+		Return a random number.
+		@param[in,out] engine Source of random bits
+		@retval number Random number
+	 */
+	template<typename Engine>
+	inline Integer operator()( Engine& engine ) const
+	{
+		auto& bits = bit_engine( engine );
+		if( _bound == 0 )
+		{
+			// the full 64-bit range
+			return( Integer( uint64_t( _min ) + bits() ) );
+		}
+		unsigned __int128 product = (unsigned __int128)( bits() ) * _bound;
+		while( uint64_t( product ) < _threshold )
+		{
+			product = (unsigned __int128)( bits() ) * _bound;
+		}
+		return( Integer( uint64_t( _min ) + uint64_t( product >> 64 ) ) );
+	}
+
+	/**
+		Fill an array with random numbers.
+
+		Drawing from Lane_Bits gives the bits from the bulk lanes.
+		@param[in,out] engine Source of random bits
+		@param[out] out Array
+		@param[in] n Number of elements
+	 */
+	template<typename Engine>
+	void sample( Engine& engine, Integer* out, std::size_t n ) const
+	{
+		for( std::size_t i = 0; i != n; ++i )
+		{
+			out[i] = (*this)( engine );
+		}
+	}
+
+	/**
+		Return minimum value in the distribution's range.
+		@retval min Minimum value in the distribution's range
+	 */
+	inline Integer min( ) const
+	{
+		return( _min );
+	}
+
+	/**
+		Return maximum value in the distribution's range.
+		@retval max Maximum value in the distribution's range
+	 */
+	inline Integer max( ) const
+	{
+		return( Integer( uint64_t( _min ) + _range ) );
+	}
+
+private:
+
+	Integer  _min;        //< Minimum value in the distribution's range
+	uint64_t _range;      //< max - min
+	uint64_t _bound;      //< Number of values, or 0 for all 2^64
+	uint64_t _threshold;  //< 2^64 mod bound: lower halves to reject
+};
+
+/**
+	Randomly permute a sequence with the Fisher-Yates shuffle, which makes
+	every permutation equally likely.
+	@param[in,out] first Start of the sequence
+	@param[in,out] last End of the sequence
+	@param[in,out] engine Source of 64-bit random numbers
+ */
+template<typename Iterator, typename Engine>
+void
+shuffle( Iterator first, Iterator last, Engine& engine )
+{
+	for( uint64_t i = uint64_t( last - first ); i > 1; --i )
+	{
+		std::iter_swap( first + (i - 1), first + random_below( engine, i ) );
+	}
+}
+
+/**
+	Choose k distinct integers from [0, n) with Floyd's algorithm, which draws
+	exactly k random numbers and uses O(k) memory however large n is. Every
+	subset is equally likely, but the integers are not in a random order;
+	shuffle() them if one is needed.
+	@param[in,out] engine Source of 64-bit random numbers
+	@param[in] n Number of integers to choose from
+	@param[in] k Number of integers to choose
+	@param[out] chosen Chosen integers
+ */
+template<typename Engine>
+void
+sample_without_replacement( Engine& engine, uint64_t n, std::size_t k,
+		std::vector<uint64_t>& chosen )
+{
+	if( k > n )
+	{
+		err_quit( "sample_without_replacement: k (%lu) > n (%lu)\n",
+				(unsigned long) k, (unsigned long) n );
+	}
+	chosen.clear();
+	chosen.reserve( k );
+	std::unordered_set<uint64_t> seen( 2 * k );
+	for( uint64_t j = n - k; j != n; ++j )
+	{
+		// take a random integer in [0, j], or j itself if it was taken
+		uint64_t t = random_below( engine, j + 1 );
+		if( !seen.insert( t ).second )
+		{
+			t = j;
+			seen.insert( t );
+		}
+		chosen.push_back( t );
+	}
+}
+
+/**
+	@brief Generator of random numbers from a distribution, with the engine
+	and distribution fixed at compile time so that sampling inlines.
+
+	Example:
+		Random_Generator<Xoshiro256ss_Engine, Normal_Distribution> noise(
+			Normal_Distribution( 0, 2 ), seed );
+		for( std::size_t i = 0; i != n; ++i )
+		{
+			image[i] += noise();
+		}
+ */
+template<typename Engine, typename Distribution>
+class Random_Generator
+{
+
+public:
+
+	typedef typename Distribution::result_type result_type;
+
+	/**
+		Construct a generator.
+		@param[in] distribution Distribution
+		@param[in] seed Seed of the engine
+	 */
+	explicit Random_Generator( const Distribution& distribution = Distribution(),
+			uint64_t seed = random_seed() )
+	: _engine( seed ), _distribution( distribution )
+	{ }
+
+	/**
+		Return the next random number.
+		@retval number Next random number
+	 */
+	inline result_type operator()( )
+	{
+		return( _distribution( _engine ) );
+	}
+
+	/**
+		Return the next random number.
+		@retval number Next random number
+	 */
+	inline result_type next( )
+	{
+		return( _distribution( _engine ) );
+	}
+
+	/**
+		Fill an array with random numbers.
+		@param[out] out Array
+		@param[in] n Number of elements
+	 */
+	inline void fill( result_type* out, std::size_t n )
+	{
+		for( std::size_t i = 0; i != n; ++i )
+		{
+			out[i] = _distribution( _engine );
+		}
+	}
+
+	/**
+		Get the engine.
+		@retval engine Engine
+	 */
+	inline Engine& engine( )
+	{
+		return( _engine );
+	}
+
+	/**
+		Get the distribution.
+		@retval distribution Distribution
+	 */
+	inline Distribution& distribution( )
+	{
+		return( _distribution );
+	}
+
+private:
+
+	Engine       _engine;        //< Source of random bits
+	Distribution _distribution;  //< Distribution of the numbers
+};
+
+} // namespace ws_tools
+
+#endif // _RANDOM_DISTRIBUTION_HPP
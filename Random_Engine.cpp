@@ -0,0 +1,703 @@
+/**
+	@file   Random_Engine.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Pseudo-random bit generators used by the Random_Number classes.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#include "Random_Engine.hpp"
+
+// c++ headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+// tools headers
+#include "cpu_features.hpp"
+#include "err_mesg.h"
+
+// vector instructions for stepping several generators at once
+#ifdef __SSE2__
+	#include <emmintrin.h>
+#endif // __SSE2__
+
+using std::size_t;
+
+using namespace ws_tools;
+
+/**
+	Return a seed that differs between calls, threads, processes, and runs,
+	for generators that are not given one.
+
+	The time in nanoseconds is combined with the operating system's random
+	device, the thread, and a count of the calls made so far, then mixed with
+	SplitMix64. Unlike the time in seconds, this gives generators created at the
+	same moment, such as one per thread, different seeds.
+
+	@retval seed Seed
+ */
+uint64_t
+ws_tools::random_seed( )
+{
+	static std::atomic<uint64_t> num_calls( 0 );
+
+	uint64_t seed = std::chrono::high_resolution_clock::now()
+		.time_since_epoch().count();
+	std::random_device device;
+	seed ^= (static_cast<uint64_t>( device() ) << 32) ^ device();
+	seed ^= std::hash<std::thread::id>()( std::this_thread::get_id() )
+		* 0xBF58476D1CE4E5B9ULL;
+	seed += ++num_calls * 0x9E3779B97F4A7C15ULL;
+	return( Splitmix64_Engine( seed )() );
+}
+
+/**
+	Multiply two polynomials over GF(2) modulo the characteristic polynomial
+	of xoshiro256. Polynomials have degree below 256 and are stored as 4 words
+	with the coefficient of x^i in bit i % 64 of word i / 64.
+	@param[in] a Polynomial
+	@param[in] b Polynomial
+	@param[in] p Characteristic polynomial without its x^256 term
+	@param[out] product a * b mod p (may be a or b)
+ */
+static void
+multiply_mod( const uint64_t* a, const uint64_t* b, const uint64_t* p,
+		uint64_t* product )
+{
+	// Horner's rule from the highest coefficient of b, reducing x^256 to p
+	uint64_t t[4] = { 0, 0, 0, 0 };
+	for( unsigned i = 256; i-- != 0; )
+	{
+		const uint64_t carry = t[3] >> 63;
+		t[3] = (t[3] << 1) | (t[2] >> 63);
+		t[2] = (t[2] << 1) | (t[1] >> 63);
+		t[1] = (t[1] << 1) | (t[0] >> 63);
+		t[0] <<= 1;
+		const uint64_t reduce = 0 - carry;
+		const uint64_t add    = 0 - ((b[i / 64] >> (i % 64)) & 1);
+		for( unsigned w = 0; w != 4; ++w )
+		{
+			t[w] ^= (p[w] & reduce) ^ (a[w] & add);
+		}
+	}
+	for( unsigned w = 0; w != 4; ++w )
+	{
+		product[w] = t[w];
+	}
+}
+
+/**
+	Return the characteristic polynomial of xoshiro256's state transition,
+	found on first use with the Berlekamp-Massey algorithm from 512 steps of
+	one bit of the state. The polynomial is primitive, so the minimal
+	polynomial of any bit sequence from a nonzero state is the whole
+	characteristic polynomial. The long jump polynomial x^(2^192) mod p is
+	computed with it.
+	@retval p Characteristic polynomial without its x^256 term, followed by
+		the long jump polynomial
+ */
+static const uint64_t*
+xoshiro256_polynomial( )
+{
+	static const std::vector<uint64_t> p = []( )
+	{
+		const unsigned n = 512;
+		std::vector<unsigned char> bits( n );
+		Xoshiro256p_Engine engine( 1 );
+		for( unsigned i = 0; i != n; ++i )
+		{
+			bits[i] = engine.state()[0] & 1;
+			engine();
+		}
+
+		// connection polynomial c(x) = 1 + c_1 x + ... + c_L x^L
+		std::vector<unsigned char> c( n + 1, 0 );
+		std::vector<unsigned char> b( n + 1, 0 );
+		std::vector<unsigned char> t;
+		c[0] = b[0] = 1;
+		unsigned length = 0;
+		unsigned shift  = 1;
+		for( unsigned i = 0; i != n; ++i )
+		{
+			unsigned char discrepancy = bits[i];
+			for( unsigned j = 1; j <= length; ++j )
+			{
+				discrepancy ^= c[j] & bits[i - j];
+			}
+			if( discrepancy == 0 )
+			{
+				++shift;
+				continue;
+			}
+			t = c;
+			for( unsigned j = 0; j + shift <= n; ++j )
+			{
+				c[j + shift] ^= b[j];
+			}
+			if( 2 * length <= i )
+			{
+				length = i + 1 - length;
+				b      = t;
+				shift  = 1;
+			}
+			else
+			{
+				++shift;
+			}
+		}
+		if( length != 256 )
+		{
+			err_quit( "xoshiro256_polynomial: degree %u is not 256\n", length );
+		}
+
+		// the characteristic polynomial is the reverse, x^256 c(1/x)
+		std::vector<uint64_t> p( 8, 0 );
+		for( unsigned j = 0; j != 256; ++j )
+		{
+			p[j / 64] |= uint64_t( c[256 - j] ) << (j % 64);
+		}
+
+		// x squared 192 times
+		uint64_t* jump = &p[4];
+		jump[0] = 2;
+		for( unsigned i = 0; i != 192; ++i )
+		{
+			multiply_mod( jump, jump, &p[0], jump );
+		}
+		return( p );
+	}();
+	return( &p[0] );
+}
+
+/**
+	Advance the state by num_jumps * 2^192 steps, the same as calling
+	long_jump() num_jumps times. The jump polynomial x^(num_jumps * 2^192) is
+	the long jump polynomial raised to the power num_jumps, which is computed
+	by repeated squaring in O(log(num_jumps)) multiplications.
+	@param[in] num_jumps Number of long jumps
+ */
+void
+Xoshiro256_State::long_jump( uint64_t num_jumps )
+{
+	if( num_jumps <= 1 )
+	{
+		if( num_jumps == 1 )
+		{
+			long_jump();
+		}
+		return;
+	}
+
+	const uint64_t* p = xoshiro256_polynomial();
+	uint64_t power[4]      = { p[4], p[5], p[6], p[7] };
+	uint64_t polynomial[4] = { 1, 0, 0, 0 };
+	for( ; num_jumps != 0; num_jumps >>= 1 )
+	{
+		if( num_jumps & 1 )
+		{
+			multiply_mod( polynomial, power, p, polynomial );
+		}
+		if( num_jumps != 1 )
+		{
+			multiply_mod( power, power, p, power );
+		}
+	}
+	jump_by( polynomial );
+}
+
+/**
+	Move the engine ahead by whole streams, so that engines with the same seed
+	that jump by different numbers of streams never produce the same numbers.
+
+	A stream is 2^192 numbers for xoshiro256 (long_jump()), 2^96 for PCG64,
+	whose period of 2^128 allows 2^32 streams, and 2^48 for SplitMix64, whose
+	period of 2^64 allows only 2^16 streams. rand_r() has no streams. Jumping
+	takes O(log(num_streams)) time for every engine.
+
+	@param[in] num_streams Number of streams
+ */
+void
+Random_Engine::jump_streams( uint64_t num_streams )
+{
+	switch( _kind )
+	{
+		case Xoshiro256ss:
+			_xoshiro256ss.long_jump( num_streams );
+			break;
+
+		case Xoshiro256p:
+			_xoshiro256p.long_jump( num_streams );
+			break;
+
+		case PCG64:
+			if( num_streams >= (uint64_t( 1 ) << 32) )
+			{
+				err_quit( "Random_Engine::jump_streams: PCG64 has only %lu"
+						" streams\n", (unsigned long) (uint64_t( 1 ) << 32) );
+			}
+			_pcg64.advance( static_cast<unsigned __int128>( num_streams ) << 96 );
+			break;
+
+		case Splitmix64:
+			if( num_streams >= (1 << 16) )
+			{
+				err_quit( "Random_Engine::jump_streams: SplitMix64 has only %d"
+						" streams\n", 1 << 16 );
+			}
+			_splitmix64.advance( num_streams << 48 );
+			break;
+
+		case Rand_R:
+			if( num_streams != 0 )
+			{
+				err_quit( "Random_Engine::jump_streams: rand_r() has no streams\n" );
+			}
+			break;
+	}
+}
+
+#ifdef WS_TOOLS_X86_DISPATCH
+/**
+	Compute blocks of a Philox4x32-10 stream 4 at a time using AVX2, as
+	Philox4x32_Engine::blocks() does.
+	@param[in] k0 First key word of each round
+	@param[in] k1 Second key word of each round
+	@param[in] stream_low Lower 32 bits of the stream
+	@param[in] stream_high Upper 32 bits of the stream
+	@param[in] position Index of the first block
+	@param[in] num_blocks Number of blocks
+	@param[out] out Two numbers per block
+	@retval i Number of blocks computed (a multiple of 4)
+ */
+static WS_TOOLS_TARGET( "avx2" ) size_t
+philox_blocks_avx2( const uint32_t* k0, const uint32_t* k1,
+		long long stream_low, long long stream_high, uint64_t position,
+		size_t num_blocks, uint64_t* out )
+{
+	size_t i = 0;
+
+	const __m256i mask_4 = _mm256_set1_epi64x( 0xFFFFFFFFLL );
+	const __m256i m0_4   = _mm256_set1_epi64x( 0xD2511F53LL );
+	const __m256i m1_4   = _mm256_set1_epi64x( 0xCD9E8D57LL );
+	for( ; i + 4 <= num_blocks; i += 4 )
+	{
+		const __m256i counter = _mm256_add_epi64(
+				_mm256_set1_epi64x( static_cast<long long>( position + i ) ),
+				_mm256_set_epi64x( 3, 2, 1, 0 ) );
+		__m256i c0 = _mm256_and_si256( counter, mask_4 );
+		__m256i c1 = _mm256_srli_epi64( counter, 32 );
+		__m256i c2 = _mm256_set1_epi64x( stream_low );
+		__m256i c3 = _mm256_set1_epi64x( stream_high );
+		for( unsigned round = 0; round != 10; ++round )
+		{
+			const __m256i p0 = _mm256_mul_epu32( c0, m0_4 );
+			const __m256i p1 = _mm256_mul_epu32( c2, m1_4 );
+			c0 = _mm256_xor_si256( _mm256_xor_si256( _mm256_srli_epi64( p1, 32 ),
+						c1 ), _mm256_set1_epi64x( k0[round] ) );
+			c1 = _mm256_and_si256( p1, mask_4 );
+			c2 = _mm256_xor_si256( _mm256_xor_si256( _mm256_srli_epi64( p0, 32 ),
+						c3 ), _mm256_set1_epi64x( k1[round] ) );
+			c3 = _mm256_and_si256( p0, mask_4 );
+		}
+
+		// interleave the two numbers of each block
+		const __m256i low  = _mm256_or_si256( c0, _mm256_slli_epi64( c1, 32 ) );
+		const __m256i high = _mm256_or_si256( c2, _mm256_slli_epi64( c3, 32 ) );
+		const __m256i a = _mm256_unpacklo_epi64( low, high );
+		const __m256i b = _mm256_unpackhi_epi64( low, high );
+		_mm256_storeu_si256( reinterpret_cast<__m256i*>( out + 2 * i ),
+				_mm256_permute2x128_si256( a, b, 0x20 ) );
+		_mm256_storeu_si256( reinterpret_cast<__m256i*>( out + 2 * i + 4 ),
+				_mm256_permute2x128_si256( a, b, 0x31 ) );
+	}
+	return( i );
+}
+#endif // WS_TOOLS_X86_DISPATCH
+
+/**
+	Compute consecutive blocks of a stream.
+
+	Blocks are computed 4 (AVX2) or 2 (SSE2) at a time, with each 32-bit word
+	of the counters held in the lower half of a 64-bit vector lane so that the
+	32 x 32 -> 64-bit multiply instruction gives both halves of each Philox
+	product. The results are the same as calling block() for each counter.
+
+	@param[in] stream Upper 64 bits of counter
+	@param[in] position Lower 64 bits of first counter
+	@param[in] num_blocks Number of blocks
+	@param[out] out Two numbers per block
+ */
+void
+Philox4x32_Engine::blocks( uint64_t stream, uint64_t position,
+		size_t num_blocks, uint64_t* out ) const
+{
+	size_t i = 0;
+
+#if defined( __SSE2__ ) || defined( WS_TOOLS_X86_DISPATCH )
+	// keys of each round
+	uint32_t k0[10];
+	uint32_t k1[10];
+	k0[0] = static_cast<uint32_t>( _key );
+	k1[0] = static_cast<uint32_t>( _key >> 32 );
+	for( unsigned round = 1; round != 10; ++round )
+	{
+		k0[round] = k0[round - 1] + 0x9E3779B9;
+		k1[round] = k1[round - 1] + 0xBB67AE85;
+	}
+	const long long stream_low  = static_cast<uint32_t>( stream );
+	const long long stream_high = static_cast<uint32_t>( stream >> 32 );
+#endif // __SSE2__ || WS_TOOLS_X86_DISPATCH
+
+#ifdef WS_TOOLS_X86_DISPATCH
+	if( cpu_has_avx2() )
+	{
+		i = philox_blocks_avx2( k0, k1, stream_low, stream_high, position,
+				num_blocks, out );
+	}
+#endif // WS_TOOLS_X86_DISPATCH
+
+#ifdef __SSE2__
+	const __m128i mask_2 = _mm_set1_epi64x( 0xFFFFFFFFLL );
+	const __m128i m0_2   = _mm_set1_epi64x( 0xD2511F53LL );
+	const __m128i m1_2   = _mm_set1_epi64x( 0xCD9E8D57LL );
+	for( ; i + 2 <= num_blocks; i += 2 )
+	{
+		const __m128i counter = _mm_add_epi64(
+				_mm_set1_epi64x( static_cast<long long>( position + i ) ),
+				_mm_set_epi64x( 1, 0 ) );
+		__m128i c0 = _mm_and_si128( counter, mask_2 );
+		__m128i c1 = _mm_srli_epi64( counter, 32 );
+		__m128i c2 = _mm_set1_epi64x( stream_low );
+		__m128i c3 = _mm_set1_epi64x( stream_high );
+		for( unsigned round = 0; round != 10; ++round )
+		{
+			const __m128i p0 = _mm_mul_epu32( c0, m0_2 );
+			const __m128i p1 = _mm_mul_epu32( c2, m1_2 );
+			c0 = _mm_xor_si128( _mm_xor_si128( _mm_srli_epi64( p1, 32 ), c1 ),
+					_mm_set1_epi64x( k0[round] ) );
+			c1 = _mm_and_si128( p1, mask_2 );
+			c2 = _mm_xor_si128( _mm_xor_si128( _mm_srli_epi64( p0, 32 ), c3 ),
+					_mm_set1_epi64x( k1[round] ) );
+			c3 = _mm_and_si128( p0, mask_2 );
+		}
+
+		// interleave the two numbers of each block
+		const __m128i low  = _mm_or_si128( c0, _mm_slli_epi64( c1, 32 ) );
+		const __m128i high = _mm_or_si128( c2, _mm_slli_epi64( c3, 32 ) );
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( out + 2 * i ),
+				_mm_unpacklo_epi64( low, high ) );
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( out + 2 * i + 2 ),
+				_mm_unpackhi_epi64( low, high ) );
+	}
+#endif // __SSE2__
+
+	for( ; i != num_blocks; ++i )
+	{
+		block( stream, position + i, out + 2 * i );
+	}
+}
+
+/**
+	Seed the generators. Lane 0 starts where an Xoshiro256ss_Engine with the
+	same seed would after long_jump() is called stream times, and each
+	following lane starts 2^128 steps after the one before it.
+	@param[in] seed Seed
+	@param[in] stream Stream to use
+ */
+void
+Xoshiro256_Lanes::seed( uint64_t seed, uint64_t stream )
+{
+	Xoshiro256ss_Engine engine( seed );
+	engine.long_jump( stream );
+	for( unsigned lane = 0; lane != NUM_LANES; ++lane )
+	{
+		for( unsigned i = 0; i != 4; ++i )
+		{
+			_s[i][lane] = engine.state()[i];
+		}
+		engine.jump();
+	}
+	_next = NUM_LANES;
+}
+
+#ifdef WS_TOOLS_X86_DISPATCH
+/**
+	Advance every lane a number of times using AVX2, 4 lanes at a time, as
+	Xoshiro256_Lanes::step() does.
+	@param[in,out] s State word i of each lane
+	@param[out] out Numbers, with those of step i at out[NUM_LANES * i]
+	@param[in] num_steps Number of steps
+ */
+static WS_TOOLS_TARGET( "avx2" ) void
+lanes_step_avx2( uint64_t (*s)[Xoshiro256_Lanes::NUM_LANES], uint64_t* out,
+		size_t num_steps )
+{
+	for( unsigned lane = 0; lane != Xoshiro256_Lanes::NUM_LANES; lane += 4 )
+	{
+		__m256i s0 = _mm256_load_si256( reinterpret_cast<__m256i*>( &s[0][lane] ) );
+		__m256i s1 = _mm256_load_si256( reinterpret_cast<__m256i*>( &s[1][lane] ) );
+		__m256i s2 = _mm256_load_si256( reinterpret_cast<__m256i*>( &s[2][lane] ) );
+		__m256i s3 = _mm256_load_si256( reinterpret_cast<__m256i*>( &s[3][lane] ) );
+		for( size_t i = 0; i != num_steps; ++i )
+		{
+			// rotate_left( s1 * 5, 7 ) * 9
+			__m256i x = _mm256_add_epi64( _mm256_slli_epi64( s1, 2 ), s1 );
+			x = _mm256_or_si256( _mm256_slli_epi64( x, 7 ),
+					_mm256_srli_epi64( x, 57 ) );
+			x = _mm256_add_epi64( _mm256_slli_epi64( x, 3 ), x );
+			_mm256_storeu_si256( reinterpret_cast<__m256i*>(
+						out + Xoshiro256_Lanes::NUM_LANES * i + lane ), x );
+
+			const __m256i t = _mm256_slli_epi64( s1, 17 );
+			s2 = _mm256_xor_si256( s2, s0 );
+			s3 = _mm256_xor_si256( s3, s1 );
+			s1 = _mm256_xor_si256( s1, s2 );
+			s0 = _mm256_xor_si256( s0, s3 );
+			s2 = _mm256_xor_si256( s2, t );
+			s3 = _mm256_or_si256( _mm256_slli_epi64( s3, 45 ),
+					_mm256_srli_epi64( s3, 19 ) );
+		}
+		_mm256_store_si256( reinterpret_cast<__m256i*>( &s[0][lane] ), s0 );
+		_mm256_store_si256( reinterpret_cast<__m256i*>( &s[1][lane] ), s1 );
+		_mm256_store_si256( reinterpret_cast<__m256i*>( &s[2][lane] ), s2 );
+		_mm256_store_si256( reinterpret_cast<__m256i*>( &s[3][lane] ), s3 );
+	}
+}
+#endif // WS_TOOLS_X86_DISPATCH
+
+/**
+	Advance every lane a number of times, writing each lane's numbers.
+
+	Each group of lanes that fits in a vector register is advanced through all
+	of the steps before the next group, so its state stays in registers and is
+	loaded and stored only once per call. The multiplications by 5 and 9 in
+	xoshiro256** are done as shifts and adds, since neither SSE2 nor AVX2 has a
+	64-bit multiply.
+
+	@param[out] out Numbers, with those of step i at out[NUM_LANES * i]
+	@param[in] num_steps Number of steps
+ */
+void
+Xoshiro256_Lanes::step( uint64_t* out, size_t num_steps )
+{
+	unsigned lane = 0;
+
+#ifdef WS_TOOLS_X86_DISPATCH
+	if( cpu_has_avx2() )
+	{
+		lanes_step_avx2( _s, out, num_steps );
+		lane = NUM_LANES;
+	}
+#endif // WS_TOOLS_X86_DISPATCH
+
+#ifdef __SSE2__
+	for( ; lane != NUM_LANES; lane += 2 )
+	{
+		__m128i s0 = _mm_load_si128( reinterpret_cast<__m128i*>( &_s[0][lane] ) );
+		__m128i s1 = _mm_load_si128( reinterpret_cast<__m128i*>( &_s[1][lane] ) );
+		__m128i s2 = _mm_load_si128( reinterpret_cast<__m128i*>( &_s[2][lane] ) );
+		__m128i s3 = _mm_load_si128( reinterpret_cast<__m128i*>( &_s[3][lane] ) );
+		for( size_t i = 0; i != num_steps; ++i )
+		{
+			// rotate_left( s1 * 5, 7 ) * 9
+			__m128i x = _mm_add_epi64( _mm_slli_epi64( s1, 2 ), s1 );
+			x = _mm_or_si128( _mm_slli_epi64( x, 7 ), _mm_srli_epi64( x, 57 ) );
+			x = _mm_add_epi64( _mm_slli_epi64( x, 3 ), x );
+			_mm_storeu_si128( reinterpret_cast<__m128i*>(
+						out + NUM_LANES * i + lane ), x );
+
+			const __m128i t = _mm_slli_epi64( s1, 17 );
+			s2 = _mm_xor_si128( s2, s0 );
+			s3 = _mm_xor_si128( s3, s1 );
+			s1 = _mm_xor_si128( s1, s2 );
+			s0 = _mm_xor_si128( s0, s3 );
+			s2 = _mm_xor_si128( s2, t );
+			s3 = _mm_or_si128( _mm_slli_epi64( s3, 45 ),
+					_mm_srli_epi64( s3, 19 ) );
+		}
+		_mm_store_si128( reinterpret_cast<__m128i*>( &_s[0][lane] ), s0 );
+		_mm_store_si128( reinterpret_cast<__m128i*>( &_s[1][lane] ), s1 );
+		_mm_store_si128( reinterpret_cast<__m128i*>( &_s[2][lane] ), s2 );
+		_mm_store_si128( reinterpret_cast<__m128i*>( &_s[3][lane] ), s3 );
+	}
+#endif // __SSE2__
+
+	for( ; lane != NUM_LANES; ++lane )
+	{
+		uint64_t s0 = _s[0][lane];
+		uint64_t s1 = _s[1][lane];
+		uint64_t s2 = _s[2][lane];
+		uint64_t s3 = _s[3][lane];
+		for( size_t i = 0; i != num_steps; ++i )
+		{
+			out[NUM_LANES * i + lane] = rotate_left( s1 * 5, 7 ) * 9;
+			const uint64_t t = s1 << 17;
+			s2 ^= s0;
+			s3 ^= s1;
+			s1 ^= s2;
+			s0 ^= s3;
+			s2 ^= t;
+			s3 = rotate_left( s3, 45 );
+		}
+		_s[0][lane] = s0;
+		_s[1][lane] = s1;
+		_s[2][lane] = s2;
+		_s[3][lane] = s3;
+	}
+}
+
+/**
+	Fill an array with random bits.
+	@param[out] out Array
+	@param[in] n Number of elements
+ */
+void
+Xoshiro256_Lanes::fill( uint64_t* out, size_t n )
+{
+	// use the numbers left from the last call first
+	size_t i = 0;
+	for( ; i != n && _next != NUM_LANES; ++i )
+	{
+		out[i] = _buffer[_next++];
+	}
+	const size_t num_steps = (n - i) / NUM_LANES;
+	step( out + i, num_steps );
+	i += NUM_LANES * num_steps;
+	if( i != n )
+	{
+		step( _buffer, 1 );
+		_next = 0;
+		for( ; i != n; ++i )
+		{
+			out[i] = _buffer[_next++];
+		}
+	}
+}
+
+#ifdef WS_TOOLS_X86_DISPATCH
+/**
+	Convert random bits to doubles 4 at a time using AVX2, as
+	to_unit_doubles() does.
+	@param[in] in Random bits
+	@param[out] out Doubles
+	@param[in] n Number of elements
+	@param[in] min Minimum value
+	@param[in] scale Width of range
+	@retval i Number of elements converted (a multiple of 4)
+ */
+static WS_TOOLS_TARGET( "avx2" ) size_t
+to_unit_doubles_avx2( const uint64_t* in, double* out, size_t n, double min,
+		double scale )
+{
+	size_t i = 0;
+
+	const __m256i exponent  = _mm256_set1_epi64x( 0x4330000000000000LL );
+	const __m256i one       = _mm256_set1_epi64x( 1 );
+	const __m256d two_52    = _mm256_set1_pd( 0x1.0p52 );
+	const __m256d scale_52  = _mm256_set1_pd( 0x1.0p-52 );
+	const __m256d scale_53  = _mm256_set1_pd( 0x1.0p-53 );
+	const __m256d min_4     = _mm256_set1_pd( min );
+	const __m256d scale_4   = _mm256_set1_pd( scale );
+	for( ; i + 4 <= n; i += 4 )
+	{
+		const __m256i bits = _mm256_srli_epi64( _mm256_loadu_si256(
+					reinterpret_cast<const __m256i*>( in + i ) ), 11 );
+		const __m256d high = _mm256_sub_pd( _mm256_castsi256_pd( _mm256_or_si256(
+						_mm256_srli_epi64( bits, 1 ), exponent ) ), two_52 );
+		const __m256d low = _mm256_sub_pd( _mm256_castsi256_pd( _mm256_or_si256(
+						_mm256_and_si256( bits, one ), exponent ) ), two_52 );
+		const __m256d unit = _mm256_add_pd( _mm256_mul_pd( high, scale_52 ),
+				_mm256_mul_pd( low, scale_53 ) );
+		_mm256_storeu_pd( out + i,
+				_mm256_add_pd( min_4, _mm256_mul_pd( scale_4, unit ) ) );
+	}
+	return( i );
+}
+#endif // WS_TOOLS_X86_DISPATCH
+
+/**
+	Convert random bits to doubles in [min, min + scale), giving the same
+	results as min + scale * to_unit_double().
+
+	Without AVX-512 there is no instruction to convert 64-bit integers, so the
+	53 bits are split into their upper 52, which are converted exactly by
+	placing them in the mantissa of 2^52 and subtracting 2^52, and their lowest
+	bit; scaling each part by a power of 2 and adding them is also exact.
+
+	@param[in] in Random bits
+	@param[out] out Doubles
+	@param[in] n Number of elements
+	@param[in] min Minimum value
+	@param[in] scale Width of range
+ */
+void
+ws_tools::to_unit_doubles( const uint64_t* in, double* out, size_t n,
+		double min, double scale )
+{
+	size_t i = 0;
+
+#ifdef WS_TOOLS_X86_DISPATCH
+	if( cpu_has_avx2() )
+	{
+		i = to_unit_doubles_avx2( in, out, n, min, scale );
+	}
+#endif // WS_TOOLS_X86_DISPATCH
+
+#ifdef __SSE2__
+	const __m128i exponent_2 = _mm_set1_epi64x( 0x4330000000000000LL );
+	const __m128i one_2      = _mm_set1_epi64x( 1 );
+	const __m128d two_52_2   = _mm_set1_pd( 0x1.0p52 );
+	const __m128d scale_52_2 = _mm_set1_pd( 0x1.0p-52 );
+	const __m128d scale_53_2 = _mm_set1_pd( 0x1.0p-53 );
+	const __m128d min_2      = _mm_set1_pd( min );
+	const __m128d scale_2    = _mm_set1_pd( scale );
+	for( ; i + 2 <= n; i += 2 )
+	{
+		const __m128i bits = _mm_srli_epi64( _mm_loadu_si128(
+					reinterpret_cast<const __m128i*>( in + i ) ), 11 );
+		const __m128d high = _mm_sub_pd( _mm_castsi128_pd( _mm_or_si128(
+						_mm_srli_epi64( bits, 1 ), exponent_2 ) ), two_52_2 );
+		const __m128d low = _mm_sub_pd( _mm_castsi128_pd( _mm_or_si128(
+						_mm_and_si128( bits, one_2 ), exponent_2 ) ), two_52_2 );
+		const __m128d unit = _mm_add_pd( _mm_mul_pd( high, scale_52_2 ),
+				_mm_mul_pd( low, scale_53_2 ) );
+		_mm_storeu_pd( out + i, _mm_add_pd( min_2, _mm_mul_pd( scale_2, unit ) ) );
+	}
+#endif // __SSE2__
+
+	for( ; i != n; ++i )
+	{
+		out[i] = min + scale * to_unit_double( in[i] );
+	}
+}
+
+/**
+	Fill an array with doubles uniformly distributed in [min, max), each made
+	from 53 random bits.
+	@param[out] out Array
+	@param[in] n Number of elements
+	@param[in] min Minimum value
+	@param[in] max Maximum value
+ */
+void
+Xoshiro256_Lanes::fill_unit( double* out, size_t n, double min, double max )
+{
+	// generate the bits in blocks small enough to stay in cache
+	const size_t block_size = 1024;
+	alignas(32) uint64_t bits[block_size];
+	for( size_t i = 0; i < n; i += block_size )
+	{
+		const size_t m = std::min( block_size, n - i );
+		fill( bits, m );
+		to_unit_doubles( bits, out + i, m, min, max - min );
+	}
+}
@@ -0,0 +1,849 @@
+/**
+	@file   Random_Engine.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Pseudo-random bit generators used by the Random_Number classes.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _RANDOM_ENGINE_HPP
+#define _RANDOM_ENGINE_HPP
+
+// c++ headers
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+// c headers
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace ws_tools
+{
+
+extern uint64_t random_seed( );
+
+/**
+	Convert 64 random bits to a double uniformly distributed in [0, 1) using
+	the upper 53 bits, so that every representable multiple of 2^-53 is
+	equally likely.
+	@param[in] bits Random bits
+	@retval number Number in [0, 1)
+ */
+inline double
+to_unit_double( uint64_t bits )
+{
+	return( (bits >> 11) * 0x1.0p-53 );
+}
+
+extern void to_unit_doubles( const uint64_t*, double*, std::size_t,
+		double = 0, double = 1 );
+
+/**
+	Rotate bits left.
+	@param[in] x Bits to rotate
+	@param[in] k Number of bits to rotate by (1 to 63)
+	@retval rotated Rotated bits
+ */
+inline uint64_t
+rotate_left( uint64_t x, unsigned k )
+{
+	return( (x << k) | (x >> (64 - k)) );
+}
+
+/**
+	@brief SplitMix64 generator: a 64-bit counter passed through a mixing
+	function.
+
+	Its output is well distributed even for similar seeds, so it is used to
+	expand one 64-bit seed into the larger states of the other engines.
+ */
+class Splitmix64_Engine
+{
+
+public:
+
+	typedef uint64_t result_type;
+
+	/**
+		Seed the generator.
+		@param[in] seed Seed
+	 */
+	explicit Splitmix64_Engine( uint64_t seed = 0 )
+	: _state( seed )
+	{ }
+
+	/**
+		Return the next 64 random bits.
+		@retval bits Random bits
+	 */
+	inline uint64_t operator()( )
+	{
+		uint64_t z = (_state += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return( z ^ (z >> 31) );
+	}
+
+	/**
+		Advance by a number of steps.
+		@param[in] num_steps Number of steps
+	 */
+	inline void advance( uint64_t num_steps )
+	{
+		_state += num_steps * 0x9E3779B97F4A7C15ULL;
+	}
+
+	/// Smallest value returned
+	static constexpr uint64_t min( ) { return( 0 ); }
+
+	/// Largest value returned
+	static constexpr uint64_t max( ) { return( ~uint64_t( 0 ) ); }
+
+private:
+
+	uint64_t _state;  //< Counter
+};
+
+/**
+	@brief Shared state update of the xoshiro256 generators (Blackman and
+	Vigna), which have a period of 2^256 - 1.
+
+	jump() and long_jump() advance the state by 2^128 and 2^192 steps, which
+	splits the period into streams that provably do not overlap: 2^64 streams
+	of 2^192 numbers each from long_jump(), and 2^64 substreams of 2^128
+	numbers within each from jump().
+ */
+class Xoshiro256_State
+{
+
+public:
+
+	/**
+		Seed the state with the output of SplitMix64, which cannot make it all
+		zeros.
+		@param[in] seed Seed
+	 */
+	inline void seed( uint64_t seed )
+	{
+		Splitmix64_Engine splitmix( seed );
+		for( unsigned i = 0; i != 4; ++i )
+		{
+			_s[i] = splitmix();
+		}
+	}
+
+	/**
+		Advance the state by 2^128 steps.
+	 */
+	inline void jump( )
+	{
+		static const uint64_t polynomial[4] = { 0x180EC6D33CFD0ABAULL,
+			0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+		jump_by( polynomial );
+	}
+
+	/**
+		Advance the state by 2^192 steps.
+	 */
+	inline void long_jump( )
+	{
+		static const uint64_t polynomial[4] = { 0x76E15D3EFEFDCBBFULL,
+			0xC5004E441C522FB3ULL, 0x77710069854EE241ULL, 0x39109BB02ACBE635ULL };
+		jump_by( polynomial );
+	}
+
+	void long_jump( uint64_t );
+
+	/**
+		Return the state.
+		@retval state Four words of state
+	 */
+	inline const uint64_t* state( ) const
+	{
+		return( _s );
+	}
+
+protected:
+
+	/**
+		Advance the state by the number of steps whose characteristic
+		polynomial is given, by summing the states that the polynomial's terms
+		select.
+		@param[in] polynomial Jump polynomial
+	 */
+	inline void jump_by( const uint64_t* polynomial )
+	{
+		uint64_t s[4] = { 0, 0, 0, 0 };
+		for( unsigned i = 0; i != 4; ++i )
+		{
+			for( unsigned b = 0; b != 64; ++b )
+			{
+				if( polynomial[i] & (uint64_t( 1 ) << b) )
+				{
+					s[0] ^= _s[0];
+					s[1] ^= _s[1];
+					s[2] ^= _s[2];
+					s[3] ^= _s[3];
+				}
+				step();
+			}
+		}
+		for( unsigned i = 0; i != 4; ++i )
+		{
+			_s[i] = s[i];
+		}
+	}
+
+	/**
+		Advance the state.
+	 */
+	inline void step( )
+	{
+		const uint64_t t = _s[1] << 17;
+		_s[2] ^= _s[0];
+		_s[3] ^= _s[1];
+		_s[1] ^= _s[2];
+		_s[0] ^= _s[3];
+		_s[2] ^= t;
+		_s[3] = rotate_left( _s[3], 45 );
+	}
+
+	uint64_t _s[4];  //< State
+};
+
+/**
+	@brief xoshiro256** generator: all 64 output bits are of high quality.
+	This is the default engine.
+ */
+class Xoshiro256ss_Engine : public Xoshiro256_State
+{
+
+public:
+
+	typedef uint64_t result_type;
+
+	/**
+		Seed the generator.
+		@param[in] seed Seed
+	 */
+	explicit Xoshiro256ss_Engine( uint64_t seed = 0 )
+	{
+		Xoshiro256_State::seed( seed );
+	}
+
+	/**
+		Return the next 64 random bits.
+		@retval bits Random bits
+	 */
+	inline uint64_t operator()( )
+	{
+		const uint64_t result = rotate_left( _s[1] * 5, 7 ) * 9;
+		step();
+		return( result );
+	}
+
+	/// Smallest value returned
+	static constexpr uint64_t min( ) { return( 0 ); }
+
+	/// Largest value returned
+	static constexpr uint64_t max( ) { return( ~uint64_t( 0 ) ); }
+};
+
+/**
+	@brief xoshiro256+ generator: slightly faster than xoshiro256**, but its
+	lowest bits are weak, so it is meant for generating doubles, which use
+	only the upper 53 bits.
+ */
+class Xoshiro256p_Engine : public Xoshiro256_State
+{
+
+public:
+
+	typedef uint64_t result_type;
+
+	/**
+		Seed the generator.
+		@param[in] seed Seed
+	 */
+	explicit Xoshiro256p_Engine( uint64_t seed = 0 )
+	{
+		Xoshiro256_State::seed( seed );
+	}
+
+	/**
+		Return the next 64 random bits.
+		@retval bits Random bits
+	 */
+	inline uint64_t operator()( )
+	{
+		const uint64_t result = _s[0] + _s[3];
+		step();
+		return( result );
+	}
+
+	/// Smallest value returned
+	static constexpr uint64_t min( ) { return( 0 ); }
+
+	/// Largest value returned
+	static constexpr uint64_t max( ) { return( ~uint64_t( 0 ) ); }
+};
+
+/**
+	@brief PCG64 generator (O'Neill): a 128-bit linear congruential generator
+	whose output is permuted with an xorshift and a random rotation (XSL RR).
+ */
+class PCG64_Engine
+{
+
+public:
+
+	typedef uint64_t result_type;
+
+	/**
+		Seed the generator.
+		@param[in] seed Seed
+	 */
+	explicit PCG64_Engine( uint64_t seed = 0 )
+	{
+		this->seed( seed );
+	}
+
+	/**
+		Seed the generator, choosing both the starting state and the stream
+		(increment) from the seed.
+		@param[in] seed Seed
+	 */
+	inline void seed( uint64_t seed )
+	{
+		Splitmix64_Engine splitmix( seed );
+		const unsigned __int128 state
+			= (static_cast<unsigned __int128>( splitmix() ) << 64) | splitmix();
+		const unsigned __int128 stream
+			= (static_cast<unsigned __int128>( splitmix() ) << 64) | splitmix();
+		_increment = (stream << 1) | 1;
+		_state     = 0;
+		step();
+		_state += state;
+		step();
+	}
+
+	/**
+		Return the next 64 random bits.
+		@retval bits Random bits
+	 */
+	inline uint64_t operator()( )
+	{
+		step();
+		const uint64_t xored = static_cast<uint64_t>( _state >> 64 )
+			^ static_cast<uint64_t>( _state );
+		const unsigned rotation = static_cast<unsigned>( _state >> 122 );
+		return( (xored >> rotation) | (xored << ((64 - rotation) & 63)) );
+	}
+
+	/**
+		Advance the state by any number of steps in O(log steps) time, by
+		composing the affine step with itself (Brown's method).
+		@param[in] num_steps Number of steps
+	 */
+	inline void advance( unsigned __int128 num_steps )
+	{
+		unsigned __int128 multiplier       = MULTIPLIER;
+		unsigned __int128 increment        = _increment;
+		unsigned __int128 total_multiplier = 1;
+		unsigned __int128 total_increment  = 0;
+		while( num_steps != 0 )
+		{
+			if( num_steps & 1 )
+			{
+				total_multiplier *= multiplier;
+				total_increment   = total_increment * multiplier + increment;
+			}
+			increment  *= multiplier + 1;
+			multiplier *= multiplier;
+			num_steps >>= 1;
+		}
+		_state = total_multiplier * _state + total_increment;
+	}
+
+	/// Smallest value returned
+	static constexpr uint64_t min( ) { return( 0 ); }
+
+	/// Largest value returned
+	static constexpr uint64_t max( ) { return( ~uint64_t( 0 ) ); }
+
+protected:
+
+	/// Multiplier of the linear congruential generator
+	static constexpr unsigned __int128 MULTIPLIER
+		= (static_cast<unsigned __int128>( 0x2360ED051FC65DA4ULL ) << 64)
+		| 0x4385DF649FCCF645ULL;
+
+	/**
+		Advance the state.
+	 */
+	inline void step( )
+	{
+		_state = _state * MULTIPLIER + _increment;
+	}
+
+	unsigned __int128 _state;      //< State
+	unsigned __int128 _increment;  //< Increment, which selects the stream
+};
+
+/**
+	@brief Philox4x32-10 counter-based generator (Salmon et al.): a keyed
+	bijection of a 128-bit counter, so the block for any (key, counter) pair
+	is computed directly, without generating the blocks before it.
+
+	Each block is 128 bits, returned as two 64-bit numbers. The counter is
+	split into a 64-bit stream, such as an item or task number, and a 64-bit
+	position within it, so number k of stream i is half k % 2 of the block at
+	position k / 2. Used as an engine, it returns the numbers of one stream in
+	order.
+ */
+class Philox4x32_Engine
+{
+
+public:
+
+	typedef uint64_t result_type;
+
+	/**
+		Construct a generator.
+		@param[in] key Key (the seed)
+		@param[in] stream Stream that operator() reads
+	 */
+	explicit Philox4x32_Engine( uint64_t key = 0, uint64_t stream = 0 )
+	: _key( key ), _stream( stream ), _position( 0 ), _cached( ~uint64_t( 0 ) )
+	{ }
+
+	/**
+		Compute the block at a counter.
+		@param[in] stream Upper 64 bits of counter
+		@param[in] position Lower 64 bits of counter
+		@param[out] out Two 64-bit numbers
+	 */
+	inline void block( uint64_t stream, uint64_t position, uint64_t* out ) const
+	{
+		uint32_t c[4] = { static_cast<uint32_t>( position ),
+			static_cast<uint32_t>( position >> 32 ),
+			static_cast<uint32_t>( stream ),
+			static_cast<uint32_t>( stream >> 32 ) };
+		uint32_t k0 = static_cast<uint32_t>( _key );
+		uint32_t k1 = static_cast<uint32_t>( _key >> 32 );
+		for( unsigned round = 0; round != 10; ++round )
+		{
+			const uint64_t p0 = uint64_t( 0xD2511F53 ) * c[0];
+			const uint64_t p1 = uint64_t( 0xCD9E8D57 ) * c[2];
+			c[0] = static_cast<uint32_t>( p1 >> 32 ) ^ c[1] ^ k0;
+			c[1] = static_cast<uint32_t>( p1 );
+			c[2] = static_cast<uint32_t>( p0 >> 32 ) ^ c[3] ^ k1;
+			c[3] = static_cast<uint32_t>( p0 );
+			k0 += 0x9E3779B9;
+			k1 += 0xBB67AE85;
+		}
+		out[0] = c[0] | (static_cast<uint64_t>( c[1] ) << 32);
+		out[1] = c[2] | (static_cast<uint64_t>( c[3] ) << 32);
+	}
+
+	void blocks( uint64_t, uint64_t, std::size_t, uint64_t* ) const;
+
+	/**
+		Return the next 64 random bits of the stream.
+		@retval bits Random bits
+	 */
+	inline uint64_t operator()( )
+	{
+		const uint64_t position = _position++;
+		if( (position >> 1) != _cached )
+		{
+			_cached = position >> 1;
+			block( _stream, _cached, _block );
+		}
+		return( _block[position & 1] );
+	}
+
+	/**
+		Move to a number in a stream.
+		@param[in] stream Stream
+		@param[in] position Index of the next number returned
+	 */
+	inline void seek( uint64_t stream, uint64_t position )
+	{
+		if( stream != _stream )
+		{
+			_cached = ~uint64_t( 0 );
+		}
+		_stream   = stream;
+		_position = position;
+	}
+
+	/**
+		Return the index of the next number returned.
+		@retval position Position
+	 */
+	inline uint64_t position( ) const
+	{
+		return( _position );
+	}
+
+	/**
+		Return the stream being read.
+		@retval stream Stream
+	 */
+	inline uint64_t stream( ) const
+	{
+		return( _stream );
+	}
+
+	/// Smallest value returned
+	static constexpr uint64_t min( ) { return( 0 ); }
+
+	/// Largest value returned
+	static constexpr uint64_t max( ) { return( ~uint64_t( 0 ) ); }
+
+private:
+
+	uint64_t _key;       //< Key
+	uint64_t _stream;    //< Stream read by operator()
+	uint64_t _position;  //< Index of next number in stream
+	uint64_t _cached;    //< Position of the block in _block
+	uint64_t _block[2];  //< Last block computed
+};
+
+/**
+	@brief Generator using the C library's rand_r(), which Uniform_Number
+	originally used. It has at most 32 bits of state and is kept only to
+	reproduce old results.
+ */
+class Rand_R_Engine
+{
+
+public:
+
+	typedef uint64_t result_type;
+
+	/**
+		Seed the generator.
+		@param[in] seed Seed (only the lower 32 bits are used)
+	 */
+	explicit Rand_R_Engine( uint64_t seed = 0 )
+	: _seed( static_cast<unsigned>( seed ) )
+	{ }
+
+	/**
+		Return the next 64 random bits, made from three calls to rand_r().
+		@retval bits Random bits
+	 */
+	inline uint64_t operator()( )
+	{
+		const uint64_t a = rand_r( &_seed );
+		const uint64_t b = rand_r( &_seed );
+		const uint64_t c = rand_r( &_seed );
+		return( (a << 33) ^ (b << 11) ^ c );
+	}
+
+	/**
+		Return a number in [0, 1) from one call to rand_r(), exactly as
+		Uniform_Number originally computed it.
+		@retval number Number in [0, 1)
+	 */
+	inline double next_double( )
+	{
+		return( rand_r( &_seed ) / (RAND_MAX + 1.0) );
+	}
+
+	/// Smallest value returned
+	static constexpr uint64_t min( ) { return( 0 ); }
+
+	/// Largest value returned
+	static constexpr uint64_t max( ) { return( ~uint64_t( 0 ) ); }
+
+private:
+
+	unsigned _seed;  //< State of rand_r()
+};
+
+/**
+	@brief Engine chosen when a generator is constructed, which is how the
+	Random_Number classes select their source of random bits.
+
+	The engines are stored together rather than behind a pointer, so choosing
+	one costs a predictable branch per number rather than an allocation and an
+	indirect call.
+ */
+class Random_Engine
+{
+
+public:
+
+	typedef uint64_t result_type;
+
+	/**
+		@brief Available engines.
+	 */
+	enum Kind
+	{
+		Xoshiro256ss,  //< xoshiro256** (default)
+		Xoshiro256p,   //< xoshiro256+
+		PCG64,         //< PCG64 (XSL RR 128/64)
+		Splitmix64,    //< SplitMix64
+		Rand_R         //< C library rand_r()
+	};
+
+	/**
+		Construct an engine.
+		@param[in] seed Seed
+		@param[in] kind Engine to use
+	 */
+	explicit Random_Engine( uint64_t seed = 0, Kind kind = Xoshiro256ss )
+	: _kind( kind )
+	{
+		this->seed( seed );
+	}
+
+	/**
+		Restart the engine from a seed.
+		@param[in] seed Seed
+	 */
+	inline void seed( uint64_t seed )
+	{
+		switch( _kind )
+		{
+			case Xoshiro256ss: _xoshiro256ss = Xoshiro256ss_Engine( seed ); break;
+			case Xoshiro256p:  _xoshiro256p  = Xoshiro256p_Engine( seed );  break;
+			case PCG64:        _pcg64        = PCG64_Engine( seed );        break;
+			case Splitmix64:   _splitmix64   = Splitmix64_Engine( seed );   break;
+			case Rand_R:       _rand_r       = Rand_R_Engine( seed );       break;
+		}
+	}
+
+	void jump_streams( uint64_t );
+
+	/**
+		Return the next 64 random bits.
+		@retval bits Random bits
+	 */
+	inline uint64_t operator()( )
+	{
+		switch( _kind )
+		{
+			case Xoshiro256p: return( _xoshiro256p() );
+			case PCG64:       return( _pcg64() );
+			case Splitmix64:  return( _splitmix64() );
+			case Rand_R:      return( _rand_r() );
+			default:          return( _xoshiro256ss() );
+		}
+	}
+
+	/**
+		Return a number uniformly distributed in [0, 1) with 53 random bits.
+		@retval number Number in [0, 1)
+	 */
+	inline double next_double( )
+	{
+		if( _kind == Rand_R )
+		{
+			return( _rand_r.next_double() );
+		}
+		return( to_unit_double( (*this)() ) );
+	}
+
+	/**
+		Return which engine is used.
+		@retval kind Engine
+	 */
+	inline Kind kind( ) const
+	{
+		return( _kind );
+	}
+
+	/// Smallest value returned
+	static constexpr uint64_t min( ) { return( 0 ); }
+
+	/// Largest value returned
+	static constexpr uint64_t max( ) { return( ~uint64_t( 0 ) ); }
+
+private:
+
+	Kind _kind;  //< Engine in use
+
+	// only the engine of the kind in use advances
+	Xoshiro256ss_Engine _xoshiro256ss;  //< xoshiro256** state
+	Xoshiro256p_Engine  _xoshiro256p;   //< xoshiro256+ state
+	PCG64_Engine        _pcg64;         //< PCG64 state
+	Splitmix64_Engine   _splitmix64;    //< SplitMix64 state
+	Rand_R_Engine       _rand_r;        //< rand_r() state
+};
+
+/**
+	@brief Eight xoshiro256** generators advanced together, for filling large
+	arrays of random numbers.
+
+	The lanes are stored so that each state word of all eight lanes is
+	contiguous, which lets one step of every lane be done with 4-lane (AVX2,
+	if the processor has it) or 2-lane (SSE2) vector instructions; the scalar build computes the same
+	steps one lane at a time. Each step writes lane 0's number first, then lane
+	1's, and so on, so the output for a seed is the same with or without
+	vector instructions. Numbers left over from a step are kept for the next
+	call, so filling n numbers and then m gives the same numbers as filling
+	n + m. The lanes are 2^128 steps apart, so they never overlap.
+ */
+class Xoshiro256_Lanes
+{
+
+public:
+
+	/// Number of generators advanced together
+	static const unsigned NUM_LANES = 8;
+
+	/**
+		Seed the generators.
+		@param[in] seed Seed
+		@param[in] stream Stream to use (see seed())
+	 */
+	explicit Xoshiro256_Lanes( uint64_t seed = 0, uint64_t stream = 0 )
+	{
+		this->seed( seed, stream );
+	}
+
+	void seed( uint64_t, uint64_t = 0 );
+
+	void fill( uint64_t*, std::size_t );
+
+	void fill_unit( double*, std::size_t, double = 0, double = 1 );
+
+private:
+
+	void step( uint64_t*, std::size_t );
+
+	alignas(32) uint64_t _s[4][NUM_LANES];     //< State word i of each lane
+	alignas(32) uint64_t _buffer[NUM_LANES];   //< Numbers from the last step
+	unsigned             _next;                //< Next unused number in buffer
+};
+
+/**
+	@brief Engine that returns numbers drawn in blocks from Xoshiro256_Lanes,
+	so that a distribution can be sampled over a whole array without a call
+	per number into the lanes.
+
+	Whatever remains of the last block drawn is discarded with the object, so
+	when the number of values wanted is known, pass it to the constructor:
+	each block is then sized to what is left of it rather than always being
+	full, which keeps filling a few numbers about as cheap as next(). Numbers
+	wanted beyond that (e.g., for rejected samples) are drawn a lane step at
+	a time.
+ */
+class Lane_Bits
+{
+
+public:
+
+	typedef uint64_t result_type;
+
+	/**
+		Read from the given lanes.
+		@param[in,out] lanes Lanes
+		@param[in] size_hint Number of values expected to be drawn (if
+			known)
+	 */
+	explicit Lane_Bits( Xoshiro256_Lanes& lanes,
+			std::size_t size_hint = ~std::size_t( 0 ) )
+	: _lanes( lanes ), _wanted( size_hint ), _size( 0 ), _next( 0 )
+	{ }
+
+	/**
+		Return the next 64 random bits.
+		@retval bits Random bits
+	 */
+	inline uint64_t operator()( )
+	{
+		if( _next == _size )
+		{
+			_size = (_wanted == 0) ? std::size_t( Xoshiro256_Lanes::NUM_LANES )
+				: std::min( _wanted, BLOCK_SIZE );
+			_wanted -= std::min( _wanted, _size );
+			_lanes.fill( _block, _size );
+			_next = 0;
+		}
+		return( _block[_next++] );
+	}
+
+	/// Smallest value returned
+	static constexpr uint64_t min( ) { return( 0 ); }
+
+	/// Largest value returned
+	static constexpr uint64_t max( ) { return( ~uint64_t( 0 ) ); }
+
+private:
+
+	/// Most numbers drawn from the lanes at a time
+	static const std::size_t BLOCK_SIZE = 512;
+
+	Xoshiro256_Lanes& _lanes;              //< Lanes
+	uint64_t          _block[BLOCK_SIZE];  //< Numbers drawn
+	std::size_t       _wanted;             //< Numbers expected but not drawn
+	std::size_t       _size;               //< Numbers in block
+	std::size_t       _next;               //< Next unused number
+};
+
+/**
+	@brief Whether a type is an engine: a class whose operator() returns 64
+	random bits.
+ */
+template<typename T, typename = void>
+struct is_bit_engine : std::false_type
+{ };
+
+template<typename T>
+struct is_bit_engine<T, std::void_t<decltype( std::declval<T&>()() )> >
+: std::is_same<decltype( std::declval<T&>()() ), uint64_t>
+{ };
+
+/**
+	@brief Whether a type has an engine() member, as the generators in
+	Random_Number.hpp and Random_Generator do.
+ */
+template<typename T, typename = void>
+struct has_engine : std::false_type
+{ };
+
+template<typename T>
+struct has_engine<T, std::void_t<decltype( std::declval<T&>().engine() )> >
+: std::is_lvalue_reference<decltype( std::declval<T&>().engine() )>
+{ };
+
+/**
+	Return the source of 64-bit random numbers to draw from: an engine
+	itself, or a generator's engine. Anything else, such as a Random_Number
+	whose operator() gives doubles in [0, 1), is rejected when compiled
+	rather than silently truncated to 0. Every distribution and sampler that
+	takes an engine draws through this.
+	@param[in,out] engine Engine or generator
+	@retval engine Engine
+ */
+template<typename Engine>
+inline auto&
+bit_engine( Engine& engine )
+{
+	if constexpr( is_bit_engine<Engine>::value || !has_engine<Engine>::value )
+	{
+		static_assert( is_bit_engine<Engine>::value,
+				"Engine must return 64-bit random numbers (uint64_t)" );
+		return( engine );
+	}
+	else
+	{
+		return( bit_engine( engine.engine() ) );
+	}
+}
+
+} // namespace ws_tools
+
+#endif // _RANDOM_ENGINE_HPP
@@ -14,3 +14,41 @@
 
 using std::string;
 using std::vector;
+using std::size_t;
+
+using namespace ws_tools;
+
+/**
+	Fill an array with consecutive numbers of a stream, computing the Philox
+	blocks in bulk (see Philox4x32_Engine::blocks()).
+	@param[in] stream Stream
+	@param[in] first Index of the first number in the stream
+	@param[out] out Array
+	@param[in] n Number of elements
+ */
+void
+Counter_Number::fill_at( uint64_t stream, uint64_t first, double* out,
+		size_t n ) const
+{
+	size_t i = 0;
+	if( n != 0 && (first & 1) != 0 )
+	{
+		out[i++] = at( stream, first );
+	}
+
+	// whole blocks, a cache-sized group at a time
+	const size_t group_size = 512;
+	uint64_t bits[2 * group_size];
+	while( n - i >= 2 )
+	{
+		const size_t num_blocks = std::min( group_size, (n - i) / 2 );
+		_philox.blocks( stream, (first + i) >> 1, num_blocks, bits );
+		to_unit_doubles( bits, out + i, 2 * num_blocks, _min, _max - _min );
+		i += 2 * num_blocks;
+	}
+
+	if( i != n )
+	{
+		out[i] = at( stream, first + i );
+	}
+}
@@ -27,18 +27,9 @@
 #include <cmath>
 #include <cstring>
 
-// boost headers
-#define HAVE_BOOST_WS_TOOLS
-#ifdef HAVE_BOOST_WS_TOOLS
-
-#include "boost/random.hpp"
-#include <boost/generator_iterator.hpp>
-#include <boost/random/lagged_fibonacci.hpp>
-#include <boost/random/normal_distribution.hpp>
-
-#endif // HAVE_BOOST_WS_TOOLS
-
 // tools headers
+#include "Random_Distribution.hpp"
+#include "Random_Engine.hpp"
 #include "ws_tools.hpp"
 
 namespace ws_tools
@@ -46,6 +37,10 @@ namespace ws_tools
 
 /**
 	@brief Random_Number Base class for other random number generators.
+
+	Most generators draw their random bits from an Engine_Number's engine.
+	Counter_Number instead computes them from a counter, so that it is cheap
+	to construct one per item.
  */
 class Random_Number
 {
@@ -53,10 +48,9 @@ class Random_Number
 public:
 
 	/**
-		Default constructor.
+		Default constructor does nothing since there are no member variables.
 	 */
    Random_Number( )
-	: _seed( std::time(0) )
 	{ }
 
 	/**
@@ -78,28 +72,393 @@ public:
 	 */
 	virtual double operator()( ) = 0;
 
+	/**
+		Fill an array with random numbers. Derived classes replace this with
+		versions that generate many numbers at once.
+		@param[out] out Array
+		@param[in] n Number of elements
+	 */
+	virtual void fill( double* out, std::size_t n )
+	{
+		for( std::size_t i = 0; i != n; ++i )
+		{
+			out[i] = next();
+		}
+	}
+
+	/**
+		Fill a vector with random numbers.
+		@param[in,out] out Vector whose elements are replaced
+	 */
+	inline void fill( std::vector<double>& out )
+	{
+		fill( out.data(), out.size() );
+	}
+
+	/**
+		Restart the generator from a seed.
+		@param[in] seed Seed
+	 */
+	virtual void seed( uint64_t seed ) = 0;
+
+	/**
+		Restart the generator from a seed at the start of one of its streams.
+		Generators given the same seed and different streams never produce the
+		same sequence of numbers, so each thread or task of a parallel job can
+		be given its own stream.
+		@param[in] seed Seed
+		@param[in] stream Stream
+	 */
+	virtual void seed( uint64_t seed, uint64_t stream ) = 0;
+
+};
+
+/**
+	@brief Engine_Number Base class for generators that draw their random bits
+	from a Random_Engine.
+
+	The engine is xoshiro256** unless another engine is chosen when the
+	generator is constructed, and its bits are passed to a distribution (see
+	Random_Distribution.hpp). Tight loops that do not need to choose a
+	generator at run time can use Random_Generator instead, which avoids the
+	virtual call per number. fill() instead draws from eight xoshiro256**
+	lanes (see Xoshiro256_Lanes) seeded from the same seed, so its numbers are
+	a separate stream from next()'s but are likewise the same in every run for
+	a given seed.
+ */
+class Engine_Number : public Random_Number
+{
+	
+public:
+
+	/**
+		Default constructor that seeds the default engine with random_seed(), so
+		that generators created together still differ.
+	 */
+   Engine_Number( )
+	: Engine_Number( random_seed(), Random_Engine::Xoshiro256ss )
+	{ }
+
+	/**
+		Construct a generator with a given seed and engine.
+		@param[in] seed Seed
+		@param[in] kind Engine to use
+	 */
+   Engine_Number( uint64_t seed, Random_Engine::Kind kind )
+	: _engine( seed, kind ), _lanes( lanes_seed( seed ) )
+	{ }
+
+	/**
+		Destructor does nothing since no member variables are dynamically
+		allocated.
+	 */
+   virtual ~Engine_Number( )
+	{ }
+
+	/**
+		Restart the generator from a seed.
+		@param[in] seed Seed
+	 */
+	virtual void seed( uint64_t seed )
+	{
+		_engine.seed( seed );
+		_lanes.seed( lanes_seed( seed ) );
+	}
+
+	/**
+		Restart the generator from a seed at the start of one of its streams
+		(see Random_Engine::jump_streams()).
+		@param[in] seed Seed
+		@param[in] stream Stream
+	 */
+	virtual void seed( uint64_t seed, uint64_t stream )
+	{
+		_engine.seed( seed );
+		_engine.jump_streams( stream );
+		_lanes.seed( lanes_seed( seed ), stream );
+	}
+
+	/**
+		Return which engine the generator uses.
+		@retval kind Engine
+	 */
+	inline Random_Engine::Kind engine_kind( ) const
+	{
+		return( _engine.kind() );
+	}
+
+	/**
+		Get the engine being used for the generator, which can be passed to
+		the templates that take an engine, e.g., reservoir_sample(). Passing
+		the generator itself does the same.
+		@retval engine Engine
+	 */
+	inline Random_Engine& engine( )
+	{
+		return( _engine );
+	}
+
 protected:
 
+
+	/**
+		Get the lanes used for filling arrays.
+		@retval lanes Lanes
+	 */
+	inline Xoshiro256_Lanes& get_lanes( )
+	{
+		return( _lanes );
+	}
+
+	/**
+		Fill an array with numbers from a distribution using random bits drawn
+		in bulk from the lanes.
+		@param[in] distribution Distribution
+		@param[out] out Array
+		@param[in] n Number of elements
+	 */
+	template<typename Distribution>
+	void fill_lanes( const Distribution& distribution, double* out,
+			std::size_t n )
+	{
+		Lane_Bits bits( _lanes, n );
+		for( std::size_t i = 0; i != n; ++i )
+		{
+			out[i] = distribution( bits );
+		}
+	}
+
+private:
+
+	/**
+		Return the seed of the lanes, which differs from the engine's so that
+		lane 0 does not repeat an xoshiro256** engine's numbers.
+		@param[in] seed Seed of the generator
+		@retval lanes_seed Seed of the lanes
+	 */
+	static inline uint64_t lanes_seed( uint64_t seed )
+	{
+		return( seed ^ 0x6A09E667F3BCC909ULL );
+	}
+
+	/// Source of random bits
+	Random_Engine _engine;
+
+	/// Source of random bits for fill()
+	Xoshiro256_Lanes _lanes;
+
+};
+
+/**
+	@brief Counter_Number Uniformly distributed random numbers from the
+	counter-based Philox4x32-10 generator, where number k of stream i can be
+	computed directly with at( i, k ).
+
+	Streams are meant to be indexed by item or task, so work can be split
+	across threads in any order and still give the same numbers for each item:
+	the generator is only read by at() and fill_at(), which can be called from
+	several threads at once. next() and fill() instead read one stream in
+	order, starting at seek()'s position.
+ */
+class Counter_Number : public Random_Number
+{
+	
+public:
+
+	/**
+		Construct a generator.
+		@param[in] key Key (the seed)
+		@param[in] min Minimum value in the distribution's range
+		@param[in] max Maximum value in the distribution's range
+	 */
+   Counter_Number( uint64_t key = random_seed(), double min = 0.0,
+		double max = 1.0 )
+	: _philox( key ), _min( min ), _max( max )
+	{
+		if( _min >= _max )
+		{
+			err_quit( "Counter_Number: min (%lf) >= max (%lf)\n", _min, _max );
+		}
+	}
+
+	/**
+		Destructor does nothing since no member variables are dynamically
+		allocated.
+	 */
+   virtual ~Counter_Number( )
+	{ }
+
+	/**
+		Return the next uniformly distributed random number of the current
+		stream in the range [min, max).
+		@retval number Next random number
+	 */
+	virtual inline double next( )
+	{
+		return( _min + (_max - _min) * to_unit_double( _philox() ) );
+	}
+
+	/**
+		Return the next uniformly distributed random number of the current
+		stream in the range [min, max).
+		@retval number Next random number
+	 */
+	virtual inline double operator()( )
+	{
+		return( next() );
+	}
+
+	/**
+		Return a number of a stream.
+		@param[in] stream Stream
+		@param[in] index Index of the number in the stream
+		@retval number Random number in [min, max)
+	 */
+	inline double at( uint64_t stream, uint64_t index ) const
+	{
+		uint64_t block[2];
+		_philox.block( stream, index >> 1, block );
+		return( _min + (_max - _min) * to_unit_double( block[index & 1] ) );
+	}
+
+	void fill_at( uint64_t, uint64_t, double*, std::size_t ) const;
+
+	using Random_Number::fill;
+
+	/**
+		Fill an array with the next numbers of the current stream.
+		@param[out] out Array
+		@param[in] n Number of elements
+	 */
+	virtual void fill( double* out, std::size_t n )
+	{
+		fill_at( _philox.stream(), _philox.position(), out, n );
+		_philox.seek( _philox.stream(), _philox.position() + n );
+	}
+
+	/**
+		Move to a number of a stream for next() and fill().
+		@param[in] stream Stream
+		@param[in] index Index of the next number
+	 */
+	inline void seek( uint64_t stream, uint64_t index )
+	{
+		_philox.seek( stream, index );
+	}
+
 	/**
-		Get the pointer to the seed being used for the generator.
-		@retval seed_pointer Pointer to the seed
+		Restart the generator with a new key at the start of stream 0.
+		@param[in] key Key
 	 */
-	inline unsigned* get_seed( )
+	virtual void seed( uint64_t key )
 	{
-		return( &_seed );
+		_philox = Philox4x32_Engine( key );
+	}
+
+	/**
+		Get the engine, whose numbers are those of next() before scaling.
+		@retval engine Engine
+	 */
+	inline Philox4x32_Engine& engine( )
+	{
+		return( _philox );
+	}
+
+	/**
+		Restart the generator with a new key at the start of a stream.
+		@param[in] key Key
+		@param[in] stream Stream
+	 */
+	virtual void seed( uint64_t key, uint64_t stream )
+	{
+		_philox = Philox4x32_Engine( key, stream );
 	}
 
 private:
 
-	/// Seed for random number generator
-	unsigned _seed;
+	Philox4x32_Engine _philox;  //< Counter-based generator
+	double            _min;     //< Minimum value in the distribution's range
+	double            _max;     //< Maximum value in the distribution's range
+
+};
+
+/**
+	@brief Hands out non-overlapping random number streams derived from one
+	master seed, so that each thread or task of a parallel job gets its own
+	generator and the job's results are reproducible from the master seed
+	alone, regardless of how the work is scheduled.
+
+	A generator is not safe to share between threads, but a splitter is: its
+	methods are const, and stream k is the same no matter which thread asks
+	for it or when.
+
+	Example:
+		Stream_Splitter streams( master_seed );
+		parallel_for( num_tasks, 0, [&]( std::size_t task )
+			{
+				Normal_Number noise;
+				streams.seed( noise, task );
+				...
+			} );
+ */
+class Stream_Splitter
+{
+
+public:
+
+	/**
+		Construct a splitter.
+		@param[in] seed Master seed (a different one each time by default)
+		@param[in] kind Engine of the streams returned by engine()
+	 */
+	explicit Stream_Splitter( uint64_t seed = random_seed(),
+			Random_Engine::Kind kind = Random_Engine::Xoshiro256ss )
+	: _seed( seed ), _kind( kind )
+	{ }
+
+	/**
+		Return an engine at the start of a stream.
+		@param[in] stream Stream
+		@retval engine Engine
+	 */
+	inline Random_Engine engine( uint64_t stream ) const
+	{
+		Random_Engine engine( _seed, _kind );
+		engine.jump_streams( stream );
+		return( engine );
+	}
+
+	/**
+		Restart a generator at the start of a stream. The generator keeps its
+		own engine kind.
+		@param[in,out] generator Generator
+		@param[in] stream Stream
+	 */
+	inline void seed( Random_Number& generator, uint64_t stream ) const
+	{
+		generator.seed( _seed, stream );
+	}
+
+	/**
+		Return the master seed, which can be recorded to reproduce a job.
+		@retval seed Master seed
+	 */
+	inline uint64_t seed( ) const
+	{
+		return( _seed );
+	}
+
+private:
+
+	uint64_t            _seed;  //< Master seed
+	Random_Engine::Kind _kind;  //< Engine of the streams
 
 };
 
 /**
 	@brief Uniform_Number
  */
-class Uniform_Number : public Random_Number
+class Uniform_Number : public Engine_Number
 {
 	
 public:
@@ -109,7 +468,25 @@ public:
 		Default constructor that seeds the number generator with the current time.
 	 */
    Uniform_Number( double min = 0.0, double max = 1.0 )
-	: Random_Number(), _min(min), _max(max)
+	: Engine_Number(), _min(min), _max(max)
+	{
+		if( _min >= _max )
+		{
+			err_quit( "Uniform_Number: min (%lf) >= max (%lf)\n",
+					_min, _max );
+		}
+	}
+
+	/**
+		Construct a generator with a given seed and engine.
+		@param[in] min Minimum value in the distribution's range
+		@param[in] max Maximum value in the distribution's range
+		@param[in] seed Seed
+		@param[in] kind Engine to use
+	 */
+   Uniform_Number( double min, double max, uint64_t seed,
+		Random_Engine::Kind kind = Random_Engine::Xoshiro256ss )
+	: Engine_Number( seed, kind ), _min(min), _max(max)
 	{
 		if( _min >= _max )
 		{
@@ -132,8 +509,7 @@ public:
 	 */
 	virtual inline double next( )
 	{
-		return( min()
-				+ (max() - min()) * (rand_r( get_seed() ) / (RAND_MAX + 1.0)) );
+		return( Uniform_Distribution( _min, _max )( engine() ) );
 	}
 
 	/**
@@ -145,6 +521,18 @@ public:
 		return( next() );
 	}
 
+	using Random_Number::fill;
+
+	/**
+		Fill an array with uniformly distributed random numbers in [min, max).
+		@param[out] out Array
+		@param[in] n Number of elements
+	 */
+	virtual void fill( double* out, std::size_t n )
+	{
+		get_lanes().fill_unit( out, n, min(), max() );
+	}
+
 	/**
 		Set new range for the distribution.
 		@param[in] new_min New minimum value in the distribution's range
@@ -204,43 +592,35 @@ public:
 
 };
 
-#ifdef HAVE_BOOST_WS_TOOLS
-
 /**
 	@brief Normal_Number
  */
-class Normal_Number : public Random_Number
+class Normal_Number : public Engine_Number
 {
-
-	// define a random number generator type
-	// also, try boost::mt19937 or boost::ecuyer1988 instead of
-	// boost::minstd_rand
-	typedef boost::minstd_rand base_generator_type;
-
-	// define a probability distribution type
-	typedef boost::normal_distribution<>  distribution_type;
 	
 public:
 
 	/**
 		Construct a normally distributed random number generator with the given
 		mean and standard deviation.
-
-		Define a random number generator and initialize it with a repeatable
-		seed. (The seed is unsigned; otherwise, the wrong overload may be
-		selected when using mt19937 as the base_generator_type.)
-			base_generator_type generator( _seed );
-
-		Uniform distribution for the real range [0,1) (used by the normal dist.):
-			boost::uniform_01<base_generator_type>  uni_01 ( generator );
-
-		Create normal distribution (Gaussian) with the given mean and std. dev.:
-			dist = boost::normal_distribution<>( mean, std_dev ) ;
+		@param[in] mean Mean
+		@param[in] std_dev Standard deviation
 	 */
    Normal_Number( double mean = 0, double std_dev = 1 )
-	: Random_Number(),
-		uni_01( base_generator_type( *Random_Number::get_seed() ) ),
-		dist( mean, std_dev )
+	: Engine_Number(), _distribution( mean, std_dev )
+	{ }
+
+	/**
+		Construct a normally distributed random number generator with a given
+		seed and engine.
+		@param[in] mean Mean
+		@param[in] std_dev Standard deviation
+		@param[in] seed Seed
+		@param[in] kind Engine to use
+	 */
+   Normal_Number( double mean, double std_dev, uint64_t seed,
+		Random_Engine::Kind kind = Random_Engine::Xoshiro256ss )
+	: Engine_Number( seed, kind ), _distribution( mean, std_dev )
 	{ }
 
 	/**
@@ -256,7 +636,7 @@ public:
 	 */
 	virtual inline double next( )
 	{
-		return( dist(uni_01) );
+		return( _distribution( engine() ) );
 	}
 
 	/**
@@ -268,56 +648,262 @@ public:
 		return( next() );
 	}
 
+	using Random_Number::fill;
+
+	/**
+		Fill an array with normally distributed random numbers.
+		@param[out] out Array
+		@param[in] n Number of elements
+	 */
+	virtual void fill( double* out, std::size_t n )
+	{
+		ziggurat_fill_normal( get_lanes(), out, n, mean(), std_dev() );
+	}
+
+	/**
+		Return the mean.
+		@retval mean Mean
+	 */
+	inline double mean( ) const
+	{
+		return( _distribution.mean() );
+	}
+
+	/**
+		Return the standard deviation.
+		@retval std_dev Standard deviation
+	 */
+	inline double std_dev( ) const
+	{
+		return( _distribution.std_dev() );
+	}
+
 private:
 
-	boost::uniform_01<base_generator_type>  uni_01;
-	distribution_type                       dist;
+	Normal_Distribution _distribution;  //< Distribution of the numbers
 
 };
 
-#else  // boost::random is not installed
+/**
+	@brief Exponential_Number
+ */
+class Exponential_Number : public Engine_Number
+{
+	
+public:
+
+	/**
+		Construct an exponentially distributed random number generator with the
+		given rate (the reciprocal of the mean).
+		@param[in] rate Rate
+	 */
+   Exponential_Number( double rate = 1 )
+	: Engine_Number(), _distribution( rate )
+	{ }
+
+	/**
+		Construct an exponentially distributed random number generator with a
+		given seed and engine.
+		@param[in] rate Rate
+		@param[in] seed Seed
+		@param[in] kind Engine to use
+	 */
+   Exponential_Number( double rate, uint64_t seed,
+		Random_Engine::Kind kind = Random_Engine::Xoshiro256ss )
+	: Engine_Number( seed, kind ), _distribution( rate )
+	{ }
+
+	/**
+		Destructor does nothing since no member variables are dynamically
+		allocated.
+	 */
+   virtual ~Exponential_Number( )
+	{ }
+
+	/**
+		Return an exponentially distributed random number.
+		@retval number Next random number
+	 */
+	virtual inline double next( )
+	{
+		return( _distribution( engine() ) );
+	}
+
+	/**
+		Return an exponentially distributed random number.
+		@retval number Next random number
+	 */
+	virtual inline double operator()( )
+	{
+		return( next() );
+	}
+
+	using Random_Number::fill;
+
+	/**
+		Fill an array with exponentially distributed random numbers.
+		@param[out] out Array
+		@param[in] n Number of elements
+	 */
+	virtual void fill( double* out, std::size_t n )
+	{
+		ziggurat_fill_exponential( get_lanes(), out, n, 1 / rate() );
+	}
+
+	/**
+		Return the rate.
+		@retval rate Rate
+	 */
+	inline double rate( ) const
+	{
+		return( _distribution.rate() );
+	}
+
+private:
+
+	Exponential_Distribution _distribution;  //< Distribution of the numbers
+
+};
 
 /**
-	@brief Normal_Number
+	@brief Gamma_Number
  */
-class Normal_Number : public Random_Number
+class Gamma_Number : public Engine_Number
 {
 	
 public:
 
 	/**
-		Construct a normally distributed random number generator with the given
-		mean and standard deviation.
+		Construct a gamma distributed random number generator with the given
+		shape and scale.
+		@param[in] shape Shape
+		@param[in] scale Scale (the reciprocal of the rate)
 	 */
-   Normal_Number( double mean = 0, double std_dev = 1 )
-	: Random_Number()
+   Gamma_Number( double shape = 1, double scale = 1 )
+	: Engine_Number(), _distribution( shape, scale )
+	{ }
+
+	/**
+		Construct a gamma distributed random number generator with a given
+		seed and engine.
+		@param[in] shape Shape
+		@param[in] scale Scale (the reciprocal of the rate)
+		@param[in] seed Seed
+		@param[in] kind Engine to use
+	 */
+   Gamma_Number( double shape, double scale, uint64_t seed,
+		Random_Engine::Kind kind = Random_Engine::Xoshiro256ss )
+	: Engine_Number( seed, kind ), _distribution( shape, scale )
+	{ }
+
+	/**
+		Destructor does nothing since no member variables are dynamically
+		allocated.
+	 */
+   virtual ~Gamma_Number( )
+	{ }
+
+	/**
+		Return a gamma distributed random number.
+		@retval number Next random number
+	 */
+	virtual inline double next( )
 	{
-		err_warn( "Normal_Number::Normal_Number: "
-				" Unable to create normally distributed random number object: "
-				" Boost (http://www.boost.org/) is not installed.\n" );
+		return( _distribution( engine() ) );
 	}
 
+	/**
+		Return a gamma distributed random number.
+		@retval number Next random number
+	 */
+	virtual inline double operator()( )
+	{
+		return( next() );
+	}
+
+	using Random_Number::fill;
+
+	/**
+		Fill an array with gamma distributed random numbers.
+		@param[out] out Array
+		@param[in] n Number of elements
+	 */
+	virtual void fill( double* out, std::size_t n )
+	{
+		fill_lanes( _distribution, out, n );
+	}
+
+	/**
+		Return the shape.
+		@retval shape Shape
+	 */
+	inline double shape( ) const
+	{
+		return( _distribution.shape() );
+	}
+
+	/**
+		Return the scale.
+		@retval scale Scale
+	 */
+	inline double scale( ) const
+	{
+		return( _distribution.scale() );
+	}
+
+private:
+
+	Gamma_Distribution _distribution;  //< Distribution of the numbers
+
+};
+
+/**
+	@brief Poisson_Number
+ */
+class Poisson_Number : public Engine_Number
+{
+	
+public:
+
+	/**
+		Construct a Poisson distributed random number generator with the given
+		mean.
+		@param[in] mean Mean
+	 */
+   Poisson_Number( double mean = 1 )
+	: Engine_Number(), _distribution( mean )
+	{ }
+
+	/**
+		Construct a Poisson distributed random number generator with a given
+		seed and engine.
+		@param[in] mean Mean
+		@param[in] seed Seed
+		@param[in] kind Engine to use
+	 */
+   Poisson_Number( double mean, uint64_t seed,
+		Random_Engine::Kind kind = Random_Engine::Xoshiro256ss )
+	: Engine_Number( seed, kind ), _distribution( mean )
+	{ }
+
 	/**
 		Destructor does nothing since no member variables are dynamically
 		allocated.
 	 */
-   virtual ~Normal_Number( )
+   virtual ~Poisson_Number( )
 	{ }
 
 	/**
-		Return a normally distributed random number.
+		Return a Poisson distributed random number.
 		@retval number Next random number
 	 */
 	virtual inline double next( )
 	{
-		err_warn( "Normal_Number::next: "
-				" Unable to generate normally distributed random number: "
-				" Boost (http://www.boost.org/) is not installed.\n" );
-		return( 0.0 );
+		return( double( _distribution( engine() ) ) );
 	}
 
 	/**
-		Return a normally distributed random number.
+		Return a Poisson distributed random number.
 		@retval number Next random number
 	 */
 	virtual inline double operator()( )
@@ -325,9 +911,124 @@ public:
 		return( next() );
 	}
 
+	using Random_Number::fill;
+
+	/**
+		Fill an array with Poisson distributed random numbers.
+		@param[out] out Array
+		@param[in] n Number of elements
+	 */
+	virtual void fill( double* out, std::size_t n )
+	{
+		fill_lanes( _distribution, out, n );
+	}
+
+	/**
+		Return the mean.
+		@retval mean Mean
+	 */
+	inline double mean( ) const
+	{
+		return( _distribution.mean() );
+	}
+
+private:
+
+	Poisson_Distribution _distribution;  //< Distribution of the numbers
+
 };
 
-#endif // HAVE_BOOST_WS_TOOLS
+/**
+	@brief Binomial_Number
+ */
+class Binomial_Number : public Engine_Number
+{
+	
+public:
+
+	/**
+		Construct a binomially distributed random number generator with the
+		given number of trials and probability of success.
+		@param[in] trials Number of trials
+		@param[in] p Probability of success of each trial
+	 */
+   Binomial_Number( uint64_t trials = 1, double p = 0.5 )
+	: Engine_Number(), _distribution( trials, p )
+	{ }
+
+	/**
+		Construct a binomially distributed random number generator with a given
+		seed and engine.
+		@param[in] trials Number of trials
+		@param[in] p Probability of success of each trial
+		@param[in] seed Seed
+		@param[in] kind Engine to use
+	 */
+   Binomial_Number( uint64_t trials, double p, uint64_t seed,
+		Random_Engine::Kind kind = Random_Engine::Xoshiro256ss )
+	: Engine_Number( seed, kind ), _distribution( trials, p )
+	{ }
+
+	/**
+		Destructor does nothing since no member variables are dynamically
+		allocated.
+	 */
+   virtual ~Binomial_Number( )
+	{ }
+
+	/**
+		Return a binomially distributed random number.
+		@retval number Next random number
+	 */
+	virtual inline double next( )
+	{
+		return( double( _distribution( engine() ) ) );
+	}
+
+	/**
+		Return a binomially distributed random number.
+		@retval number Next random number
+	 */
+	virtual inline double operator()( )
+	{
+		return( next() );
+	}
+
+	using Random_Number::fill;
+
+	/**
+		Fill an array with binomially distributed random numbers.
+		@param[out] out Array
+		@param[in] n Number of elements
+	 */
+	virtual void fill( double* out, std::size_t n )
+	{
+		fill_lanes( _distribution, out, n );
+	}
+
+	/**
+		Return the number of trials.
+		@retval trials Number of trials
+	 */
+	inline uint64_t trials( ) const
+	{
+		return( _distribution.trials() );
+	}
+
+	/**
+		Return the probability of success of each trial.
+		@retval p Probability of success of each trial
+	 */
+	inline double p( ) const
+	{
+		return( _distribution.p() );
+	}
+
+private:
+
+	Binomial_Distribution _distribution;  //< Distribution of the numbers
+
+};
 
 } // namespace ws_tools
 
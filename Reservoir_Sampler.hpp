@@ -0,0 +1,492 @@
+/**
+	@file   Reservoir_Sampler.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Random samples of streams in one pass with O(k) memory.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _RESERVOIR_SAMPLER_HPP
+#define _RESERVOIR_SAMPLER_HPP
+
+// c++ headers
+#include <algorithm>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// c headers
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// tools headers
+#include "Dir_Walker.hpp"
+#include "Random_Distribution.hpp"
+#include "Random_Engine.hpp"
+#include "err_mesg.h"
+
+namespace ws_tools
+{
+
+/**
+	Return the logarithm of a uniform random number in (0, 1].
+	@param[in,out] engine Source of 64-bit random numbers (or a generator,
+		whose engine is used)
+	@retval log_u Logarithm (at most 0)
+ */
+template<typename Engine>
+inline double
+log_unit( Engine& engine )
+{
+	return( std::log( 1 - to_unit_double( bit_engine( engine )() ) ) );
+}
+
+/**
+	@brief Uniform random sample of k items of a stream of unknown length,
+	chosen with Li's Algorithm L.
+
+	After the first k items fill the reservoir, the number of items to skip
+	before the next one that replaces a random item of the reservoir is drawn
+	from its geometric distribution. Sampling n items therefore takes about
+	k (1 + log(n / k)) random numbers rather than one per item, and items that
+	will be skipped need not even be read: num_to_skip() tells the caller how
+	many can be passed over with skip().
+
+	Every subset of k items is equally likely, but the reservoir is not in a
+	random order; shuffle() it if one is needed.
+
+	Example:
+		Reservoir_Sampler<std::string> sampler( 10 );
+		while( ... )
+		{
+			if( sampler.num_to_skip() != 0 )
+			{
+				// pass over the next item without reading it
+				sampler.skip( 1 );
+			}
+			else
+			{
+				sampler.add( read_item(), engine );
+			}
+		}
+		const std::vector<std::string>& items = sampler.sample();
+ */
+template<typename T>
+class Reservoir_Sampler
+{
+
+public:
+
+	/**
+		Construct a sampler.
+		@param[in] k Number of items to sample
+	 */
+	explicit Reservoir_Sampler( std::size_t k )
+	: _k( k ), _count( 0 ), _next( 0 ), _log_w( 0 )
+	{
+		_sample.reserve( k );
+		if( _k == 0 )
+		{
+			_next = ~uint64_t( 0 );
+		}
+	}
+
+	/**
+		Destructor does nothing since no member variables are dynamically
+		allocated.
+	 */
+	virtual ~Reservoir_Sampler( )
+	{ }
+
+	/**
+		Offer the next item of the stream.
+		@param[in] item Item
+		@param[in,out] engine Source of 64-bit random numbers (or a generator,
+		whose engine is used)
+		@retval taken Whether the item was put in the reservoir
+	 */
+	template<typename Engine>
+	bool add( const T& item, Engine& engine )
+	{
+		static_assert( is_bit_engine<
+				std::remove_reference_t<decltype( bit_engine( engine ) )> >::value,
+				"Reservoir_Sampler: Engine must return uint64_t" );
+		const uint64_t index = _count++;
+		if( index != _next )
+		{
+			return( false );
+		}
+		if( index < _k )
+		{
+			_sample.push_back( item );
+			if( _count != _k )
+			{
+				++_next;
+				return( true );
+			}
+		}
+		else
+		{
+			_sample[random_below( engine, _k )] = item;
+		}
+
+		// W, the largest of k uniform numbers' k-th roots, shrinks each time
+		_log_w += log_unit( engine ) / _k;
+		const double gap
+			= std::floor( log_unit( engine ) / std::log1p( -std::exp( _log_w ) ) );
+		_next = gap < double( ~uint64_t( 0 ) - index - 1 )
+			? index + 1 + uint64_t( gap ) : ~uint64_t( 0 );
+		return( true );
+	}
+
+	/**
+		Return the number of upcoming items that will not be taken.
+		@retval num_items Number of items
+	 */
+	inline uint64_t num_to_skip( ) const
+	{
+		return( _next - _count );
+	}
+
+	/**
+		Pass over items without offering them.
+		@param[in] num_items Number of items (at most num_to_skip())
+	 */
+	inline void skip( uint64_t num_items )
+	{
+		if( num_items > num_to_skip() )
+		{
+			err_quit( "Reservoir_Sampler::skip: %lu items is past the next"
+					" item to take\n", (unsigned long) num_items );
+		}
+		_count += num_items;
+	}
+
+	/**
+		Return the number of items offered or skipped so far.
+		@retval count Number of items
+	 */
+	inline uint64_t count( ) const
+	{
+		return( _count );
+	}
+
+	/**
+		Return the sampled items, of which there are fewer than k only if the
+		stream had fewer items.
+		@retval sample Sampled items
+	 */
+	inline const std::vector<T>& sample( ) const
+	{
+		return( _sample );
+	}
+
+private:
+
+	std::size_t    _k;       //< Number of items to sample
+	uint64_t       _count;   //< Number of items seen
+	uint64_t       _next;    //< Index of the next item to take
+	double         _log_w;   //< log(W) of Algorithm L
+	std::vector<T> _sample;  //< Reservoir
+};
+
+/**
+	@brief Weighted random sample of k items of a stream without replacement,
+	chosen with Efraimidis and Spirakis' Algorithm A-ExpJ.
+
+	Each item conceptually gets the key u^(1 / weight) for a uniform u, and
+	the reservoir keeps the k largest keys. Rather than drawing a key for
+	every item, the total weight to skip before the next item that enters the
+	reservoir is drawn from its exponential distribution, so only
+	O(k log(n / k)) random numbers are needed.
+
+	Items with weight 0 are never taken. As with Reservoir_Sampler, the
+	reservoir is not in a random order.
+ */
+template<typename T>
+class Weighted_Reservoir_Sampler
+{
+
+public:
+
+	/**
+		Construct a sampler.
+		@param[in] k Number of items to sample
+	 */
+	explicit Weighted_Reservoir_Sampler( std::size_t k )
+	: _k( k ), _skip_weight( 0 )
+	{
+		_sample.reserve( k );
+		_keys.reserve( k );
+	}
+
+	/**
+		Destructor does nothing since no member variables are dynamically
+		allocated.
+	 */
+	virtual ~Weighted_Reservoir_Sampler( )
+	{ }
+
+	/**
+		Offer the next item of the stream.
+		@param[in] item Item
+		@param[in] weight Nonnegative weight of the item
+		@param[in,out] engine Source of 64-bit random numbers (or a generator,
+		whose engine is used)
+		@retval taken Whether the item was put in the reservoir
+	 */
+	template<typename Engine>
+	bool add( const T& item, double weight, Engine& engine )
+	{
+		static_assert( is_bit_engine<
+				std::remove_reference_t<decltype( bit_engine( engine ) )> >::value,
+				"Weighted_Reservoir_Sampler: Engine must return uint64_t" );
+		if( !(weight > 0) )
+		{
+			if( !(weight == 0) )
+			{
+				err_quit( "Weighted_Reservoir_Sampler::add: weight (%lf) < 0\n",
+						weight );
+			}
+			return( false );
+		}
+		if( _sample.size() < _k )
+		{
+			_keys.push_back( Key( log_unit( engine ) / weight, _sample.size() ) );
+			std::push_heap( _keys.begin(), _keys.end(), Key::greater );
+			_sample.push_back( item );
+			if( _sample.size() == _k )
+			{
+				draw_skip( engine );
+			}
+			return( true );
+		}
+
+		_skip_weight -= weight;
+		if( _skip_weight > 0 || _k == 0 )
+		{
+			return( false );
+		}
+
+		// the item's key is above the smallest key T_w: draw it from
+		// [T_w^weight, 1) and replace the item with the smallest key
+		const double t = std::exp( weight * _keys.front().log_key );
+		const double u = t + (1 - t) * to_unit_double( bit_engine( engine )() );
+		std::pop_heap( _keys.begin(), _keys.end(), Key::greater );
+		_keys.back().log_key = std::log( u ) / weight;
+		_sample[_keys.back().index] = item;
+		std::push_heap( _keys.begin(), _keys.end(), Key::greater );
+		draw_skip( engine );
+		return( true );
+	}
+
+	/**
+		Return the sampled items, of which there are fewer than k only if the
+		stream had fewer items with positive weight.
+		@retval sample Sampled items
+	 */
+	inline const std::vector<T>& sample( ) const
+	{
+		return( _sample );
+	}
+
+private:
+
+	/// Key of an item in the reservoir
+	struct Key
+	{
+		Key( double l, std::size_t i )
+		: log_key( l ), index( i )
+		{ }
+
+		/// Order for a heap whose front is the smallest key
+		static bool greater( const Key& a, const Key& b )
+		{
+			return( a.log_key > b.log_key );
+		}
+
+		double      log_key;  //< log(u) / weight
+		std::size_t index;    //< Position of the item in the reservoir
+	};
+
+	/**
+		Draw the weight to skip before the next item enters the reservoir.
+		@param[in,out] engine Source of 64-bit random numbers (or a generator,
+		whose engine is used)
+	 */
+	template<typename Engine>
+	void draw_skip( Engine& engine )
+	{
+		_skip_weight = log_unit( engine ) / _keys.front().log_key;
+	}
+
+	std::size_t      _k;            //< Number of items to sample
+	double           _skip_weight;  //< Weight left to skip
+	std::vector<Key> _keys;         //< Heap of keys, smallest first
+	std::vector<T>   _sample;       //< Reservoir
+};
+
+/**
+	Advance an input iterator by up to n positions without passing the end.
+	@param[in,out] first Iterator
+	@param[in] last End of the sequence
+	@param[in] n Number of positions
+	@retval num_advanced Number of positions advanced
+ */
+template<typename Iterator>
+uint64_t
+advance_at_most( Iterator& first, Iterator last, uint64_t n,
+		std::input_iterator_tag )
+{
+	uint64_t num_advanced = 0;
+	for( ; num_advanced != n && first != last; ++num_advanced )
+	{
+		++first;
+	}
+	return( num_advanced );
+}
+
+/**
+	Advance a random-access iterator by up to n positions in constant time.
+	@param[in,out] first Iterator
+	@param[in] last End of the sequence
+	@param[in] n Number of positions
+	@retval num_advanced Number of positions advanced
+ */
+template<typename Iterator>
+uint64_t
+advance_at_most( Iterator& first, Iterator last, uint64_t n,
+		std::random_access_iterator_tag )
+{
+	const uint64_t num_advanced = std::min( n, uint64_t( last - first ) );
+	first += num_advanced;
+	return( num_advanced );
+}
+
+/**
+	Choose k items of a sequence uniformly at random with Algorithm L. Items
+	that are skipped are not dereferenced, and random-access iterators jump
+	over them in constant time.
+	@param[in] first Start of the sequence
+	@param[in] last End of the sequence
+	@param[in] k Number of items to sample
+	@param[in,out] engine Source of 64-bit random numbers (or a generator,
+		whose engine is used)
+	@retval sample Sampled items
+ */
+template<typename Iterator, typename Engine>
+std::vector<typename std::iterator_traits<Iterator>::value_type>
+reservoir_sample( Iterator first, Iterator last, std::size_t k, Engine& engine )
+{
+	typedef typename std::iterator_traits<Iterator>::value_type value_type;
+	Reservoir_Sampler<value_type> sampler( k );
+	while( first != last )
+	{
+		const uint64_t num_to_skip = sampler.num_to_skip();
+		if( num_to_skip == 0 )
+		{
+			sampler.add( *first, engine );
+			++first;
+			continue;
+		}
+		sampler.skip( advance_at_most( first, last, num_to_skip,
+				typename std::iterator_traits<Iterator>::iterator_category() ) );
+	}
+	return( sampler.sample() );
+}
+
+/**
+	Choose k items of a sequence without replacement, each with probability
+	proportional to its weight, using Algorithm A-ExpJ.
+	@param[in] first Start of the sequence
+	@param[in] last End of the sequence
+	@param[in] k Number of items to sample
+	@param[in] weight Function returning the nonnegative weight of an item
+	@param[in,out] engine Source of 64-bit random numbers (or a generator,
+		whose engine is used)
+	@retval sample Sampled items
+ */
+template<typename Iterator, typename Weight, typename Engine>
+std::vector<typename std::iterator_traits<Iterator>::value_type>
+weighted_reservoir_sample( Iterator first, Iterator last, std::size_t k,
+		Weight weight, Engine& engine )
+{
+	typedef typename std::iterator_traits<Iterator>::value_type value_type;
+	Weighted_Reservoir_Sampler<value_type> sampler( k );
+	for( ; first != last; ++first )
+	{
+		sampler.add( *first, weight( *first ), engine );
+	}
+	return( sampler.sample() );
+}
+
+/**
+	Choose k lines of a stream uniformly at random in one pass. Lines that are
+	skipped are passed over without being copied.
+	@param[in,out] in Stream of lines
+	@param[in] k Number of lines to sample
+	@param[in,out] engine Source of 64-bit random numbers (or a generator,
+		whose engine is used)
+	@retval lines Sampled lines (without newlines)
+ */
+template<typename Engine>
+std::vector<std::string>
+sample_lines( std::istream& in, std::size_t k, Engine& engine )
+{
+	Reservoir_Sampler<std::string> sampler( k );
+	std::string line;
+	while( in.peek() != EOF )
+	{
+		if( sampler.num_to_skip() != 0 )
+		{
+			in.ignore( std::numeric_limits<std::streamsize>::max(), '\n' );
+			sampler.skip( 1 );
+		}
+		else if( std::getline( in, line ) )
+		{
+			sampler.add( line, engine );
+		}
+	}
+	return( sampler.sample() );
+}
+
+/**
+	Choose k files found by a Dir_Walker uniformly at random in one pass,
+	without keeping the list of every file.
+	@param[in,out] walker Walker that has not returned any files yet
+	@param[in] k Number of files to sample
+	@param[in,out] engine Source of 64-bit random numbers (or a generator,
+		whose engine is used)
+	@retval files Sampled file names
+ */
+template<typename Engine>
+std::vector<std::string>
+sample_files( Dir_Walker& walker, std::size_t k, Engine& engine )
+{
+	Reservoir_Sampler<std::string> sampler( k );
+	std::string file_name;
+	while( walker.next( file_name ) )
+	{
+		if( sampler.num_to_skip() != 0 )
+		{
+			sampler.skip( 1 );
+		}
+		else
+		{
+			sampler.add( file_name, engine );
+		}
+	}
+	return( sampler.sample() );
+}
+
+} // namespace ws_tools
+
+#endif // _RESERVOIR_SAMPLER_HPP
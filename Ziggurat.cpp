@@ -0,0 +1,303 @@
+/**
+	@file   Ziggurat.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Ziggurat samplers for the normal and exponential distributions.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#include "Ziggurat.hpp"
+
+// c++ headers
+#include <algorithm>
+
+// tools headers
+#include "cpu_features.hpp"
+
+namespace ws_tools
+{
+
+/**
+	Build the layers of a ziggurat from the base upward: each layer's right
+	edge is where the density equals the top of the layer below it, which is
+	the lower layer's density plus the area divided by its width.
+	@param[in] r Start of the tail
+	@param[in] area Area of each layer
+	@param[in] f Density (unnormalized)
+	@param[in] f_inverse Inverse of density
+	@retval table Layers
+ */
+static Ziggurat_Table
+build_ziggurat( double r, double area, double (*f)( double ),
+		double (*f_inverse)( double ) )
+{
+	const unsigned n = Ziggurat_Table::NUM_LAYERS;
+	Ziggurat_Table table;
+	table.r    = r;
+	table.x[0] = area / f( r );
+	table.x[1] = r;
+	for( unsigned i = 2; i != n; ++i )
+	{
+		table.x[i] = f_inverse( area / table.x[i - 1] + f( table.x[i - 1] ) );
+	}
+	table.x[n] = 0;
+	for( unsigned i = 0; i <= n; ++i )
+	{
+		table.f[i] = f( table.x[i] );
+	}
+	return( table );
+}
+
+/// Unnormalized normal density
+static double
+normal_density( double x )
+{
+	return( std::exp( -0.5 * x * x ) );
+}
+
+/// Inverse of normal_density()
+static double
+normal_inverse( double y )
+{
+	return( std::sqrt( -2 * std::log( y ) ) );
+}
+
+/// Exponential density
+static double
+exponential_density( double x )
+{
+	return( std::exp( -x ) );
+}
+
+/// Inverse of exponential_density()
+static double
+exponential_inverse( double y )
+{
+	return( -std::log( y ) );
+}
+
+/**
+	Return the 256-layer ziggurat of the normal distribution, which is built
+	on first use.
+	@retval table Layers
+ */
+const Ziggurat_Table&
+normal_ziggurat( )
+{
+	static const Ziggurat_Table table = build_ziggurat( 3.6541528853610088,
+			0.00492867323399, normal_density, normal_inverse );
+	return( table );
+}
+
+/**
+	Return the 256-layer ziggurat of the exponential distribution, which is
+	built on first use.
+	@retval table Layers
+ */
+const Ziggurat_Table&
+exponential_ziggurat( )
+{
+	static const Ziggurat_Table table = build_ziggurat( 7.69711747013104972,
+			0.0039496598225815571993, exponential_density, exponential_inverse );
+	return( table );
+}
+
+/// Numbers drawn from the lanes at a time by ziggurat_fill()
+static const size_t fill_block_size = 1024;
+
+#ifdef WS_TOOLS_X86_DISPATCH
+/**
+	Make the first attempt of each number of a block 4 at a time using AVX2,
+	as ziggurat_fill() does: gather the layer edges, convert the 53 upper bits
+	to a point in the layer, and keep it if it is inside the layer's inner
+	rectangle.
+	@param[in] table Layers
+	@param[in] normal Whether to give the point the sign in bit 8 of its bits
+	@param[in] bits Random bits of each attempt
+	@param[out] out Numbers (those rejected are left to be replaced)
+	@param[in] n Number of numbers
+	@param[in] offset Added to each number
+	@param[in] scale Multiplies each number
+	@param[out] rejects Positions of the rejected attempts (appended to)
+	@param[in,out] num_rejects Number of rejected attempts
+	@retval i Number of attempts made (a multiple of 4)
+ */
+static WS_TOOLS_TARGET( "avx2" ) size_t
+ziggurat_block_avx2( const Ziggurat_Table& table, bool normal,
+		const uint64_t* bits, double* out, size_t n, double offset,
+		double scale, uint32_t* rejects, size_t& num_rejects )
+{
+	const __m256i layer    = _mm256_set1_epi64x( 0xFF );
+	const __m256i sign     = _mm256_set1_epi64x( normal ? 0x100 : 0 );
+	const __m256i exponent = _mm256_set1_epi64x( 0x4330000000000000LL );
+	const __m256i one      = _mm256_set1_epi64x( 1 );
+	const __m256d two_52   = _mm256_set1_pd( 0x1.0p52 );
+	const __m256d scale_52 = _mm256_set1_pd( 0x1.0p-52 );
+	const __m256d scale_53 = _mm256_set1_pd( 0x1.0p-53 );
+	const __m256d offset_4 = _mm256_set1_pd( offset );
+	const __m256d scale_4  = _mm256_set1_pd( scale );
+
+	size_t i = 0;
+	for( ; i + 4 <= n; i += 4 )
+	{
+		const __m256i b = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>( bits + i ) );
+		const __m256i l = _mm256_and_si256( b, layer );
+		const __m256d x_i  = _mm256_i64gather_pd( table.x, l, 8 );
+		const __m256d x_i1 = _mm256_i64gather_pd( table.x + 1, l, 8 );
+
+		// to_unit_double() of the bits (see to_unit_doubles())
+		const __m256i u = _mm256_srli_epi64( b, 11 );
+		const __m256d high = _mm256_sub_pd( _mm256_castsi256_pd(
+					_mm256_or_si256( _mm256_srli_epi64( u, 1 ), exponent ) ),
+				two_52 );
+		const __m256d low = _mm256_sub_pd( _mm256_castsi256_pd(
+					_mm256_or_si256( _mm256_and_si256( u, one ), exponent ) ),
+				two_52 );
+		const __m256d unit = _mm256_add_pd( _mm256_mul_pd( high, scale_52 ),
+				_mm256_mul_pd( low, scale_53 ) );
+
+		__m256d x = _mm256_mul_pd( unit, x_i );
+		const int accepted = _mm256_movemask_pd(
+				_mm256_cmp_pd( x, x_i1, _CMP_LT_OQ ) );
+
+		// ziggurat_sign(): move bit 8 to the sign bit
+		x = _mm256_xor_pd( x, _mm256_castsi256_pd( _mm256_slli_epi64(
+						_mm256_and_si256( b, sign ), 55 ) ) );
+		_mm256_storeu_pd( out + i,
+				_mm256_add_pd( offset_4, _mm256_mul_pd( scale_4, x ) ) );
+
+		if( accepted != 0xF )
+		{
+			for( unsigned k = 0; k != 4; ++k )
+			{
+				if( (accepted & (1 << k)) == 0 )
+				{
+					rejects[ num_rejects++ ] = static_cast<uint32_t>( i + k );
+				}
+			}
+		}
+	}
+	return( i );
+}
+#endif // WS_TOOLS_X86_DISPATCH
+
+/**
+	Fill an array with ziggurat samples drawn in bulk from the lanes.
+
+	The first attempt of each number is made for a whole block of random bits
+	at once (4 numbers at a time with AVX2, if the processor has it), which
+	accepts over 98% of them. The attempts that fall outside their layer's
+	inner rectangle are finished afterwards one at a time, as
+	ziggurat_normal() and ziggurat_exponential() would, drawing any further
+	bits they need from the lanes.
+
+	@param[in,out] lanes Source of random bits
+	@param[in] normal Whether to sample the normal (or else the exponential)
+		distribution
+	@param[out] out Array
+	@param[in] n Number of elements
+	@param[in] offset Added to each number
+	@param[in] scale Multiplies each number
+ */
+static void
+ziggurat_fill( Xoshiro256_Lanes& lanes, bool normal, double* out, size_t n,
+		double offset, double scale )
+{
+	const Ziggurat_Table& table = normal ? normal_ziggurat()
+		: exponential_ziggurat();
+
+	alignas(32) uint64_t bits[ fill_block_size ];
+	uint32_t             rejects[ fill_block_size ];
+	for( size_t start = 0; start < n; start += fill_block_size )
+	{
+		const size_t m      = std::min( fill_block_size, n - start );
+		double*      block  = out + start;
+		size_t       num_rejects = 0;
+		lanes.fill( bits, m );
+
+		size_t i = 0;
+#ifdef WS_TOOLS_X86_DISPATCH
+		if( cpu_has_avx2() )
+		{
+			i = ziggurat_block_avx2( table, normal, bits, block, m, offset,
+					scale, rejects, num_rejects );
+		}
+#endif // WS_TOOLS_X86_DISPATCH
+		for( ; i != m; ++i )
+		{
+			const unsigned l = bits[i] & 0xFF;
+			const double   x = to_unit_double( bits[i] ) * table.x[l];
+			if( x < table.x[l + 1] )
+			{
+				block[i] = offset + scale * (normal ? ziggurat_sign( x, bits[i] )
+						: x);
+			}
+			else
+			{
+				rejects[ num_rejects++ ] = static_cast<uint32_t>( i );
+			}
+		}
+
+		if( num_rejects == 0 )
+		{
+			continue;
+		}
+		Lane_Bits extra( lanes, 2 * num_rejects );
+		for( size_t k = 0; k != num_rejects; ++k )
+		{
+			const uint64_t b = bits[ rejects[k] ];
+			const unsigned l = b & 0xFF;
+			const double   x = to_unit_double( b ) * table.x[l];
+			double number;
+			if( normal )
+			{
+				if( !ziggurat_normal_edge( extra, table, b, x, number ) )
+				{
+					number = ziggurat_normal( extra );
+				}
+			}
+			else if( !ziggurat_exponential_edge( extra, table, l, x, number ) )
+			{
+				number = ziggurat_exponential( extra );
+			}
+			block[ rejects[k] ] = offset + scale * number;
+		}
+	}
+}
+
+/**
+	Fill an array with normal random numbers drawn in bulk from the lanes.
+	@param[in,out] lanes Source of random bits
+	@param[out] out Array
+	@param[in] n Number of elements
+	@param[in] mean Mean
+	@param[in] std_dev Standard deviation
+ */
+void
+ziggurat_fill_normal( Xoshiro256_Lanes& lanes, double* out, size_t n,
+		double mean, double std_dev )
+{
+	ziggurat_fill( lanes, true, out, n, mean, std_dev );
+}
+
+/**
+	Fill an array with exponential random numbers drawn in bulk from the
+	lanes.
+	@param[in,out] lanes Source of random bits
+	@param[out] out Array
+	@param[in] n Number of elements
+	@param[in] mean Mean (1 / rate)
+ */
+void
+ziggurat_fill_exponential( Xoshiro256_Lanes& lanes, double* out, size_t n,
+		double mean )
+{
+	ziggurat_fill( lanes, false, out, n, 0, mean );
+}
+
+} // namespace ws_tools
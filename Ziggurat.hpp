@@ -0,0 +1,208 @@
+/**
+	@file   Ziggurat.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Ziggurat samplers for the normal and exponential distributions.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _ZIGGURAT_HPP
+#define _ZIGGURAT_HPP
+
+// c headers
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// tools headers
+#include "Random_Engine.hpp"
+
+namespace ws_tools
+{
+
+/**
+	@brief Layers of a ziggurat covering one side of a decreasing density f.
+
+	Layer i spans [0, x[i]) horizontally and [f(x[i]), f(x[i + 1]))
+	vertically, and every layer has the same area. Layer 0 is the base, whose
+	width x[0] is chosen so that its rectangle has the same area as the
+	bottom strip plus the tail beyond r = x[1].
+ */
+struct Ziggurat_Table
+{
+	/// Number of layers
+	static const unsigned NUM_LAYERS = 256;
+
+	double x[NUM_LAYERS + 1];  //< Right edge of each layer, with x[256] = 0
+	double f[NUM_LAYERS + 1];  //< Density at each x
+	double r;                  //< Start of the tail
+};
+
+extern const Ziggurat_Table& normal_ziggurat( );
+extern const Ziggurat_Table& exponential_ziggurat( );
+
+extern void ziggurat_fill_normal( Xoshiro256_Lanes&, double*, std::size_t,
+		double = 0, double = 1 );
+extern void ziggurat_fill_exponential( Xoshiro256_Lanes&, double*,
+		std::size_t, double = 1 );
+
+/**
+	Give a number the sign in bit 8 of random bits without a branch, which would
+	be mispredicted half of the time.
+	@param[in] x Nonnegative number
+	@param[in] bits Random bits
+	@retval signed_x x or -x
+ */
+inline double
+ziggurat_sign( double x, uint64_t bits )
+{
+	uint64_t x_bits;
+	std::memcpy( &x_bits, &x, sizeof(x) );
+	x_bits ^= (bits & 0x100) << 55;
+	std::memcpy( &x, &x_bits, sizeof(x) );
+	return( x );
+}
+
+/**
+	Finish an attempt of ziggurat_normal() that fell outside the inner
+	rectangle of its layer, which is kept out of line so that the common case
+	is inlined.
+	@param[in,out] engine Source of 64-bit random numbers
+	@param[in] table Layers
+	@param[in] bits Random bits of the attempt
+	@param[in] x Point in the layer
+	@param[out] number Normal random number if accepted
+	@retval accepted Whether the attempt was accepted
+ */
+template<typename Engine>
+__attribute__(( noinline )) bool
+ziggurat_normal_edge( Engine& engine, const Ziggurat_Table& table,
+		uint64_t bits, double x, double& number )
+{
+	const unsigned i = bits & 0xFF;
+	if( i == 0 )
+	{
+		// tail beyond r (Marsaglia's method)
+		double a;
+		double b;
+		do
+		{
+			a = -std::log( 1 - to_unit_double( engine() ) ) / table.r;
+			b = -std::log( 1 - to_unit_double( engine() ) );
+		}
+		while( b + b < a * a );
+		number = ziggurat_sign( table.r + a, bits );
+		return( true );
+	}
+	if( table.f[i] + to_unit_double( engine() ) * (table.f[i + 1] - table.f[i])
+			< std::exp( -0.5 * x * x ) )
+	{
+		number = ziggurat_sign( x, bits );
+		return( true );
+	}
+	return( false );
+}
+
+/**
+	Return a standard normal random number (mean 0, standard deviation 1)
+	using the ziggurat method (Marsaglia and Tsang).
+
+	Each attempt uses one 64-bit number: the lowest 8 bits select a layer,
+	the next bit the sign, and the upper 53 bits a point in the layer. The
+	point is accepted without evaluating the density over 98% of the time;
+	otherwise it is tested against the density, or a number from the tail is
+	drawn if the base layer was chosen.
+
+	@param[in,out] engine Source of 64-bit random numbers
+	@retval number Normal random number
+ */
+template<typename Engine>
+inline double
+ziggurat_normal( Engine& engine )
+{
+	static const Ziggurat_Table& table = normal_ziggurat();
+	auto& source = bit_engine( engine );
+	while( true )
+	{
+		const uint64_t bits = source();
+		const unsigned i    = bits & 0xFF;
+		const double   x    = to_unit_double( bits ) * table.x[i];
+		double number;
+		if( __builtin_expect( x < table.x[i + 1], 1 ) )
+		{
+			return( ziggurat_sign( x, bits ) );
+		}
+		if( ziggurat_normal_edge( source, table, bits, x, number ) )
+		{
+			return( number );
+		}
+	}
+}
+
+/**
+	Finish an attempt of ziggurat_exponential() that fell outside the inner
+	rectangle of its layer.
+	@param[in,out] engine Source of 64-bit random numbers
+	@param[in] table Layers
+	@param[in] i Layer
+	@param[in] x Point in the layer
+	@param[out] number Exponential random number if accepted
+	@retval accepted Whether the attempt was accepted
+ */
+template<typename Engine>
+__attribute__(( noinline )) bool
+ziggurat_exponential_edge( Engine& engine, const Ziggurat_Table& table,
+		unsigned i, double x, double& number )
+{
+	if( i == 0 )
+	{
+		// the tail beyond r is r plus another exponential number
+		number = table.r - std::log( 1 - to_unit_double( engine() ) );
+		return( true );
+	}
+	if( table.f[i] + to_unit_double( engine() ) * (table.f[i + 1] - table.f[i])
+			< std::exp( -x ) )
+	{
+		number = x;
+		return( true );
+	}
+	return( false );
+}
+
+/**
+	Return a standard exponential random number (rate 1) using the ziggurat
+	method. Each attempt uses one 64-bit number as in ziggurat_normal().
+	@param[in,out] engine Source of 64-bit random numbers
+	@retval number Exponential random number
+ */
+template<typename Engine>
+inline double
+ziggurat_exponential( Engine& engine )
+{
+	static const Ziggurat_Table& table = exponential_ziggurat();
+	auto& source = bit_engine( engine );
+	while( true )
+	{
+		const uint64_t bits = source();
+		const unsigned i    = bits & 0xFF;
+		const double   x    = to_unit_double( bits ) * table.x[i];
+		double number;
+		if( __builtin_expect( x < table.x[i + 1], 1 ) )
+		{
+			return( x );
+		}
+		if( ziggurat_exponential_edge( source, table, i, x, number ) )
+		{
+			return( number );
+		}
+	}
+}
+
+} // namespace ws_tools
+
+#endif // _ZIGGURAT_HPP
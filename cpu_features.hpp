@@ -0,0 +1,127 @@
+/**
+	@file   cpu_features.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Functions for choosing vector instructions at run time.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _CPU_FEATURES_HPP
+#define _CPU_FEATURES_HPP
+
+// c headers
+#include <cstdlib>
+#include <cstring>
+
+/*
+	SSE2 is part of every x86-64 processor, so it is used wherever __SSE2__ is
+	defined. Later instruction sets (SSSE3, AVX, AVX2) are not enabled by the
+	default build, so code using them is put in functions of its own marked
+	with WS_TOOLS_TARGET(), which the compiler builds for that instruction set
+	alone, and called only if cpu_has_*() says the processor supports it. A
+	build for a newer processor (e.g., with -march=x86-64-v3) needs no check.
+ */
+#if defined( __GNUC__ ) && defined( __x86_64__ )
+	#define WS_TOOLS_X86_DISPATCH
+	#define WS_TOOLS_TARGET( isa ) __attribute__(( target( isa ) ))
+	#include <immintrin.h>
+#endif
+
+namespace ws_tools
+{
+
+#ifdef WS_TOOLS_X86_DISPATCH
+
+	/**
+		@brief Instruction sets chosen at run time, in increasing order.
+	 */
+	enum Cpu_Level
+	{
+		Cpu_SSE2,
+		Cpu_SSSE3,
+		Cpu_AVX,
+		Cpu_AVX2
+	};
+
+	/**
+		Return the newest instruction set supported by the processor (and
+		operating system).
+
+		Setting the environment variable WS_TOOLS_SIMD to sse2, ssse3, or avx
+		limits the choice to that instruction set, so the other versions of
+		each function can be tested on a newer processor.
+
+		@retval level Instruction set
+	 */
+	inline Cpu_Level
+	cpu_level( )
+	{
+		static const Cpu_Level level = []( )
+			{
+				__builtin_cpu_init();
+				Cpu_Level supported = Cpu_SSE2;
+				if( __builtin_cpu_supports( "ssse3" ) )
+				{
+					supported = Cpu_SSSE3;
+					if( __builtin_cpu_supports( "avx" ) )
+					{
+						supported = Cpu_AVX;
+						if( __builtin_cpu_supports( "avx2" ) )
+						{
+							supported = Cpu_AVX2;
+						}
+					}
+				}
+
+				const char* limit = std::getenv( "WS_TOOLS_SIMD" );
+				Cpu_Level   most  = Cpu_AVX2;
+				if( limit != 0 )
+				{
+					most = (std::strcmp( limit, "sse2" ) == 0) ? Cpu_SSE2
+						: (std::strcmp( limit, "ssse3" ) == 0) ? Cpu_SSSE3
+						: (std::strcmp( limit, "avx" ) == 0) ? Cpu_AVX : Cpu_AVX2;
+				}
+				return( (supported < most) ? supported : most );
+			}( );
+		return( level );
+	}
+
+	/**
+		Return whether SSSE3 instructions can be used.
+		@retval supported Whether SSSE3 is supported
+	 */
+	inline bool
+	cpu_has_ssse3( )
+	{
+		return( cpu_level() >= Cpu_SSSE3 );
+	}
+
+	/**
+		Return whether AVX instructions can be used.
+		@retval supported Whether AVX is supported
+	 */
+	inline bool
+	cpu_has_avx( )
+	{
+		return( cpu_level() >= Cpu_AVX );
+	}
+
+	/**
+		Return whether AVX2 instructions can be used.
+		@retval supported Whether AVX2 is supported
+	 */
+	inline bool
+	cpu_has_avx2( )
+	{
+		return( cpu_level() >= Cpu_AVX2 );
+	}
+
+#endif // WS_TOOLS_X86_DISPATCH
+
+} // namespace ws_tools
+
+#endif // _CPU_FEATURES_HPP
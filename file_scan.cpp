@@ -0,0 +1,159 @@
+/**
+	@file   file_scan.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Functions for searching the contents of many files.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#include "file_scan.hpp"
+
+// system headers
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// tools headers
+#include "Mapped_File.hpp"
+#include "parallel.hpp"
+
+using std::size_t;
+using std::string;
+using std::vector;
+
+namespace ws_tools
+{
+
+/// Files smaller than this are read into a buffer instead of being mapped,
+/// since mapping and unmapping costs more than copying a few pages
+static const size_t min_mapped_size = 1 << 16;
+
+/**
+	Search one file.
+
+	@param[in] file_name File to search
+	@param[in] matcher Patterns to find
+	@param[out] matches Matches found in the file
+ */
+static void
+scan_file( const string& file_name, const Literal_Matcher& matcher,
+		vector<Literal_Matcher::Match>& matches )
+{
+	const int fd = open( file_name.c_str(), O_RDONLY );
+	if( fd < 0 )
+	{
+		err_warn( "Unable to open file '%s'\n", file_name.c_str() );
+		return;
+	}
+
+	struct stat stat_buf;
+	if( fstat( fd, &stat_buf ) == 0 && S_ISREG( stat_buf.st_mode )
+			&& static_cast<size_t>( stat_buf.st_size ) >= min_mapped_size )
+	{
+		::close( fd );
+
+		// the file may be removed between the checks and mapping it
+		Mapped_File file;
+		if( !file.try_open( file_name ) )
+		{
+			err_warn( "Unable to read file '%s'\n", file_name.c_str() );
+			return;
+		}
+		file.advise_sequential();
+		matcher.find_all( file.data(), file.size(), matches );
+		return;
+	}
+
+	// small (or unmappable) file, read into a buffer kept by each thread
+	thread_local vector<char> buffer;
+	size_t size = 0;
+	while( true )
+	{
+		if( buffer.size() - size < min_mapped_size )
+		{
+			buffer.resize( size + min_mapped_size );
+		}
+		const ssize_t num_read = read( fd, &buffer[size],
+				buffer.size() - size );
+		if( num_read < 0 )
+		{
+			err_warn( "Unable to read file '%s'\n", file_name.c_str() );
+			break;
+		}
+		if( num_read == 0 )
+		{
+			break;
+		}
+		size += num_read;
+	}
+	::close( fd );
+	matcher.find_all( buffer.data(), size, matches );
+}
+
+/**
+	Search the contents of each file for the matcher's patterns.
+
+	Files are handed out to the threads one at a time. Large files are mapped
+	and small ones are read into a per-thread buffer, so no data is copied
+	through stdio, and the matcher skips over text without candidate matches
+	using SIMD, so the search is normally limited by reading the files.
+
+	Files that cannot be opened or read are warned about and skipped.
+
+	@param[in] file_names Files to search
+	@param[in] matcher Patterns to find
+	@param[in] num_threads Number of threads to use (0 means one per
+		processor)
+	@retval matches Matches ordered by file and then by offset
+ */
+vector<File_Match>
+scan_files( const vector<string>& file_names, const Literal_Matcher& matcher,
+		unsigned num_threads )
+{
+	// matches of each file
+	vector< vector<Literal_Matcher::Match> > file_matches( file_names.size() );
+	parallel_for( file_names.size(), num_threads,
+		[&]( size_t i )
+		{
+			scan_file( file_names[i], matcher, file_matches[i] );
+		} );
+
+	vector<File_Match> matches;
+	for( size_t i = 0; i != file_matches.size(); ++i )
+	{
+		for( size_t j = 0; j != file_matches[i].size(); ++j )
+		{
+			matches.push_back( File_Match{ i, file_matches[i][j].offset,
+					file_matches[i][j].pattern } );
+		}
+	}
+	return( matches );
+}
+
+/**
+	Search the contents of each file in a directory tree for the matcher's
+	patterns.
+	@param[in] directory_name Directory to search
+	@param[in] matcher Patterns to find
+	@param[out] file_names Files searched (as found by dir_traverse()), which
+		File_Match::file indexes
+	@param[in] filter Predicate function invoked on all regular files--only those
+		files for which the predicate is true are searched
+	@param[in] num_threads Number of threads to use (0 means one per
+		processor)
+	@retval matches Matches ordered by file and then by offset
+ */
+vector<File_Match>
+scan_dir( const string& directory_name, const Literal_Matcher& matcher,
+		vector<string>& file_names, bool (*filter)( const string& ),
+		unsigned num_threads )
+{
+	file_names = dir_traverse( directory_name, filter );
+	return( scan_files( file_names, matcher, num_threads ) );
+}
+
+} // namespace ws_tools
@@ -0,0 +1,49 @@
+/**
+	@file   file_scan.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Functions for searching the contents of many files.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _FILE_SCAN_HPP
+#define _FILE_SCAN_HPP
+
+// c++ headers
+#include <string>
+#include <vector>
+
+// c headers
+#include <cstddef>
+
+// tools headers
+#include "Literal_Matcher.hpp"
+#include "util.hpp"
+
+namespace ws_tools
+{
+	/**
+		@brief Location of a pattern in one of the scanned files.
+	 */
+	struct File_Match
+	{
+		std::size_t file;     //< Index of the file in the list scanned
+		std::size_t offset;   //< Offset of the match in the file
+		unsigned    pattern;  //< Index of the pattern that matched
+	};
+
+	extern std::vector<File_Match> scan_files(
+			const std::vector<std::string>&, const Literal_Matcher&,
+			unsigned = 0 );
+
+	extern std::vector<File_Match> scan_dir( const std::string&,
+			const Literal_Matcher&, std::vector<std::string>&,
+			bool (*)( const std::string& ) = all_true, unsigned = 0 );
+
+} // namespace ws_tools
+
+#endif // _FILE_SCAN_HPP
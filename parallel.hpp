@@ -0,0 +1,97 @@
+/**
+	@file   parallel.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Functions for running loops on several threads.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _PARALLEL_HPP
+#define _PARALLEL_HPP
+
+// c++ headers
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// c headers
+#include <cstddef>
+
+namespace ws_tools
+{
+	/**
+		Return the number of threads to use when the caller does not specify it,
+		which is the number of hardware threads (at least 1).
+		@retval num_threads Number of threads
+	 */
+	inline unsigned
+	default_num_threads( )
+	{
+		const unsigned num_threads = std::thread::hardware_concurrency();
+		return( (num_threads == 0) ? 1 : num_threads );
+	}
+
+	/**
+		Call f(i) for each i in [0, n) using the given number of threads.
+
+		Indices are handed out one at a time from a shared counter, so tasks of
+		very different sizes (e.g., files) still keep every thread busy. The
+		calling thread does its share of the work, and with one thread (or one
+		task) no threads are created at all.
+
+		@param[in] n Number of tasks
+		@param[in] num_threads Number of threads to use (0 means
+			default_num_threads())
+		@param[in] f Function called with each task index; it must be safe to
+			call from several threads at once
+	 */
+	template<typename Function>
+	void
+	parallel_for( std::size_t n, unsigned num_threads, Function f )
+	{
+		if( num_threads == 0 )
+		{
+			num_threads = default_num_threads();
+		}
+		if( num_threads > n )
+		{
+			num_threads = static_cast<unsigned>( n );
+		}
+		if( num_threads <= 1 )
+		{
+			for( std::size_t i = 0; i != n; ++i )
+			{
+				f( i );
+			}
+			return;
+		}
+
+		std::atomic<std::size_t> next_task( 0 );
+		auto worker = [&]( )
+		{
+			std::size_t i;
+			while( (i = next_task.fetch_add( 1 )) < n )
+			{
+				f( i );
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for( unsigned t = 1; t != num_threads; ++t )
+		{
+			threads.push_back( std::thread( worker ) );
+		}
+		worker();
+		for( unsigned t = 0; t != threads.size(); ++t )
+		{
+			threads[t].join();
+		}
+	}
+
+} // namespace ws_tools
+
+#endif // _PARALLEL_HPP
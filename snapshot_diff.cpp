@@ -0,0 +1,221 @@
+/**
+	@file   snapshot_diff.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Functions for finding the differences between two directory trees.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#include "snapshot_diff.hpp"
+
+// c headers
+#include <cstring>
+
+using std::size_t;
+using std::string;
+using std::vector;
+
+namespace ws_tools
+{
+
+/// Start of every snapshot file, followed by the fields it has
+static const char snapshot_magic[8] = { 'w', 's', 's', 'n', 'a', 'p', '1', '\n' };
+
+/**
+	Return the number of characters that the top directory and the '/' after
+	it add to the start of each path found by Dir_Walker.
+	@param[in] directory_name Top directory
+	@retval length Number of characters
+ */
+size_t
+Snapshot_Cursor::root_length( const string& directory_name )
+{
+	// the top directory as Dir_Walker writes it
+	string dir_name = sub_home( directory_name );
+	string::size_type slash_pos = dir_name.find_last_of( '/' );
+	if( slash_pos == dir_name.size() - 1 && slash_pos != 0 )
+	{
+		dir_name.erase( slash_pos );
+	}
+	return( (dir_name == "/") ? 1 : dir_name.size() + 1 );
+}
+
+/**
+	Start walking the given directory in tree order.
+	@param[in] directory_name Directory to walk
+	@param[in] filter Predicate function invoked on all regular files--only those
+		files for which the predicate is true are in the snapshot
+ */
+Walker_Cursor::Walker_Cursor( const string& directory_name,
+		bool (*filter)( const string& ) )
+: _walker( directory_name, true, true, filter ),
+	_root_length( root_length( directory_name ) )
+{ }
+
+/**
+	Get the next file.
+	@param[out] entry Next file, whose path is valid until the next call
+	@retval found Whether there was another file
+ */
+bool
+Walker_Cursor::next( Snapshot_Entry& entry )
+{
+	struct stat stat_buf;
+	if( !_walker.next( _file_name, &stat_buf ) )
+	{
+		return( false );
+	}
+	entry.path = std::string_view( _file_name ).substr(
+			std::min( _root_length, _file_name.size() ) );
+	entry.size  = stat_buf.st_size;
+	entry.mtime = static_cast<int64_t>( stat_buf.st_mtim.tv_sec ) * 1000000000
+		+ stat_buf.st_mtim.tv_nsec;
+	entry.ino   = stat_buf.st_ino;
+	return( true );
+}
+
+/**
+	Write a snapshot to a file, to be read back later with File_Cursor.
+
+	The file holds the fields the snapshot has, then each file in tree order:
+	its size, modification time, and inode number, the length of its path,
+	and the path itself. Numbers are written in the machine's byte order, so
+	the file is meant to be read on the same kind of machine. Files are
+	written as they are read, so a snapshot taken with Walker_Cursor goes to
+	disk without a list of its files ever being built. A snapshot whose files
+	are out of tree order ends the program, since it could not be compared.
+
+	@param[in,out] files Snapshot to write
+	@param[in] file_name Name of the file to write
+	@retval num_files Number of files written
+ */
+size_t
+write_snapshot( Snapshot_Cursor& files, const string& file_name )
+{
+	FILE* fp = open_file( file_name, "wb" );
+	const uint32_t fields = files.fields();
+	bool ok = fwrite( snapshot_magic, sizeof(snapshot_magic), 1, fp ) == 1
+		&& fwrite( &fields, sizeof(fields), 1, fp ) == 1;
+
+	size_t         num_files = 0;
+	string         last_path;
+	Snapshot_Entry entry;
+	while( ok && files.next( entry ) )
+	{
+		if( num_files != 0 && compare_paths( last_path, entry.path ) >= 0 )
+		{
+			err_quit( "write_snapshot: '%s' is out of tree order in '%s'\n",
+					string( entry.path ).c_str(), file_name.c_str() );
+		}
+		last_path.assign( entry.path );
+
+		const uint64_t size   = entry.size;
+		const int64_t  mtime  = entry.mtime;
+		const uint64_t ino    = entry.ino;
+		const uint32_t length = entry.path.size();
+		ok = fwrite( &size, sizeof(size), 1, fp ) == 1
+			&& fwrite( &mtime, sizeof(mtime), 1, fp ) == 1
+			&& fwrite( &ino, sizeof(ino), 1, fp ) == 1
+			&& fwrite( &length, sizeof(length), 1, fp ) == 1
+			&& fwrite( entry.path.data(), 1, length, fp ) == length;
+		++num_files;
+	}
+	if( !ok )
+	{
+		err_quit( "Unable to write file '%s'\n", file_name.c_str() );
+	}
+	close_file( fp );
+	return( num_files );
+}
+
+/**
+	Open a snapshot file written by write_snapshot().
+	@param[in] file_name Name of the snapshot file
+ */
+File_Cursor::File_Cursor( const string& file_name )
+: _fp( open_file( file_name, "rb" ) ), _file_name( file_name ), _fields( 0 )
+{
+	char     magic[ sizeof(snapshot_magic) ];
+	uint32_t fields = 0;
+	if( fread( magic, sizeof(magic), 1, _fp ) != 1
+			|| memcmp( magic, snapshot_magic, sizeof(magic) ) != 0
+			|| fread( &fields, sizeof(fields), 1, _fp ) != 1 )
+	{
+		err_quit( "'%s' is not a snapshot file\n", file_name.c_str() );
+	}
+	_fields = fields;
+}
+
+/**
+	Close the snapshot file.
+ */
+File_Cursor::~File_Cursor( )
+{
+	close_file( _fp );
+}
+
+/**
+	Get the next file.
+	@param[out] entry Next file, whose path is valid until the next call
+	@retval found Whether there was another file
+ */
+bool
+File_Cursor::next( Snapshot_Entry& entry )
+{
+	uint64_t size;
+	if( fread( &size, sizeof(size), 1, _fp ) != 1 )
+	{
+		if( ferror( _fp ) )
+		{
+			err_quit( "Unable to read file '%s'\n", _file_name.c_str() );
+		}
+		return( false );
+	}
+
+	int64_t  mtime;
+	uint64_t ino;
+	uint32_t length;
+	if( fread( &mtime, sizeof(mtime), 1, _fp ) != 1
+			|| fread( &ino, sizeof(ino), 1, _fp ) != 1
+			|| fread( &length, sizeof(length), 1, _fp ) != 1 )
+	{
+		err_quit( "Snapshot file '%s' is truncated\n", _file_name.c_str() );
+	}
+	_path.resize( length );
+	if( length != 0 && fread( &_path[0], 1, length, _fp ) != length )
+	{
+		err_quit( "Snapshot file '%s' is truncated\n", _file_name.c_str() );
+	}
+
+	entry.path  = _path;
+	entry.size  = size;
+	entry.mtime = mtime;
+	entry.ino   = static_cast<ino_t>( ino );
+	return( true );
+}
+
+/**
+	Compare two snapshots by merging them in tree order.
+	@param[in,out] old_files Old snapshot
+	@param[in,out] new_files New snapshot
+	@retval diff Files added, removed, and changed
+ */
+Snapshot_Diff
+diff_snapshots( Snapshot_Cursor& old_files, Snapshot_Cursor& new_files )
+{
+	Snapshot_Diff diff;
+	diff_snapshots( old_files, new_files,
+		[&diff]( Diff_Kind kind, const Snapshot_Entry& entry )
+		{
+			vector<string>& paths = (kind == File_Added) ? diff.added
+				: (kind == File_Removed) ? diff.removed : diff.changed;
+			paths.push_back( string( entry.path ) );
+		} );
+	return( diff );
+}
+
+} // namespace ws_tools
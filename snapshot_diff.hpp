@@ -0,0 +1,299 @@
+/**
+	@file   snapshot_diff.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Functions for finding the differences between two directory trees.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _SNAPSHOT_DIFF_HPP
+#define _SNAPSHOT_DIFF_HPP
+
+// c++ headers
+#include <string>
+#include <string_view>
+#include <vector>
+
+// c headers
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// tools headers
+#include "Dir_Walker.hpp"
+#include "File_Table.hpp"
+#include "string_sort.hpp"
+#include "util.hpp"
+
+namespace ws_tools
+{
+
+/**
+	@brief File in a snapshot, with its path relative to the snapshot's top
+	directory.
+ */
+struct Snapshot_Entry
+{
+	std::string_view path;   //< Path relative to the top directory
+	uint64_t         size;   //< Size in bytes
+	int64_t          mtime;  //< Modification time in nanoseconds
+	ino_t            ino;    //< Inode number
+};
+
+/**
+	@brief Source of a snapshot's files in tree order (see sort_paths()).
+ */
+class Snapshot_Cursor
+{
+
+public:
+
+	/**
+		Destructor does nothing.
+	 */
+	virtual ~Snapshot_Cursor( )
+	{ }
+
+	/**
+		Get the next file.
+		@param[out] entry Next file, whose path is valid until the next call
+		@retval found Whether there was another file
+	 */
+	virtual bool next( Snapshot_Entry& entry ) = 0;
+
+	/**
+		Return which of File_Size, File_Mtime, and File_Ino the entries have.
+		@retval fields Bitwise OR of File_Field values
+	 */
+	virtual unsigned fields( ) const = 0;
+
+protected:
+
+	static std::size_t root_length( const std::string& );
+};
+
+/**
+	@brief Snapshot read from a File_Table built in tree order.
+
+	Fields the table did not collect are 0 in the entries and are not compared.
+ */
+template<unsigned Fields>
+class Table_Cursor : public Snapshot_Cursor
+{
+
+public:
+
+	/**
+		Read files from a table.
+		@param[in] table Table built with sorted set to true
+		@param[in] directory_name Directory the table was built from
+	 */
+	Table_Cursor( const File_Table<Fields>& table,
+			const std::string& directory_name )
+	: _table( table ), _root_length( root_length( directory_name ) ), _next( 0 )
+	{ }
+
+	/**
+		Get the next file.
+		@param[out] entry Next file
+		@retval found Whether there was another file
+	 */
+	bool next( Snapshot_Entry& entry )
+	{
+		if( _next == _table.num_files() )
+		{
+			return( false );
+		}
+		const std::size_t i = _next++;
+		entry.path  = _table.path( i ).substr(
+				std::min( _root_length, _table.path( i ).size() ) );
+		entry.size  = 0;
+		entry.mtime = 0;
+		entry.ino   = 0;
+		if constexpr( (Fields & File_Size) != 0 )
+		{
+			entry.size = _table.size( i );
+		}
+		if constexpr( (Fields & File_Mtime) != 0 )
+		{
+			entry.mtime = _table.mtime( i );
+		}
+		if constexpr( (Fields & File_Ino) != 0 )
+		{
+			entry.ino = _table.ino( i );
+		}
+		return( true );
+	}
+
+	/**
+		Return which of File_Size, File_Mtime, and File_Ino the entries have.
+		@retval fields Bitwise OR of File_Field values
+	 */
+	unsigned fields( ) const
+	{
+		return( Fields & (File_Size | File_Mtime | File_Ino) );
+	}
+
+private:
+
+	const File_Table<Fields>& _table;        //< Table being read
+	std::size_t               _root_length;  //< Characters of top directory
+	std::size_t               _next;         //< Next file to return
+};
+
+/**
+	@brief Snapshot read directly from a directory tree with a sorted
+	Dir_Walker, so no list of its files is ever built.
+ */
+class Walker_Cursor : public Snapshot_Cursor
+{
+
+public:
+
+	Walker_Cursor( const std::string&,
+			bool (*)( const std::string& ) = all_true );
+
+	bool next( Snapshot_Entry& );
+
+	/**
+		Return which of File_Size, File_Mtime, and File_Ino the entries have.
+		@retval fields Bitwise OR of File_Field values
+	 */
+	unsigned fields( ) const
+	{
+		return( File_Size | File_Mtime | File_Ino );
+	}
+
+private:
+
+	Dir_Walker  _walker;       //< Walk over the tree
+	std::size_t _root_length;  //< Characters of top directory in each path
+	std::string _file_name;    //< Path of the current file
+};
+
+/**
+	@brief Snapshot read back one file at a time from a file written by
+	write_snapshot(), so a snapshot too large for memory can still be
+	compared.
+ */
+class File_Cursor : public Snapshot_Cursor
+{
+
+public:
+
+	File_Cursor( const std::string& );
+
+	virtual ~File_Cursor( );
+
+	bool next( Snapshot_Entry& );
+
+	/**
+		Return which of File_Size, File_Mtime, and File_Ino the entries have.
+		@retval fields Bitwise OR of File_Field values
+	 */
+	unsigned fields( ) const
+	{
+		return( _fields );
+	}
+
+private:
+
+	// copying would close the file twice
+	File_Cursor( const File_Cursor& );
+	File_Cursor& operator=( const File_Cursor& );
+
+	FILE*       _fp;         //< Snapshot file
+	std::string _file_name;  //< Name of the snapshot file (for messages)
+	unsigned    _fields;     //< Fields the snapshot has
+	std::string _path;       //< Path of the current file
+};
+
+extern std::size_t write_snapshot( Snapshot_Cursor&, const std::string& );
+
+/**
+	@brief Kind of difference between two snapshots.
+ */
+enum Diff_Kind
+{
+	File_Added,    //< File is only in the new snapshot
+	File_Removed,  //< File is only in the old snapshot
+	File_Changed   //< File's size, modification time, or inode changed (of
+	               //  those that both snapshots have)
+};
+
+/**
+	@brief Paths (relative to the top directories) that differ between two
+	snapshots, each in tree order.
+ */
+struct Snapshot_Diff
+{
+	std::vector<std::string> added;    //< Files only in the new snapshot
+	std::vector<std::string> removed;  //< Files only in the old snapshot
+	std::vector<std::string> changed;  //< Files that changed
+};
+
+/**
+	Compare two snapshots by merging them in tree order, calling f( kind,
+	entry ) for each difference, where entry is the new file for File_Added
+	and File_Changed and the old file for File_Removed.
+
+	A file has changed if its size, modification time, or inode differs,
+	considering only the fields that both snapshots have. Each snapshot is
+	read once, one file at a time, so only the current file of each needs to
+	be in memory.
+
+	@param[in,out] old_files Old snapshot
+	@param[in,out] new_files New snapshot
+	@param[in] f Function called with each difference
+ */
+template<typename Function>
+void
+diff_snapshots( Snapshot_Cursor& old_files, Snapshot_Cursor& new_files,
+		Function f )
+{
+	const unsigned fields = old_files.fields() & new_files.fields();
+	const uint64_t size_mask  = (fields & File_Size)  ? ~uint64_t( 0 ) : 0;
+	const int64_t  mtime_mask = (fields & File_Mtime) ? ~int64_t( 0 ) : 0;
+	const ino_t    ino_mask   = (fields & File_Ino)   ? ~ino_t( 0 ) : 0;
+
+	Snapshot_Entry old_entry;
+	Snapshot_Entry new_entry;
+	bool have_old = old_files.next( old_entry );
+	bool have_new = new_files.next( new_entry );
+	while( have_old || have_new )
+	{
+		const int result = !have_old ? 1 : !have_new ? -1
+			: compare_paths( old_entry.path, new_entry.path );
+		if( result < 0 )
+		{
+			f( File_Removed, old_entry );
+			have_old = old_files.next( old_entry );
+		}
+		else if( result > 0 )
+		{
+			f( File_Added, new_entry );
+			have_new = new_files.next( new_entry );
+		}
+		else
+		{
+			if( ((old_entry.size ^ new_entry.size) & size_mask) != 0
+					|| ((old_entry.mtime ^ new_entry.mtime) & mtime_mask) != 0
+					|| ((old_entry.ino ^ new_entry.ino) & ino_mask) != 0 )
+			{
+				f( File_Changed, new_entry );
+			}
+			have_old = old_files.next( old_entry );
+			have_new = new_files.next( new_entry );
+		}
+	}
+}
+
+extern Snapshot_Diff diff_snapshots( Snapshot_Cursor&, Snapshot_Cursor& );
+
+} // namespace ws_tools
+
+#endif // _SNAPSHOT_DIFF_HPP
@@ -0,0 +1,332 @@
+/**
+	@file   string_sort.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Functions for sorting large numbers of strings.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#include "string_sort.hpp"
+
+// c++ headers
+#include <algorithm>
+#include <utility>
+
+// c headers
+#include <cstdint>
+#include <cstring>
+
+using std::size_t;
+using std::string;
+using std::vector;
+
+namespace ws_tools
+{
+
+/// Partitions smaller than this are sorted by comparison
+static const size_t small_sort_size = 32;
+
+/**
+	@brief Byte order (the same as std::string's operator<).
+ */
+struct Byte_Order
+{
+	static const bool is_identity = true;
+
+	static inline unsigned char map( unsigned char c )
+	{
+		return( c );
+	}
+};
+
+/**
+	@brief Tree order: byte order except that '/' comes before every other
+	character, so a directory's contents come right after the directory and
+	before its siblings (e.g., "a", "a/b", "a-b").
+ */
+struct Path_Order
+{
+	static const bool is_identity = false;
+
+	/// '/' becomes 0 and the characters below it move up one
+	static inline unsigned char map( unsigned char c )
+	{
+		return( (c == '/') ? 0 : (c < '/') ? c + 1 : c );
+	}
+};
+
+/**
+	@brief String being sorted along with the next 8 characters to compare.
+ */
+struct Sort_Entry
+{
+	uint64_t key;  //< Mapped characters [depth, depth + 8), high byte first
+	string*  str;  //< String being sorted
+};
+
+/**
+	Return the 8 characters of a string starting at depth as an integer that
+	compares in the same order as the characters, with 0 after the end.
+	@param[in] s String
+	@param[in] depth Position of the first character
+	@retval key Characters packed into an integer
+ */
+template<typename Order>
+static inline uint64_t
+get_key( const string& s, size_t depth )
+{
+	if( Order::is_identity && depth + 8 <= s.size() )
+	{
+		uint64_t key;
+		memcpy( &key, s.data() + depth, 8 );
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		key = __builtin_bswap64( key );
+#endif
+		return( key );
+	}
+
+	uint64_t key = 0;
+	const size_t end = std::min( s.size(), depth + 8 );
+	for( size_t i = depth; i < end; ++i )
+	{
+		key |= static_cast<uint64_t>(
+				Order::map( static_cast<unsigned char>( s[i] ) ) )
+			<< (8 * (7 - (i - depth)));
+	}
+	return( key );
+}
+
+/**
+	Return whether a comes before b, given that both have the same first depth
+	characters.
+	@param[in] a First entry
+	@param[in] b Second entry
+	@param[in] depth Number of characters known to be equal
+	@retval less Whether a comes first
+ */
+template<typename Order>
+static inline bool
+less_from( const Sort_Entry& a, const Sort_Entry& b, size_t depth )
+{
+	if( a.key != b.key )
+	{
+		return( a.key < b.key );
+	}
+	const string& x = *a.str;
+	const string& y = *b.str;
+	const size_t n = std::min( x.size(), y.size() );
+	for( size_t i = depth + 8; i < n; ++i )
+	{
+		const unsigned char cx = Order::map( static_cast<unsigned char>( x[i] ) );
+		const unsigned char cy = Order::map( static_cast<unsigned char>( y[i] ) );
+		if( cx != cy )
+		{
+			return( cx < cy );
+		}
+	}
+	return( x.size() < y.size() );
+}
+
+/**
+	Sort strings that all share their first depth characters.
+
+	This is multikey quicksort (Bentley and Sedgewick) on 8 characters at a
+	time, with the characters cached next to the pointer to each string
+	(Rantala's caching variant): the strings are split three ways on their
+	cached keys, those with a smaller key and those with a larger one are
+	sorted recursively at the same depth, and those with the same key continue
+	8 characters deeper in this loop. Each string's characters are thus read
+	about once per 8 characters of shared prefix instead of once per
+	comparison as in std::sort.
+
+	@param[in,out] a Entries to sort, whose keys are for the given depth
+	@param[in] n Number of entries
+	@param[in] depth Number of characters already known to be equal
+ */
+template<typename Order>
+static void
+multikey_sort( Sort_Entry* a, size_t n, size_t depth )
+{
+	while( n >= small_sort_size )
+	{
+		// median of three keys as the pivot
+		uint64_t x = a[0].key;
+		uint64_t y = a[n / 2].key;
+		uint64_t z = a[n - 1].key;
+		if( x > y ) std::swap( x, y );
+		if( y > z ) std::swap( y, z );
+		if( x > y ) std::swap( x, y );
+		const uint64_t pivot = y;
+
+		// [0, lt) < pivot, [lt, i) == pivot, [gt, n) > pivot
+		size_t lt = 0;
+		size_t i  = 0;
+		size_t gt = n;
+		while( i < gt )
+		{
+			if( a[i].key < pivot )
+			{
+				std::swap( a[lt++], a[i++] );
+			}
+			else if( a[i].key > pivot )
+			{
+				std::swap( a[i], a[--gt] );
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		multikey_sort<Order>( a, lt, depth );
+		multikey_sort<Order>( a + gt, n - gt, depth );
+		a += lt;
+		n  = gt - lt;
+
+		// strings that end within these 8 characters are prefixes of the
+		// longer ones, so they come first, shortest first
+		Sort_Entry* const ended = std::partition( a, a + n,
+			[depth]( const Sort_Entry& e )
+			{
+				return( e.str->size() <= depth + 8 );
+			} );
+		std::sort( a, ended,
+			[]( const Sort_Entry& e, const Sort_Entry& f )
+			{
+				return( e.str->size() < f.str->size() );
+			} );
+		n -= ended - a;
+		a  = ended;
+
+		depth += 8;
+		for( size_t j = 0; j != n; ++j )
+		{
+			a[j].key = get_key<Order>( *a[j].str, depth );
+		}
+	}
+
+	std::sort( a, a + n,
+		[depth]( const Sort_Entry& e, const Sort_Entry& f )
+		{
+			return( less_from<Order>( e, f, depth ) );
+		} );
+}
+
+/**
+	Sort pointers to strings.
+	@param[in,out] strings Pointers to strings to sort
+	@param[in] n Number of strings
+ */
+template<typename Order>
+static void
+sort_pointers( string** strings, size_t n )
+{
+	vector<Sort_Entry> entries( n );
+	for( size_t i = 0; i != n; ++i )
+	{
+		entries[i].key    = get_key<Order>( *strings[i], 0 );
+		entries[i].str = strings[i];
+	}
+	multikey_sort<Order>( entries.data(), n, 0 );
+	for( size_t i = 0; i != n; ++i )
+	{
+		strings[i] = entries[i].str;
+	}
+}
+
+/**
+	Sort strings by sorting pointers to them and then moving each string once.
+	@param[in,out] strings Strings to sort
+ */
+template<typename Order>
+static void
+sort_by_pointer( vector<string>& strings )
+{
+	vector<string*> pointers( strings.size() );
+	for( size_t i = 0; i != strings.size(); ++i )
+	{
+		pointers[i] = &strings[i];
+	}
+	sort_pointers<Order>( pointers.data(), pointers.size() );
+
+	vector<string> sorted;
+	sorted.reserve( strings.size() );
+	for( size_t i = 0; i != pointers.size(); ++i )
+	{
+		sorted.push_back( std::move( *pointers[i] ) );
+	}
+	strings.swap( sorted );
+}
+
+/**
+	Sort strings in byte order (the same order as std::sort).
+	@param[in,out] strings Strings to sort
+ */
+void
+sort_strings( vector<string>& strings )
+{
+	sort_by_pointer<Byte_Order>( strings );
+}
+
+/**
+	Sort pointers to strings in byte order of the strings.
+	@param[in,out] strings Pointers to strings to sort
+	@param[in] n Number of strings
+ */
+void
+sort_strings( string** strings, size_t n )
+{
+	sort_pointers<Byte_Order>( strings, n );
+}
+
+/**
+	Sort paths in tree order: each directory is followed by its contents (in
+	tree order) before the next entry of its parent, which is the order of a
+	depth-first walk that visits each directory's entries by name.
+	@param[in,out] paths Paths to sort
+ */
+void
+sort_paths( vector<string>& paths )
+{
+	sort_by_pointer<Path_Order>( paths );
+}
+
+/**
+	Sort pointers to paths in tree order.
+	@param[in,out] paths Pointers to paths to sort
+	@param[in] n Number of paths
+ */
+void
+sort_paths( string** paths, size_t n )
+{
+	sort_pointers<Path_Order>( paths, n );
+}
+
+/**
+	Compare paths in tree order.
+	@param[in] a First path
+	@param[in] b Second path
+	@retval result Negative if a comes first, positive if b does, and 0 if the
+		paths are equal
+ */
+int
+compare_paths( std::string_view a, std::string_view b )
+{
+	const size_t n = std::min( a.size(), b.size() );
+	for( size_t i = 0; i != n; ++i )
+	{
+		const int a_key = Path_Order::map( static_cast<unsigned char>( a[i] ) );
+		const int b_key = Path_Order::map( static_cast<unsigned char>( b[i] ) );
+		if( a_key != b_key )
+		{
+			return( a_key - b_key );
+		}
+	}
+	return( (a.size() < b.size()) ? -1 : (a.size() > b.size()) ? 1 : 0 );
+}
+
+} // namespace ws_tools
@@ -0,0 +1,36 @@
+/**
+	@file   string_sort.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Functions for sorting large numbers of strings.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _STRING_SORT_HPP
+#define _STRING_SORT_HPP
+
+// c++ headers
+#include <string>
+#include <string_view>
+#include <vector>
+
+// c headers
+#include <cstddef>
+
+namespace ws_tools
+{
+	extern void sort_strings( std::vector<std::string>& );
+	extern void sort_strings( std::string**, std::size_t );
+
+	extern void sort_paths( std::vector<std::string>& );
+	extern void sort_paths( std::string**, std::size_t );
+
+	extern int compare_paths( std::string_view, std::string_view );
+
+} // namespace ws_tools
+
+#endif // _STRING_SORT_HPP
@@ -0,0 +1,243 @@
+/**
+	@file   main.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Program test_csv.
+
+	Test reading delimited text.
+
+	Copyright (c) 2006 Wade Spires. All rights reserved.
+ */
+
+// c++ headers
+#include <iostream>
+#include <string>
+#include <vector>
+
+// tools headers
+#include "ws_tools.hpp"
+
+using std::cerr;  using std::cout;  using std::endl;
+using std::string;
+using std::vector;
+
+using namespace ws_tools;
+
+/**
+	@brief Structure for setting command-line options.
+
+	The following is a list of mandatory program options:
+
+	The following is a list of optional program options:
+		'-h' Display usage information.
+ */
+struct CL_Options
+{
+	CL_Options( int argc, char** argv )
+	: prog_name( argv[0] )
+	{
+		// set each option from command-line
+		while( --argc != 0 )
+		{
+			++argv;
+			if( argv == NULL )
+			{
+				print_usage();
+			}
+			string arg = *argv;
+
+			// by convention, options start with a dash
+			if( arg[0] == '-' )
+			{
+				if( arg.size() == 1 )
+				{
+					print_usage();
+				}
+
+				// handle each option type
+				switch( arg[1] )
+				{
+					// set '-h' option
+					case 'h':
+						print_usage();
+						break;
+
+					default:
+						print_usage();
+						break;
+				}
+			}
+		}
+	}
+
+	/**
+		Print error message showing program usage.
+	 */
+	void print_usage( )
+	{
+		cerr << "usage: " << get_file_name( prog_name )
+			<< " [ Options ]" << endl;
+		exit( EXIT_FAILURE );
+	}
+
+	string prog_name;  //< Name of program
+};
+
+void write_file( const string&, const string& );
+void print_rows( Delimited_Reader& );
+
+void test1( );
+void test2( );
+void test3( );
+
+int main( int argc, char** argv )
+{
+	CL_Options options( argc, argv );
+
+	test1();
+	test2();
+	test3();
+
+	return( EXIT_SUCCESS );
+}
+
+/**
+	Write text to a file.
+ */
+void
+write_file( const string& file_name, const string& text )
+{
+	FILE* fp = open_file( file_name, "w" );
+	fwrite( text.data(), 1, text.size(), fp );
+	close_file( fp );
+}
+
+/**
+	Print each row's line number and fields.
+ */
+void
+print_rows( Delimited_Reader& reader )
+{
+	Delimited_Reader::Row row;
+	while( reader.next_row( row ) )
+	{
+		cout << "  line " << reader.line_num() << ":";
+		for( unsigned i = 0; i != row.size(); ++i )
+		{
+			cout << " [" << row[i] << "]";
+		}
+		cout << endl;
+	}
+}
+
+/**
+	Quoted fields with separators, doubled quotes, newlines, CRLF line endings,
+	empty fields, and blank lines.
+ */
+void
+test1( )
+{
+	cout << "Test 1 -- CSV with quoted fields" << endl;
+
+	const string file_name = "test1.csv";
+	write_file( file_name,
+		"name,city,note\r\n"
+		"wade,\"Orlando, FL\",plain\r\n"
+		"miko,\"say \"\"hi\"\"\",\"two\nlines\"\r\n"
+		"\r\n"
+		",,\r\n"
+		"last,\"\",end" );
+
+	Delimited_Reader reader( file_name );
+	print_rows( reader );
+
+	cout << "  again after rewind():" << endl;
+	reader.rewind();
+	print_rows( reader );
+	cout << endl;
+}
+
+/**
+	Tab-separated text in memory with a backslash escape character.
+ */
+void
+test2( )
+{
+	cout << "Test 2 -- TSV with escapes" << endl;
+
+	const string text = "a\t'b\\'s\ttab'\tc\n1\t2\t3\n";
+	Delimited_Reader reader( text.data(), text.size(), '\t', '\'', '\\' );
+	print_rows( reader );
+	cout << endl;
+}
+
+/**
+	Convert columns of a large file with one thread and with several threads
+	and compare.
+ */
+void
+test3( )
+{
+	cout << "Test 3 -- typed columns, serial and parallel" << endl;
+
+	// several MB so that the parallel reader splits the file into chunks;
+	// quoted fields with commas and newlines land on the chunk boundaries
+	const unsigned num_rows = 200000;
+	string text = "id,label,x,y\n";
+	for( unsigned i = 0; i != num_rows; ++i )
+	{
+		append_values( text, i, ",\"label, ", i % 7, "\n(continued)\",",
+				i * 0.5, ",", (i % 10 == 0) ? string( "" ) : int_to_string( -i ),
+				"\n" );
+	}
+	const string file_name = "test3.csv";
+	write_file( file_name, text );
+
+	const unsigned columns[] = { 0, 2, 3 };
+	const unsigned num_columns = 3;
+
+	unsigned num_errors = 0;
+	for( unsigned num_threads = 1; num_threads <= 4; num_threads += 3 )
+	{
+		vector< vector<double> > values( num_columns,
+				vector<double>( num_rows ) );
+		double* ptrs[] = { &values[0][0], &values[1][0], &values[2][0] };
+
+		Delimited_Reader reader( file_name );
+		Delimited_Reader::Row header;
+		reader.next_row( header );
+		const size_t n = reader.read_columns( columns, ptrs, num_columns,
+				num_rows, num_threads );
+
+		for( unsigned i = 0; i != num_rows; ++i )
+		{
+			const bool y_ok = (i % 10 == 0) ? (values[2][i] != values[2][i])
+				: (values[2][i] == -static_cast<double>( i ));
+			if( values[0][i] != i || values[1][i] != i * 0.5 || !y_ok )
+			{
+				++num_errors;
+			}
+		}
+		cout << "  " << num_threads << " thread(s): " << n << " rows, "
+			<< num_errors << " errors" << endl;
+	}
+
+	// stop part way through with several threads and continue reading rows,
+	// both inside a later chunk and inside the first chunk
+	const size_t stops[] = { 123457, 10 };
+	for( unsigned s = 0; s != 2; ++s )
+	{
+		const size_t max_rows = stops[s];
+		vector<double> ids( max_rows );
+		double* ptrs[] = { &ids[0] };
+
+		Delimited_Reader reader( file_name );
+		Delimited_Reader::Row row;
+		reader.next_row( row );
+		const size_t n = reader.read_columns( columns, ptrs, 1, max_rows, 4 );
+		reader.next_row( row );
+		cout << "  read " << n << " rows, next row starts with id " << row[0]
+			<< " on line " << reader.line_num() << endl;
+	}
+	cout << endl;
+}
@@ -6,10 +6,14 @@
  */
 
 // c++ headers
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
 
+// system headers
+#include <sys/resource.h>
+
 // tools headers
 #include "ws_tools.hpp"
 
@@ -90,6 +94,13 @@ void test5( );
 void test6( );
 void test7( );
 void test8( );
+void test9( );
+void test10( );
+void test11( );
+void test12( );
+void test13( );
+void test14( );
+void test15( );
 
 bool jpg_filter( const string& );
 bool pnm_filter( const string& );
@@ -111,6 +122,13 @@ int main( int argc, char** argv )
 	test6();
 	test7();
 	test8();
+	test9();
+	test10();
+	test11();
+	test12();
+	test13();
+	test14();
+	test15();
 
 	return( EXIT_SUCCESS );
 }
@@ -329,6 +347,381 @@ void test8( )
 	fprintf( stderr, "End test 8\n\n" );
 }
 
+/**
+	Show all files in a directory in tree order. Use recursion.
+ */
+void test9( )
+{
+	const string msg = "Show all files in a directory in tree order. Use recursion.";
+	fprintf( stderr, "Test 9 -- %s\n", msg.c_str() );
+
+	const string dir_name = "dir";
+	vector<string> files = dir_traverse_sorted( dir_name );
+	print_files( files );
+
+	// long paths sharing most of their prefix, sorted against std::sort
+	Uniform_Number uniform( 0, 4 );
+	vector<string> paths;
+	for( unsigned i = 0; i != 20000; ++i )
+	{
+		string path = "/home/user/projects/data";
+		const unsigned depth = 1 + static_cast<unsigned>( uniform.next() );
+		for( unsigned j = 0; j != depth; ++j )
+		{
+			path += "/-_a"[ static_cast<unsigned>( uniform.next() ) % 4 ];
+			path += "ab"[ static_cast<unsigned>( uniform.next() ) % 2 ];
+		}
+		paths.push_back( path );
+	}
+	vector<string> sorted = paths;
+	sort_strings( sorted );
+	vector<string> expected = paths;
+	std::sort( expected.begin(), expected.end() );
+	cout << "   sort_strings() same as std::sort(): " << (sorted == expected)
+		<< endl;
+
+	sorted = paths;
+	sort_paths( sorted );
+	bool in_order = true;
+	for( unsigned i = 1; i < sorted.size(); ++i )
+	{
+		if( compare_paths( sorted[i - 1], sorted[i] ) > 0 )
+		{
+			in_order = false;
+		}
+	}
+	std::sort( expected.begin(), expected.end(),
+		[]( const string& a, const string& b )
+		{ return( compare_paths( a, b ) < 0 ); } );
+	cout << "   sort_paths() in tree order: " << (in_order && sorted == expected)
+		<< endl;
+
+#ifndef _WIN32
+	// levels that each link twice to the next: the sorted walk lists each
+	// level once, as dir_traverse() does, where the depth-first walk lists the
+	// last level once per path to it
+	const unsigned num_levels = 12;
+	bool linked = true;
+	for( unsigned i = 0; i != num_levels; ++i )
+	{
+		string level = "dag/" + int_to_string( i );
+		check_dir( level );
+		close_file( open_file( level + "/g", "w" ) );
+		if( i + 1 != num_levels )
+		{
+			const string next = "../" + int_to_string( i + 1 );
+			linked = linked && symlink( next.c_str(), (level + "/a").c_str() ) == 0
+				&& symlink( next.c_str(), (level + "/b").c_str() ) == 0;
+		}
+	}
+	if( linked )
+	{
+		cout << "   levels linked twice: dir_traverse() "
+			<< dir_traverse( "dag/0" ).size() << ", sorted "
+			<< dir_traverse_sorted( "dag/0" ).size() << ", depth-first "
+			<< dir_traverse_depth_first( "dag/0" ).size() << " files" << endl;
+	}
+	remove_tree( "dag" );
+#endif // _WIN32
+
+	fprintf( stderr, "End test 9\n\n" );
+}
+
+/**
+	Show all files in a directory depth-first, one at a time.
+ */
+void test10( )
+{
+	const string msg = "Show all files in a directory depth-first.";
+	fprintf( stderr, "Test 10 -- %s\n", msg.c_str() );
+
+	const string dir_name = "dir";
+	vector<string> files = dir_traverse_depth_first( dir_name, pnm_filter );
+	print_files( files );
+
+	// walk with file sizes, tracking the deepest level reached
+	Dir_Walker walker( dir_name, true, true );
+	string file_name;
+	struct stat stat_buf;
+	unsigned max_depth = 0;
+	while( walker.next( file_name, &stat_buf ) )
+	{
+		cout << "   " << file_name << " (" << stat_buf.st_size << " bytes)"
+			<< endl;
+		max_depth = std::max<unsigned>( max_depth, walker.depth() );
+	}
+	cout << "   deepest level: " << max_depth << endl;
+
+	// without recursion, the same as dir_open()
+	vector<string> open_files = dir_open( dir_name );
+	vector<string> walker_files;
+	Dir_Walker top_walker( dir_name, false );
+	while( top_walker.next( file_name ) )
+	{
+		walker_files.push_back( file_name );
+	}
+	sort_strings( open_files );
+	sort_strings( walker_files );
+	cout << "   non-recursive same as dir_open(): "
+		<< (open_files == walker_files) << endl;
+
+#ifndef _WIN32
+	// a link back to a directory on the path is not followed, so the walk
+	// ends with the same files as without it
+	if( symlink( "..", "dir/sub_dir/up" ) == 0 )
+	{
+		unsigned num_files = 0;
+		Dir_Walker cycle_walker( dir_name );
+		while( cycle_walker.next( file_name ) )
+		{
+			++num_files;
+		}
+		cout << "   files with a link to a parent: " << num_files << endl;
+		unlink( "dir/sub_dir/up" );
+	}
+#endif // _WIN32
+
+	fprintf( stderr, "End test 10\n\n" );
+}
+
+/**
+	Show the sizes and modes of all files in a directory from a column table.
+ */
+void test11( )
+{
+	const string msg = "Show the sizes and modes of all files in a directory.";
+	fprintf( stderr, "Test 11 -- %s\n", msg.c_str() );
+
+	// give one file some contents
+	FILE* fp = open_file( "dir/b", "w" );
+	fprintf( fp, "twelve bytes" );
+	close_file( fp );
+
+	const string dir_name = "dir";
+	File_Table<File_Size | File_Mode | File_Ino> table( dir_name, true );
+	uint64_t total_size = 0;
+	for( size_t i = 0; i != table.num_files(); ++i )
+	{
+		struct stat stat_buf;
+		stat( string( table.path( i ) ).c_str(), &stat_buf );
+		cout << "   " << table.path( i ) << ": " << table.size( i )
+			<< " bytes, mode " << format_string( "%o", table.mode( i ) )
+			<< ", inode matches stat(): " << (table.ino( i ) == stat_buf.st_ino)
+			<< endl;
+		total_size += table.size( i );
+	}
+	cout << "   " << table.num_files() << " files, " << total_size << " bytes"
+		<< endl;
+
+	fp = open_file( "dir/b", "w" );
+	close_file( fp );
+
+	fprintf( stderr, "End test 11\n\n" );
+}
+
+/**
+	Show the files added, removed, and changed in a directory since a snapshot.
+ */
+void test12( )
+{
+	const string msg = "Show the differences from a snapshot of a directory.";
+	fprintf( stderr, "Test 12 -- %s\n", msg.c_str() );
+
+	const string dir_name = "dir/";
+	File_Table<File_Size | File_Mtime | File_Ino> before( dir_name, true );
+
+	// add, remove, and change a file
+	FILE* fp = open_file( "dir/sub_dir/g.pgm", "w" );
+	close_file( fp );
+	remove( "dir/c.jpg" );
+	fp = open_file( "dir/a", "w" );
+	fprintf( fp, "changed" );
+	close_file( fp );
+
+	// snapshot against the tree itself
+	Table_Cursor<File_Size | File_Mtime | File_Ino> old_files( before, dir_name );
+	Walker_Cursor new_files( dir_name );
+	Snapshot_Diff diff = diff_snapshots( old_files, new_files );
+	cout << "   added:" << endl;
+	print_files( diff.added );
+	cout << "   removed:" << endl;
+	print_files( diff.removed );
+	cout << "   changed:" << endl;
+	print_files( diff.changed );
+
+	// undo the changes and compare two snapshots
+	remove( "dir/sub_dir/g.pgm" );
+	fp = open_file( "dir/c.jpg", "w" );
+	close_file( fp );
+	fp = open_file( "dir/a", "w" );
+	close_file( fp );
+	File_Table<File_Size> after( "dir", true );
+	Table_Cursor<File_Size | File_Mtime | File_Ino> old_cursor( before, dir_name );
+	Table_Cursor<File_Size> new_cursor( after, "dir" );
+	unsigned num_diffs = 0;
+	diff_snapshots( old_cursor, new_cursor,
+		[&num_diffs]( Diff_Kind, const Snapshot_Entry& ) { ++num_diffs; } );
+	cout << "   differences after undoing (sizes only): " << num_diffs << endl;
+
+	// save the first snapshot to disk and stream it back against the tree
+	Table_Cursor<File_Size | File_Mtime | File_Ino> saved_cursor( before,
+			dir_name );
+	cout << "   files written to snapshot file: "
+		<< write_snapshot( saved_cursor, "snapshot.bin" ) << endl;
+	File_Cursor file_cursor( "snapshot.bin" );
+	Walker_Cursor tree_cursor( dir_name );
+	diff = diff_snapshots( file_cursor, tree_cursor );
+	cout << "   differences from snapshot file: " << diff.added.size()
+		<< " added, " << diff.removed.size() << " removed, "
+		<< diff.changed.size() << " changed" << endl;
+	print_files( diff.changed );
+	remove( "snapshot.bin" );
+
+	fprintf( stderr, "End test 12\n\n" );
+}
+
+/**
+	Copy a directory, then copy it again to bring the copy up to date.
+ */
+void test13( )
+{
+	const string msg = "Copy a directory and update the copy.";
+	fprintf( stderr, "Test 13 -- %s\n", msg.c_str() );
+
+	// start without a copy
+	if( access( "dir_copy", F_OK ) == 0 )
+	{
+		remove_tree( "dir_copy" );
+	}
+
+	// a read-only file and a directory whose mode is not the default
+	chmod( "dir/sub_dir/e.pgm", 0444 );
+	chmod( "dir/sub_dir", 0750 );
+
+	Copy_Stats stats = copy_tree( "dir", "dir_copy", 4 );
+	cout << "   first copy: " << stats.num_copied << " copied, "
+		<< stats.num_skipped << " skipped, " << stats.num_failed << " failed"
+		<< endl;
+	print_files( dir_traverse_sorted( "dir_copy" ) );
+
+	struct stat stat_buf;
+	stat( "dir_copy/sub_dir", &stat_buf );
+	cout << "   directory mode copied: " << ((stat_buf.st_mode & 07777) == 0750)
+		<< endl;
+
+	// only the changed file is copied again, though its copy is read-only
+	chmod( "dir/sub_dir/e.pgm", 0644 );
+	FILE* fp = open_file( "dir/sub_dir/e.pgm", "w" );
+	fprintf( fp, "P2\n" );
+	close_file( fp );
+	chmod( "dir/sub_dir/e.pgm", 0444 );
+	stats = copy_tree( "dir", "dir_copy", 4 );
+	cout << "   second copy: " << stats.num_copied << " copied ("
+		<< stats.bytes_copied << " bytes), " << stats.num_skipped
+		<< " skipped, " << stats.num_failed << " failed" << endl;
+
+	fp = open_file( "dir_copy/sub_dir/e.pgm", "r" );
+	char line[8] = "";
+	cout << "   copied contents: " << fgets( line, sizeof(line), fp );
+	close_file( fp );
+	stat( "dir_copy/sub_dir/e.pgm", &stat_buf );
+	cout << "   file mode copied: " << ((stat_buf.st_mode & 07777) == 0444)
+		<< endl;
+
+	chmod( "dir/sub_dir/e.pgm", 0644 );
+	chmod( "dir/sub_dir", 0700 );
+
+	fp = open_file( "dir/sub_dir/e.pgm", "w" );
+	close_file( fp );
+
+	fprintf( stderr, "End test 13\n\n" );
+}
+
+/**
+	Remove a directory tree that contains links out of it.
+ */
+void test14( )
+{
+	const string msg = "Remove a directory tree.";
+	fprintf( stderr, "Test 14 -- %s\n", msg.c_str() );
+
+	// a link out of the tree must not be followed
+	if( symlink( "../../dir", "dir_copy/sub_dir/outside" ) != 0 )
+	{
+		err_warn( "Unable to create symbolic link\n" );
+	}
+	string sub_dir_name = "dir_copy/empty_dir/a/b/c";
+	check_dir( sub_dir_name );
+
+	cout << "   dry run: " << remove_tree( "dir_copy", 4, true )
+		<< " would be removed" << endl;
+	cout << "   removed: " << remove_tree( "dir_copy", 4 ) << endl;
+	cout << "   copy exists: " << (access( "dir_copy", F_OK ) == 0) << endl;
+	cout << "   original files: " << dir_traverse_sorted( "dir" ).size()
+		<< endl;
+
+#ifndef _WIN32
+	// a tree deeper than the number of descriptors a process may open
+	string deep_name = "dir_copy";
+	for( unsigned i = 0; i != 200; ++i )
+	{
+		deep_name += "/d";
+	}
+	check_dir( deep_name );
+	struct rlimit limit;
+	getrlimit( RLIMIT_NOFILE, &limit );
+	struct rlimit low_limit = limit;
+	low_limit.rlim_cur = 64;
+	setrlimit( RLIMIT_NOFILE, &low_limit );
+	cout << "   removed 200 levels with 64 descriptors: "
+		<< remove_tree( "dir_copy", 1 ) << endl;
+	setrlimit( RLIMIT_NOFILE, &limit );
+#endif // _WIN32
+
+	// the root and current directories are refused, even in a dry run
+	const char* refused[] = { "", "/", "//", ".", "./", "dir/..", "dir/../.",
+		"../test_dir", 0 };
+	for( unsigned i = 0; refused[i] != 0; ++i )
+	{
+		cout << "   remove '" << refused[i] << "': "
+			<< remove_tree( refused[i], 1, true ) << endl;
+	}
+
+	fprintf( stderr, "End test 14\n\n" );
+}
+
+/**
+	Expand glob patterns, reading only the directories that can match.
+ */
+void test15( )
+{
+	const string msg = "Expand glob patterns.";
+	fprintf( stderr, "Test 15 -- %s\n", msg.c_str() );
+
+	const char* patterns[] = { "dir/*.{jpg,pgm}", "dir/**/*.p[gp]m",
+		"dir/sub_dir/e.pgm", "dir/{sub_dir,empty_dir}/?.*", "dir/**", 0 };
+	for( unsigned i = 0; patterns[i] != 0; ++i )
+	{
+		Glob_Pattern pattern( patterns[i] );
+		size_t num_dirs_read = 0;
+		const vector<string> files = pattern.expand( &num_dirs_read );
+		cout << "   " << patterns[i] << " (" << num_dirs_read
+			<< " directories read)" << endl;
+		print_files( files );
+	}
+
+	Glob_Pattern pattern( "dir/**/[!a-c]*.{jpg,p?m}" );
+	const char* paths[] = { "dir/d.jpg", "dir/sub_dir/f.ppm", "./dir/c.jpg",
+		"dir/.hidden/e.pgm", "dir/a/b/c/e.pbm", 0 };
+	for( unsigned i = 0; paths[i] != 0; ++i )
+	{
+		cout << "   " << pattern.get_pattern() << " matches " << paths[i]
+			<< ": " << pattern.match( paths[i] ) << endl;
+	}
+
+	fprintf( stderr, "End test 15\n\n" );
+}
+
 /**
 	JPEG file filter.
  */
@@ -0,0 +1,354 @@
+/**
+	@file   main.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Program test_format.
+
+	Test number and string formatting functions.
+
+	Copyright (c) 2006 Wade Spires. All rights reserved.
+ */
+
+// c++ headers
+#include <iostream>
+#include <string>
+#include <vector>
+
+// c headers
+#include <climits>
+
+// tools headers
+#include "ws_tools.hpp"
+
+using std::cerr;  using std::cout;  using std::endl;
+using std::string;
+using std::vector;
+
+using namespace ws_tools;
+
+/**
+	@brief Structure for setting command-line options.
+
+	The following is a list of mandatory program options:
+
+	The following is a list of optional program options:
+		'-h' Display usage information.
+ */
+struct CL_Options
+{
+	CL_Options( int argc, char** argv )
+	: prog_name( argv[0] )
+	{
+		// set each option from command-line
+		while( --argc != 0 )
+		{
+			++argv;
+			if( argv == NULL )
+			{
+				print_usage();
+			}
+			string arg = *argv;
+
+			// by convention, options start with a dash
+			if( arg[0] == '-' )
+			{
+				if( arg.size() == 1 )
+				{
+					print_usage();
+				}
+
+				// handle each option type
+				switch( arg[1] )
+				{
+					// set '-h' option
+					case 'h':
+						print_usage();
+						break;
+
+					default:
+						print_usage();
+						break;
+				}
+			}
+		}
+	}
+
+	/**
+		Print error message showing program usage.
+	 */
+	void print_usage( )
+	{
+		cerr << "usage: " << get_file_name( prog_name )
+			<< " [ Options ]" << endl;
+		exit( EXIT_FAILURE );
+	}
+
+	string prog_name;  //< Name of program
+};
+
+void test_ints( );
+void test_doubles( );
+void test_digits( );
+void test_strings( );
+void test_case( );
+void test_prec( );
+
+int main( int argc, char** argv )
+{
+	CL_Options options( argc, argv );
+
+	test_ints();
+	test_doubles();
+	test_digits();
+	test_strings();
+	test_case();
+	test_prec();
+
+	return( EXIT_SUCCESS );
+}
+
+/**
+	Write integers, including the extremes, and compare with printf().
+ */
+void
+test_ints( )
+{
+	fprintf( stderr, "Integers\n" );
+
+	const long long values[] = { 0, 7, -7, 10, 99, 100, -12345, INT_MAX,
+		INT_MIN, LLONG_MAX, LLONG_MIN };
+	const unsigned num_values = sizeof(values) / sizeof(values[0]);
+
+	for( unsigned i = 0; i != num_values; ++i )
+	{
+		char buf[ INT_BUF_SIZE ];
+		format_int( buf, values[i] );
+
+		char expected[ INT_BUF_SIZE ];
+		snprintf( expected, INT_BUF_SIZE, "%lld", values[i] );
+
+		fprintf( stderr, "  %-21s %s\n", buf,
+				(string( buf ) == expected) ? "ok" : "MISMATCH" );
+	}
+
+	char buf[ INT_BUF_SIZE ];
+	format_uint( buf, ULLONG_MAX );
+	fprintf( stderr, "  %-21s (ULLONG_MAX)\n", buf );
+
+	string s = "row:";
+	append_int( s, 42 );
+	s += ',';
+	append_int( s, -1 );
+	fprintf( stderr, "  append_int: %s\n", s.c_str() );
+	fprintf( stderr, "  int_to_string: %s\n\n", int_to_string( -2006 ).c_str() );
+}
+
+/**
+	Write doubles and verify that each reads back as the same value.
+ */
+void
+test_doubles( )
+{
+	fprintf( stderr, "Doubles\n" );
+
+	const double values[] = { 0.0, -0.0, 1.0, 0.1, 1.0 / 3.0, -2.5, 1e21,
+		1e-7, 123456789.125, 5e-324, 1.7976931348623157e308 };
+	const unsigned num_values = sizeof(values) / sizeof(values[0]);
+
+	for( unsigned i = 0; i != num_values; ++i )
+	{
+		const string s = double_to_string( values[i] );
+		const double d = string_to_double( s );
+		fprintf( stderr, "  %-24s %s\n", s.c_str(),
+				(d == values[i]) ? "round-trips" : "MISMATCH" );
+	}
+
+	string s = "x=";
+	append_double( s, 0.2 );
+	fprintf( stderr, "  append_double: %s\n\n", s.c_str() );
+}
+
+/**
+	Count digits around each power of 10.
+ */
+void
+test_digits( )
+{
+	fprintf( stderr, "Digit counts\n" );
+
+	unsigned num_errors = 0;
+	unsigned p = 1;
+	for( int digits = 1; digits <= 10; ++digits )
+	{
+		if( count_digits( p ) != digits
+				|| (p > 1 && count_digits( p - 1 ) != digits - 1) )
+		{
+			fprintf( stderr, "  count_digits(%u) = %d\n", p, count_digits( p ) );
+			++num_errors;
+		}
+		if( digits != 10 )
+		{
+			p *= 10;
+		}
+	}
+	if( count_digits( 0 ) != 1 || count_digits( UINT_MAX ) != 10 )
+	{
+		++num_errors;
+	}
+	fprintf( stderr, "  %u errors\n\n", num_errors );
+}
+
+/**
+	Format strings longer than the old fixed-size buffer and reuse buffers.
+ */
+void
+test_strings( )
+{
+	fprintf( stderr, "Strings\n" );
+
+	// longer than BUFSIZ, which used to terminate the program
+	const string long_word( 3 * BUFSIZ, 'w' );
+	const string long_str = format_string( "[%s]", long_word.c_str() );
+	fprintf( stderr, "  long format_string: %s\n",
+			(long_str.size() == long_word.size() + 2) ? "ok" : "MISMATCH" );
+
+	// reuse one buffer for many lines
+	string line;
+	for( unsigned i = 0; i != 3; ++i )
+	{
+		line.clear();
+		append_format( line, "line %u of %d: %.2f", i + 1, 3, i / 3.0 );
+		fprintf( stderr, "  %s\n", line.c_str() );
+	}
+
+	fprintf( stderr, "  %s\n",
+			format_temp( "temp %s %d", "message", 7 ).c_str() );
+
+	const string name = "gpa";
+	fprintf( stderr, "  %s\n",
+			concat_values( "Line ", 12u, ": ", name, '=', 3.5, " (", -1, ")" )
+				.c_str() );
+	fprintf( stderr, "\n" );
+}
+
+/**
+	Convert case of every byte value at every alignment and compare with the
+	byte-at-a-time conversion.
+ */
+void
+test_case( )
+{
+	fprintf( stderr, "Case conversion\n" );
+
+	// all byte values except 0, then shifted so that each block boundary lands
+	// on a different byte
+	string all_bytes;
+	for( unsigned c = 1; c != 256; ++c )
+	{
+		all_bytes += static_cast<char>( c );
+	}
+
+	unsigned num_errors = 0;
+	for( unsigned shift = 0; shift != 40; ++shift )
+	{
+		const string str = all_bytes.substr( shift ) + all_bytes.substr( 0, shift );
+
+		string upper = str;
+		string lower = str;
+		to_upper( upper );
+		to_lower( lower );
+
+		for( unsigned i = 0; i != str.size(); ++i )
+		{
+			const int c = static_cast<unsigned char>( str[i] );
+			if( static_cast<unsigned char>( upper[i] ) != toupper( c )
+					|| static_cast<unsigned char>( lower[i] ) != tolower( c ) )
+			{
+				++num_errors;
+			}
+		}
+		if( !equal_nocase( upper, lower )
+				|| compare_nocase( upper, lower ) != 0
+				|| hash_nocase( upper ) != hash_nocase( lower ) )
+		{
+			++num_errors;
+		}
+	}
+	fprintf( stderr, "  %u errors\n", num_errors );
+
+	string key = "Config_Key_With_A_Long_Name";
+	fprintf( stderr, "  %s", key.c_str() );
+	fprintf( stderr, " -> %s", to_upper( key ).c_str() );
+	fprintf( stderr, " -> %s\n", to_lower( key ).c_str() );
+
+	fprintf( stderr, "  compare_nocase(\"abc\", \"ABD\") < 0: %s\n",
+			(compare_nocase( "abc", "ABD" ) < 0) ? "yes" : "no" );
+	fprintf( stderr, "  compare_nocase(\"ABC\", \"ab\") > 0: %s\n",
+			(compare_nocase( "ABC", "ab" ) > 0) ? "yes" : "no" );
+	fprintf( stderr, "  equal_nocase(\"[x]\", \"{X}\"): %s\n\n",
+			equal_nocase( "[x]", "{X}" ) ? "yes" : "no" );
+}
+
+/**
+	Round values with double_prec(), one at a time and in bulk, and compare with
+	printing and reading back each value.
+ */
+void
+test_prec( )
+{
+	fprintf( stderr, "Precision\n" );
+
+	// values near ties, values with few and many digits, and special values
+	vector<double> values;
+	for( int i = -2000; i <= 2000; ++i )
+	{
+		values.push_back( i / 8.0 );       // exact ties at 1 and 2 places
+		values.push_back( i / 1000.0 );    // e.g., 2.675, which is below a tie
+		values.push_back( i * 1.005 );
+	}
+	srand( 1 );
+	for( unsigned i = 0; i != 20000; ++i )
+	{
+		const double mantissa = rand() / (RAND_MAX + 1.0) - 0.5;
+		const int    exponent = rand() % 40 - 20;
+		values.push_back( ldexp( mantissa, exponent ) * 1000 );
+	}
+	values.push_back( 0.0 );
+	values.push_back( -0.0 );
+	values.push_back( 1e300 );
+	values.push_back( -4.5e15 );
+	values.push_back( HUGE_VAL );
+	values.push_back( -HUGE_VAL );
+
+	unsigned num_errors = 0;
+	for( int prec = -1; prec <= 24; ++prec )
+	{
+		vector<double> bulk = values;
+		double_prec( &bulk[0], bulk.size(), prec );
+
+		for( unsigned i = 0; i != values.size(); ++i )
+		{
+			char buf[ 512 ];
+			snprintf( buf, sizeof(buf), "%.*f", prec, values[i] );
+			const double expected = strtod( buf, NULL );
+			const double single   = double_prec( values[i], prec );
+
+			// compare bits so that -0.0 and 0.0 are different
+			if( memcmp( &single, &expected, sizeof(double) ) != 0
+					|| memcmp( &bulk[i], &expected, sizeof(double) ) != 0 )
+			{
+				if( num_errors++ < 10 )
+				{
+					fprintf( stderr, "  %.17g at %d: %.17g %.17g %.17g\n",
+							values[i], prec, expected, single, bulk[i] );
+				}
+			}
+		}
+	}
+	fprintf( stderr, "  %u errors in %u values\n",
+			num_errors, static_cast<unsigned>( 26 * values.size() ) );
+	fprintf( stderr, "  double_prec(2.675, 2) = %.17g\n",
+			double_prec( 2.675, 2 ) );
+	fprintf( stderr, "  double_prec(0.125, 2) = %.17g\n\n",
+			double_prec( 0.125, 2 ) );
+}
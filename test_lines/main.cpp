@@ -0,0 +1,203 @@
+/**
+	@file   main.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Program test_lines.
+
+	Test reading lines of text by number.
+
+	Copyright (c) 2006 Wade Spires. All rights reserved.
+ */
+
+// c++ headers
+#include <iostream>
+#include <string>
+#include <vector>
+
+// tools headers
+#include "ws_tools.hpp"
+
+using std::cerr;  using std::cout;  using std::endl;
+using std::string;
+using std::vector;
+
+using namespace ws_tools;
+
+/**
+	@brief Structure for setting command-line options.
+
+	The following is a list of mandatory program options:
+
+	The following is a list of optional program options:
+		'-h' Display usage information.
+ */
+struct CL_Options
+{
+	CL_Options( int argc, char** argv )
+	: prog_name( argv[0] )
+	{
+		// set each option from command-line
+		while( --argc != 0 )
+		{
+			++argv;
+			if( argv == NULL )
+			{
+				print_usage();
+			}
+			string arg = *argv;
+
+			// by convention, options start with a dash
+			if( arg[0] == '-' )
+			{
+				if( arg.size() == 1 )
+				{
+					print_usage();
+				}
+
+				// handle each option type
+				switch( arg[1] )
+				{
+					// set '-h' option
+					case 'h':
+						print_usage();
+						break;
+
+					default:
+						print_usage();
+						break;
+				}
+			}
+		}
+	}
+
+	/**
+		Print error message showing program usage.
+	 */
+	void print_usage( )
+	{
+		cerr << "usage: " << get_file_name( prog_name )
+			<< " [ Options ]" << endl;
+		exit( EXIT_FAILURE );
+	}
+
+	string prog_name;  //< Name of program
+};
+
+void write_file( const string&, const string& );
+void print_lines( const Line_Index& );
+
+void test1( );
+void test2( );
+
+int main( int argc, char** argv )
+{
+	CL_Options options( argc, argv );
+
+	test1();
+	test2();
+
+	return( EXIT_SUCCESS );
+}
+
+/**
+	Write text to a file.
+ */
+void
+write_file( const string& file_name, const string& text )
+{
+	FILE* fp = open_file( file_name, "w" );
+	fwrite( text.data(), 1, text.size(), fp );
+	close_file( fp );
+}
+
+/**
+	Print each line with its offset.
+ */
+void
+print_lines( const Line_Index& index )
+{
+	cout << "  " << index.num_lines() << " lines" << endl;
+	for( size_t i = 0; i != index.num_lines(); ++i )
+	{
+		cout << "  " << i << " @" << index.line_offset( i ) << ": ["
+			<< index.line( i ) << "]" << endl;
+	}
+}
+
+/**
+	Line endings, empty lines, and ranges of lines in memory.
+ */
+void
+test1( )
+{
+	cout << "Test 1 -- line endings" << endl;
+
+	const string text = "first\r\n\nthird\r\n\r\nlast\n";
+	Line_Index index( text.data(), text.size() );
+	print_lines( index );
+	cout << "  lines 1-3: [" << index.lines( 1, 4 ) << "]" << endl;
+	cout << "  offset 9 is on line " << index.line_number( 9 ) << endl;
+
+	const string no_newline = "one\ntwo";
+	print_lines( Line_Index( no_newline.data(), no_newline.size() ) );
+
+	print_lines( Line_Index( "", 0 ) );
+	cout << endl;
+}
+
+/**
+	Index a large sorted file with one thread and with several threads, then
+	binary search it.
+ */
+void
+test2( )
+{
+	cout << "Test 2 -- sorted file, serial and parallel" << endl;
+
+	// several MB so that the parallel scan splits the file into chunks
+	const unsigned num_lines = 300000;
+	string text;
+	vector<size_t> offsets;
+	for( unsigned i = 0; i != num_lines; ++i )
+	{
+		offsets.push_back( text.size() );
+		append_values( text, "key ", format_string( "%08u", 3 * i ),
+				" value ", i % 97, "\n" );
+	}
+	const string file_name = "test2.txt";
+	write_file( file_name, text );
+
+	for( unsigned num_threads = 1; num_threads <= 4; num_threads += 3 )
+	{
+		Line_Index index( file_name, num_threads );
+
+		unsigned num_errors = 0;
+		for( unsigned i = 0; i != num_lines; ++i )
+		{
+			if( index.line_offset( i ) != offsets[i]
+					|| index.line( i ).size() + 1 != text.find( '\n', offsets[i] )
+						- offsets[i] + 1
+					|| index.line_number( offsets[i] + 3 ) != i )
+			{
+				++num_errors;
+			}
+		}
+		cout << "  " << num_threads << " thread(s): " << index.num_lines()
+			<< " lines, " << num_errors << " errors" << endl;
+	}
+
+	Line_Index index( file_name );
+	const char* keys[] = { "key 00000000", "key 00000300", "key 00000301",
+		"key 00899997", "key 99999999" };
+	for( unsigned i = 0; i != 5; ++i )
+	{
+		const size_t n = index.lower_bound( keys[i] );
+		cout << "  lower_bound( " << keys[i] << " ) = " << n;
+		if( n != index.num_lines() )
+		{
+			cout << ": [" << index.line( n ) << "]";
+		}
+		cout << endl;
+	}
+	cout << endl;
+}
@@ -87,6 +87,7 @@ void test4( );
 void test5( );
 void test6( );
 void test7( );
+void test8( );
 
 int main( int argc, char** argv )
 {
@@ -99,6 +100,7 @@ int main( int argc, char** argv )
 	test5();
 	test6();
 	test7();
+	test8();
 
 	return( EXIT_SUCCESS );
 }
@@ -248,3 +250,38 @@ void test7( )
 	cout << endl;
 	cout << endl;
 }
+
+/**
+	Lex whole lines: comments, both quote types, escapes, and whitespace that
+	must be kept.
+ */
+void test8( )
+{
+	const char* lines[] = {
+		"name Wade Spires  # comment",
+		"dir '~/some  dir'  # two spaces are kept",
+		"path \"/tmp/a # b\" # comment character inside quotes",
+		"msg \"say \\\"hi\\\"\\tnow\"",
+		"glued=\"a b\"'c d'e",
+		"empty '' \"\"",
+		"hey, 'wade and miko' and 'however' else.",
+		"hey, 'wade ",
+		"   # only a comment"
+	};
+	const unsigned num_lines = sizeof(lines) / sizeof(lines[0]);
+
+	cout << "test8" << endl;
+
+	vector<string> words;  // reused for every line
+	for( unsigned i = 0; i != num_lines; ++i )
+	{
+		cout << lines[i] << endl;
+		const unsigned num_words = lex_line( lines[i], words );
+		for( unsigned j = 0; j != num_words; ++j )
+		{
+			cout << "[" << words[j] << "]";
+		}
+		cout << endl << endl;
+	}
+	cout << endl;
+}
@@ -8,10 +8,18 @@
  */
 
 // c++ headers
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <random>
 #include <string>
 #include <vector>
 
+// c headers
+#include <cmath>
+#include <ctime>
+
 // tools headers
 #include "ws_tools.hpp"
 
@@ -21,6 +29,18 @@ using std::vector;
 
 using namespace ws_tools;
 
+void test_engines( );
+void test_fill( );
+void test_ziggurat( );
+void test_streams( );
+void test_counter( );
+void test_templates( );
+void test_distributions( );
+void test_discrete( );
+void test_integers( );
+void test_reservoir( );
+void print_moments( const string&, Random_Number&, double, double );
+
 /**
 	@brief Structure for setting command-line options.
 
@@ -146,5 +166,877 @@ int main( int argc, char** argv )
 	}
 	cout << endl;
 
+	test_engines();
+	test_fill();
+	test_ziggurat();
+	test_streams();
+	test_counter();
+	test_templates();
+	test_distributions();
+	test_discrete();
+	test_integers();
+	test_reservoir();
+
 	return( EXIT_SUCCESS );
 }
+
+/**
+	Show the first numbers from each engine for a fixed seed, and the mean and
+	speed of uniform numbers drawn with each.
+ */
+void test_engines( )
+{
+	const Random_Engine::Kind kinds[] = { Random_Engine::Xoshiro256ss,
+		Random_Engine::Xoshiro256p, Random_Engine::PCG64,
+		Random_Engine::Splitmix64, Random_Engine::Rand_R };
+	const char* names[] = { "xoshiro256**", "xoshiro256+", "pcg64",
+		"splitmix64", "rand_r" };
+
+	// SplitMix64 seeded with 0 starts with e220a8397b1dcdaf
+	cout << "First numbers from each engine with seed 0:" << endl;
+	for( unsigned i = 0; i != 5; ++i )
+	{
+		Random_Engine engine( 0, kinds[i] );
+		cout << std::setw( 13 ) << names[i] << ":" << std::hex;
+		for( unsigned j = 0; j != 3; ++j )
+		{
+			cout << " " << std::setw( 16 ) << std::setfill( '0' ) << engine();
+		}
+		cout << std::dec << std::setfill( ' ' ) << endl;
+	}
+	cout << endl;
+
+	// the same seed gives the same numbers
+	Uniform_Number u1( 0, 1, 42 );
+	Uniform_Number u2( 0, 1, 42 );
+	bool same = true;
+	for( unsigned i = 0; i != 1000; ++i )
+	{
+		same = same && (u1() == u2());
+	}
+	cout << "Same seed gives same numbers: " << same << endl << endl;
+
+	const unsigned num_numbers = 10000000;
+	cout << "Mean of " << num_numbers << " uniform numbers in [0,1):" << endl;
+	for( unsigned i = 0; i != 5; ++i )
+	{
+		Uniform_Number u( 0, 1, 1, kinds[i] );
+		const std::clock_t start = std::clock();
+		double sum = 0;
+		for( unsigned j = 0; j != num_numbers; ++j )
+		{
+			sum += u();
+		}
+		const double seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+		cout << std::setw( 13 ) << names[i] << ": " << sum / num_numbers
+			<< " (" << num_numbers / 1e6 / seconds << " million/s)" << endl;
+	}
+	cout << endl;
+}
+
+/**
+	Fill arrays with uniform and normal numbers, checking that the vector code
+	matches a single scalar generator and that the numbers do not depend on
+	how the array is split between calls.
+ */
+void test_fill( )
+{
+	// lane 0 is an xoshiro256** engine seeded the same way
+	const unsigned num_bits = 8 * 100 + 3;
+	vector<uint64_t> bits( num_bits );
+	Xoshiro256_Lanes lanes( 7 );
+	lanes.fill( &bits[0], num_bits );
+	Xoshiro256ss_Engine engine( 7 );
+	bool lane_matches = true;
+	for( unsigned i = 0; i < num_bits; i += Xoshiro256_Lanes::NUM_LANES )
+	{
+		lane_matches = lane_matches && (bits[i] == engine());
+	}
+	cout << "Lane 0 matches scalar xoshiro256**: " << lane_matches << endl;
+
+	// doubles are the upper 53 bits and do not depend on call sizes
+	Xoshiro256_Lanes lanes_2( 7 );
+	vector<double> unit( num_bits );
+	lanes_2.fill_unit( &unit[0], 5 );
+	lanes_2.fill_unit( &unit[5], 600 );
+	lanes_2.fill_unit( &unit[605], num_bits - 605 );
+	bool unit_matches = true;
+	for( unsigned i = 0; i != num_bits; ++i )
+	{
+		unit_matches = unit_matches && (unit[i] == to_unit_double( bits[i] ));
+	}
+	cout << "Split fills match bits: " << unit_matches << endl << endl;
+
+	const unsigned num_numbers = 10000000;
+	vector<double> numbers( num_numbers );
+
+	Uniform_Number u( 10, 15, 3 );
+	std::clock_t start = std::clock();
+	for( unsigned i = 0; i != num_numbers; ++i )
+	{
+		numbers[i] = u.next();
+	}
+	const double next_seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+	start = std::clock();
+	u.fill( numbers );
+	const double fill_seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+	double sum = 0;
+	double min = numbers[0];
+	double max = numbers[0];
+	for( unsigned i = 0; i != num_numbers; ++i )
+	{
+		sum += numbers[i];
+		min = std::min( min, numbers[i] );
+		max = std::max( max, numbers[i] );
+	}
+	cout << "Filled " << num_numbers << " uniform numbers in [10,15): mean "
+		<< sum / num_numbers << ", min " << min << ", max " << max << endl;
+	cout << "   next(): " << num_numbers / 1e6 / next_seconds
+		<< " million/s, fill(): " << num_numbers / 1e6 / fill_seconds
+		<< " million/s" << endl;
+
+	Normal_Number n( 2, 1.5, 3 );
+	start = std::clock();
+	n.fill( &numbers[0], num_numbers - 1 );
+	const double normal_seconds
+		= double( std::clock() - start ) / CLOCKS_PER_SEC;
+	sum = 0;
+	double sum_squares = 0;
+	for( unsigned i = 0; i != num_numbers - 1; ++i )
+	{
+		sum += numbers[i];
+		sum_squares += numbers[i] * numbers[i];
+	}
+	const double mean = sum / (num_numbers - 1);
+	cout << "Filled " << num_numbers - 1 << " normal numbers ~N(2,1.5): mean "
+		<< mean << ", std. dev. "
+		<< std::sqrt( sum_squares / (num_numbers - 1) - mean * mean )
+		<< " (" << (num_numbers - 1) / 1e6 / normal_seconds << " million/s)"
+		<< endl;
+
+	// filling one number at a time should cost about as much as next()
+	const unsigned num_calls = 1000000;
+	start = std::clock();
+	for( unsigned i = 0; i != num_calls; ++i )
+	{
+		n.fill( &numbers[i], 1 );
+	}
+	const double single_seconds
+		= double( std::clock() - start ) / CLOCKS_PER_SEC;
+	start = std::clock();
+	for( unsigned i = 0; i != num_calls; ++i )
+	{
+		numbers[i] = n.next();
+	}
+	const double normal_next_seconds
+		= double( std::clock() - start ) / CLOCKS_PER_SEC;
+	cout << "   fill() of 1 number: " << 1e9 * single_seconds / num_calls
+		<< " ns, next(): " << 1e9 * normal_next_seconds / num_calls << " ns"
+		<< endl << endl;
+}
+
+/**
+	Check the moments and tails of ziggurat normal and exponential numbers and
+	show how fast they are generated.
+ */
+void test_ziggurat( )
+{
+	const unsigned num_numbers = 10000000;
+	vector<double> numbers( num_numbers );
+
+	Normal_Number n( 0, 1, 11 );
+	std::clock_t start = std::clock();
+	for( unsigned i = 0; i != num_numbers; ++i )
+	{
+		numbers[i] = n.next();
+	}
+	const double next_seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+
+	double sums[4] = { 0, 0, 0, 0 };
+	unsigned num_tail = 0;
+	for( unsigned i = 0; i != num_numbers; ++i )
+	{
+		const double x = numbers[i];
+		sums[0] += x;
+		sums[1] += x * x;
+		sums[2] += x * x * x;
+		sums[3] += x * x * x * x;
+		num_tail += (std::fabs( x ) > 3.6541528853610088);
+	}
+	cout << "Ziggurat normal numbers ~N(0,1): mean " << sums[0] / num_numbers
+		<< ", variance " << sums[1] / num_numbers
+		<< ", skewness " << sums[2] / num_numbers
+		<< ", kurtosis " << sums[3] / num_numbers << " (3 expected)" << endl;
+	cout << "   fraction in tail: " << double( num_tail ) / num_numbers
+		<< " (0.000258 expected)" << endl;
+
+	start = std::clock();
+	n.fill( numbers );
+	const double fill_seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+	cout << "   next(): " << num_numbers / 1e6 / next_seconds
+		<< " million/s, fill(): " << num_numbers / 1e6 / fill_seconds
+		<< " million/s" << endl;
+
+	double fill_sums[2] = { 0, 0 };
+	num_tail = 0;
+	for( unsigned i = 0; i != num_numbers; ++i )
+	{
+		const double x = numbers[i];
+		fill_sums[0] += x;
+		fill_sums[1] += x * x;
+		num_tail += (std::fabs( x ) > 3.6541528853610088);
+	}
+	cout << "   fill(): mean " << fill_sums[0] / num_numbers
+		<< ", variance " << fill_sums[1] / num_numbers
+		<< ", fraction in tail: " << double( num_tail ) / num_numbers << endl;
+
+	Exponential_Number e( 2, 11 );
+	start = std::clock();
+	e.fill( numbers );
+	const double exp_seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+	double sum = 0;
+	unsigned num_above = 0;
+	for( unsigned i = 0; i != num_numbers; ++i )
+	{
+		sum += numbers[i];
+		num_above += (numbers[i] > 0.5);
+	}
+	cout << "Ziggurat exponential numbers with rate 2: mean " << sum / num_numbers
+		<< ", fraction above 0.5: " << double( num_above ) / num_numbers
+		<< " (0.367879 expected)" << endl;
+	cout << "   fill(): " << num_numbers / 1e6 / exp_seconds << " million/s"
+		<< endl << endl;
+}
+
+/**
+	Give each parallel task its own stream from one master seed and check that
+	the results do not depend on the number of threads.
+ */
+void test_streams( )
+{
+	// PCG64's advance() matches stepping one number at a time
+	PCG64_Engine stepped( 5 );
+	PCG64_Engine advanced( 5 );
+	for( unsigned i = 0; i != 1000; ++i )
+	{
+		stepped();
+	}
+	advanced.advance( 1000 );
+	cout << "PCG64 advance matches steps: " << (stepped() == advanced())
+		<< endl;
+
+	// jumping many streams at once matches jumping one at a time, and a
+	// distant stream is as fast to seed as a near one
+	Xoshiro256ss_Engine jumped( 5 );
+	Xoshiro256ss_Engine jumped_once( 5 );
+	for( unsigned i = 0; i != 13; ++i )
+	{
+		jumped.long_jump();
+	}
+	jumped_once.long_jump( 13 );
+	cout << "Xoshiro256 long_jump(13) matches 13 long jumps: "
+		<< (jumped() == jumped_once()) << endl;
+	Uniform_Number far( 0, 1, 0 );
+	const std::clock_t start = std::clock();
+	far.seed( 5, 1000000000000ULL );
+	cout << "   seeding stream 10^12: "
+		<< double( std::clock() - start ) / CLOCKS_PER_SEC * 1e3 << " ms" << endl;
+
+	// default seeds differ even for generators created together
+	Uniform_Number u1;
+	Uniform_Number u2;
+	cout << "Default-seeded generators differ: " << (u1() != u2()) << endl;
+
+	const unsigned num_tasks = 16;
+	const Stream_Splitter streams( 2026 );
+	vector<double> sums[2];
+	const unsigned num_threads[2] = { 1, 4 };
+	for( unsigned t = 0; t != 2; ++t )
+	{
+		vector<double>& sum = sums[t];
+		sum.assign( num_tasks, 0 );
+		parallel_for( num_tasks, num_threads[t], [&]( std::size_t task )
+			{
+				Normal_Number noise;
+				streams.seed( noise, task );
+				for( unsigned i = 0; i != 1000; ++i )
+				{
+					sum[task] += noise();
+				}
+			} );
+	}
+	unsigned num_distinct = 0;
+	for( unsigned i = 0; i != num_tasks; ++i )
+	{
+		num_distinct += (std::count( sums[0].begin(), sums[0].end(),
+					sums[0][i] ) == 1);
+	}
+	cout << "Streams of " << num_tasks << " tasks same with 1 and 4 threads: "
+		<< (sums[0] == sums[1]) << ", distinct: " << num_distinct << endl;
+	cout << "   stream 0 sum: " << sums[0][0] << ", stream 1 sum: "
+		<< sums[0][1] << endl;
+
+	// an engine from the splitter matches a generator seeded with it
+	Random_Engine engine = streams.engine( 3 );
+	Uniform_Number u3( 0, 1, 0 );
+	streams.seed( u3, 3 );
+	cout << "Splitter engine matches seeded generator: "
+		<< (to_unit_double( engine() ) == u3()) << endl << endl;
+}
+
+/**
+	Check Philox4x32-10 against published answers and show that numbers can be
+	computed for any item and index directly.
+ */
+void test_counter( )
+{
+	// known answers from the Random123 distribution (key, counter, block)
+	const uint64_t keys[3] = { 0, ~uint64_t( 0 ), 0x299F31D0A4093822ULL };
+	const uint64_t counters[3][2] = { { 0, 0 }, { ~uint64_t( 0 ), ~uint64_t( 0 ) },
+		{ 0x0370734413198A2EULL, 0x85A308D3243F6A88ULL } };
+	const uint64_t answers[3][2] = {
+		{ 0xE169C58D6627E8D5ULL, 0x9B00DBD8BC57AC4CULL },
+		{ 0x41C83B0E408F276DULL, 0x6D5451FDA20BC7C6ULL },
+		{ 0x94FDCCEBD16CFE09ULL, 0x24126EA15001E420ULL } };
+	bool known = true;
+	for( unsigned i = 0; i != 3; ++i )
+	{
+		uint64_t block[2];
+		Philox4x32_Engine( keys[i] ).block( counters[i][0], counters[i][1],
+				block );
+		known = known && block[0] == answers[i][0] && block[1] == answers[i][1];
+	}
+	cout << "Philox4x32-10 known answers: " << known << endl;
+
+	// bulk blocks match single blocks, including a carry into the upper word
+	Philox4x32_Engine philox( 99 );
+	vector<uint64_t> bulk( 2 * 13 );
+	philox.blocks( 4, 0xFFFFFFFEULL, 13, &bulk[0] );
+	bool bulk_matches = true;
+	for( unsigned i = 0; i != 13; ++i )
+	{
+		uint64_t block[2];
+		philox.block( 4, 0xFFFFFFFEULL + i, block );
+		bulk_matches = bulk_matches && block[0] == bulk[2 * i]
+			&& block[1] == bulk[2 * i + 1];
+	}
+	cout << "Bulk blocks match single blocks: " << bulk_matches << endl;
+
+	// numbers of an item do not depend on the order they are computed in
+	Counter_Number c( 2026 );
+	vector<double> numbers( 1001 );
+	c.fill_at( 5, 3, &numbers[0], numbers.size() );
+	bool at_matches = true;
+	for( unsigned i = numbers.size(); i-- != 0; )
+	{
+		at_matches = at_matches && (numbers[i] == c.at( 5, 3 + i ));
+	}
+	c.seek( 5, 3 );
+	at_matches = at_matches && (c() == numbers[0]) && (c() == numbers[1]);
+	cout << "Random access matches bulk fill: " << at_matches << endl;
+
+	// a generator per item is cheap since it holds only the Philox key and
+	// counter, and seeding it with a stream starts that stream
+	std::clock_t start = std::clock();
+	double item_sum = 0;
+	for( unsigned i = 0; i != 1000000; ++i )
+	{
+		Counter_Number item( i );
+		item_sum += item();
+	}
+	const double item_seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+	Counter_Number seeded;
+	seeded.seed( 2026, 5 );
+	cout << "Seeded stream matches random access: "
+		<< (seeded() == c.at( 5, 0 )) << endl;
+	cout << "   " << sizeof(Counter_Number) << " bytes, "
+		<< item_seconds * 1e3 << " ns per construction and number (mean "
+		<< item_sum / 1000000 << ")" << endl;
+
+	const unsigned num_numbers = 10000000;
+	numbers.resize( num_numbers );
+	c.seek( 0, 0 );
+	start = std::clock();
+	c.fill( numbers );
+	const double seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+	double sum = 0;
+	for( unsigned i = 0; i != num_numbers; ++i )
+	{
+		sum += numbers[i];
+	}
+	cout << "Counter-based uniform numbers: mean " << sum / num_numbers
+		<< " (" << num_numbers / 1e6 / seconds << " million/s)" << endl << endl;
+}
+
+/**
+	Compare the virtual generators with generators whose engine and
+	distribution are template parameters, which should give the same numbers
+	for the same seed.
+ */
+void test_templates( )
+{
+	const unsigned num_numbers = 10000000;
+	vector<double> virtual_numbers( num_numbers );
+	vector<double> template_numbers( num_numbers );
+
+	Normal_Number n( 2, 1.5, 11 );
+	Random_Number& r = n;
+	std::clock_t start = std::clock();
+	for( unsigned i = 0; i != num_numbers; ++i )
+	{
+		virtual_numbers[i] = r.next();
+	}
+	const double virtual_seconds
+		= double( std::clock() - start ) / CLOCKS_PER_SEC;
+
+	Random_Generator<Xoshiro256ss_Engine, Normal_Distribution> g(
+		Normal_Distribution( 2, 1.5 ), 11 );
+	start = std::clock();
+	for( unsigned i = 0; i != num_numbers; ++i )
+	{
+		template_numbers[i] = g();
+	}
+	const double template_seconds
+		= double( std::clock() - start ) / CLOCKS_PER_SEC;
+	cout << "Normal numbers match: " << (virtual_numbers == template_numbers)
+		<< endl;
+	cout << "   virtual next(): " << num_numbers / 1e6 / virtual_seconds
+		<< " million/s, template: " << num_numbers / 1e6 / template_seconds
+		<< " million/s" << endl;
+
+	Uniform_Number u( -1, 1, 12 );
+	Random_Number& s = u;
+	start = std::clock();
+	for( unsigned i = 0; i != num_numbers; ++i )
+	{
+		virtual_numbers[i] = s.next();
+	}
+	const double uniform_virtual_seconds
+		= double( std::clock() - start ) / CLOCKS_PER_SEC;
+
+	Random_Generator<Xoshiro256ss_Engine, Uniform_Distribution> h(
+		Uniform_Distribution( -1, 1 ), 12 );
+	start = std::clock();
+	h.fill( &template_numbers[0], num_numbers );
+	const double uniform_template_seconds
+		= double( std::clock() - start ) / CLOCKS_PER_SEC;
+	cout << "Uniform numbers match: " << (virtual_numbers == template_numbers)
+		<< endl;
+	cout << "   virtual next(): " << num_numbers / 1e6 / uniform_virtual_seconds
+		<< " million/s, template: "
+		<< num_numbers / 1e6 / uniform_template_seconds << " million/s" << endl
+		<< endl;
+}
+
+/**
+	Print the mean and variance of numbers drawn from a generator next to
+	their expected values, and show how fast they are generated.
+	@param[in] name Name of the distribution
+	@param[in,out] r Generator
+	@param[in] mean Expected mean
+	@param[in] variance Expected variance
+ */
+void print_moments( const string& name, Random_Number& r, double mean,
+		double variance )
+{
+	const unsigned num_numbers = 4000000;
+	vector<double> numbers( num_numbers );
+	const std::clock_t start = std::clock();
+	r.fill( numbers );
+	const double seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+	double sum = 0;
+	double sum_squares = 0;
+	for( unsigned i = 0; i != num_numbers; ++i )
+	{
+		sum += numbers[i];
+		sum_squares += numbers[i] * numbers[i];
+	}
+	const double sample_mean = sum / num_numbers;
+	cout << name << ": mean " << sample_mean << " (" << mean << "), variance "
+		<< sum_squares / num_numbers - sample_mean * sample_mean << " ("
+		<< variance << "), " << num_numbers / 1e6 / seconds << " million/s"
+		<< endl;
+}
+
+/**
+	Check the moments of gamma, Poisson, and binomial numbers on both sides of
+	each sampler's switch between methods.
+ */
+void test_distributions( )
+{
+	Gamma_Number g_1( 0.5, 2, 21 );
+	print_moments( "Gamma(0.5,2)", g_1, 1, 2 );
+	Gamma_Number g_2( 3, 1.5, 22 );
+	print_moments( "Gamma(3,1.5)", g_2, 4.5, 6.75 );
+
+	Poisson_Number p_1( 3, 23 );
+	print_moments( "Poisson(3)", p_1, 3, 3 );
+	Poisson_Number p_2( 250, 24 );
+	print_moments( "Poisson(250)", p_2, 250, 250 );
+
+	Binomial_Number b_1( 20, 0.3, 25 );
+	print_moments( "Binomial(20,0.3)", b_1, 6, 4.2 );
+	Binomial_Number b_2( 1000, 0.7, 26 );
+	print_moments( "Binomial(1000,0.7)", b_2, 700, 210 );
+	Binomial_Number b_3( 40, 0.5, 27 );
+	print_moments( "Binomial(40,0.5)", b_3, 20, 10 );
+
+	// the template generator gives the same numbers as the adapter
+	Poisson_Number p_3( 40, 28 );
+	Random_Generator<Xoshiro256ss_Engine, Poisson_Distribution> p_4(
+		Poisson_Distribution( 40 ), 28 );
+	bool matches = true;
+	for( unsigned i = 0; i != 1000; ++i )
+	{
+		matches = matches && (p_3() == double( p_4() ));
+	}
+	cout << "Poisson adapter matches template generator: " << matches << endl;
+
+	// a generator passed as the engine lends its engine's bits rather than
+	// its doubles
+	Uniform_Number u( 0, 1, 29 );
+	Uniform_Number u_copy( 0, 1, 29 );
+	matches = true;
+	for( unsigned i = 0; i != 1000; ++i )
+	{
+		matches = matches
+			&& Normal_Distribution()( u ) == Normal_Distribution()( u_copy.engine() )
+			&& Gamma_Distribution( 2, 1 )( u )
+				== Gamma_Distribution( 2, 1 )( u_copy.engine() )
+			&& Binomial_Distribution( 50, 0.3 )( u )
+				== Binomial_Distribution( 50, 0.3 )( u_copy.engine() );
+	}
+	cout << "Distributions of a generator match its engine: " << matches
+		<< endl << endl;
+}
+
+/**
+	Compare sampling from an alias table with a binary search of the
+	cumulative distribution, and check the frequencies of the samples.
+ */
+void test_discrete( )
+{
+	const unsigned num_items = 100000;
+	vector<double> weights( num_items );
+	for( unsigned i = 0; i != num_items; ++i )
+	{
+		weights[i] = (i % 10 == 0) ? 0 : double( i % 1000 + 1 );
+	}
+
+	std::clock_t start = std::clock();
+	Discrete_Distribution d( weights );
+	const double build_seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+
+	const unsigned num_samples = 10000000;
+	vector<std::size_t> samples( num_samples );
+	Xoshiro256_Lanes lanes( 31 );
+	Lane_Bits bits( lanes );
+	start = std::clock();
+	d.sample( bits, &samples[0], num_samples );
+	const double alias_seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+
+	// frequencies of the weight classes i % 1000 should be proportional to
+	// their weights, with items whose weight is 0 never chosen
+	vector<double> counts( 1000 );
+	bool zero_chosen = false;
+	for( unsigned i = 0; i != num_samples; ++i )
+	{
+		zero_chosen = zero_chosen || (weights[samples[i]] == 0);
+		counts[samples[i] % 1000] += 1;
+	}
+	double max_error = 0;
+	for( unsigned i = 1; i != 1000; ++i )
+	{
+		if( i % 10 != 0 )
+		{
+			double p = 0;
+			for( unsigned j = i; j < num_items; j += 1000 )
+			{
+				p += d.probability( j );
+			}
+			max_error = std::max( max_error,
+					std::fabs( counts[i] - p * num_samples )
+					/ std::sqrt( p * num_samples ) );
+		}
+	}
+	cout << "Alias table: items with weight 0 chosen: " << zero_chosen
+		<< ", largest error " << max_error << " std. dev." << endl;
+
+	// binary search of the cumulative distribution
+	vector<double> cdf( num_items );
+	double sum = 0;
+	for( unsigned i = 0; i != num_items; ++i )
+	{
+		sum += weights[i];
+		cdf[i] = sum;
+	}
+	Uniform_Number u( 0, sum, 32 );
+	start = std::clock();
+	for( unsigned i = 0; i != num_samples; ++i )
+	{
+		samples[i] = std::upper_bound( cdf.begin(), cdf.end(), u() )
+			- cdf.begin();
+	}
+	const double search_seconds
+		= double( std::clock() - start ) / CLOCKS_PER_SEC;
+
+	// rebuilding reuses the table's memory
+	weights[7] = 1e6;
+	start = std::clock();
+	d.weights( weights );
+	const double rebuild_seconds
+		= double( std::clock() - start ) / CLOCKS_PER_SEC;
+	Xoshiro256ss_Engine engine( 33 );
+	unsigned num_7 = 0;
+	for( unsigned i = 0; i != 100000; ++i )
+	{
+		num_7 += (d( engine ) == 7);
+	}
+	cout << "   After raising item 7 to probability " << d.probability( 7 )
+		<< ": frequency " << num_7 / 100000.0 << endl;
+	cout << "   alias: " << num_samples / 1e6 / alias_seconds
+		<< " million/s, binary search: " << num_samples / 1e6 / search_seconds
+		<< " million/s (" << num_items << " items)" << endl;
+	cout << "   build: " << build_seconds * 1e3 << " ms, rebuild: "
+		<< rebuild_seconds * 1e3 << " ms" << endl << endl;
+}
+
+/**
+	Check that bounded integers are exact over small and full ranges, and
+	compare them, the shuffle, and Floyd's sampling with the alternatives.
+ */
+void test_integers( )
+{
+	Xoshiro256ss_Engine engine( 41 );
+
+	Uniform_Int_Distribution<int> die( 1, 6 );
+	vector<unsigned> counts( 7 );
+	for( unsigned i = 0; i != 600000; ++i )
+	{
+		++counts[die( engine )];
+	}
+	cout << "Die rolls:";
+	for( unsigned i = 1; i != 7; ++i )
+	{
+		cout << " " << counts[i];
+	}
+	cout << " (100000 expected)" << endl;
+
+	// a range of 3 * 2^62: scaling a double, which has 53 bits, cannot give
+	// every value, but bounded integers are exact
+	const uint64_t bound = 3ULL << 62;
+	Uniform_Int_Distribution<uint64_t> big( 0, bound - 1 );
+	unsigned num_low        = 0;
+	unsigned num_odd        = 0;
+	unsigned num_scaled_odd = 0;
+	Uniform_Number u( 0, 1, 42 );
+	for( unsigned i = 0; i != 300000; ++i )
+	{
+		const uint64_t x = big( engine );
+		num_low += (x < (1ULL << 62));
+		num_odd += (x & 1);
+		num_scaled_odd += (uint64_t( u() * bound ) & 1);
+	}
+	cout << "Range of 3 * 2^62: first third " << num_low / 300000.0
+		<< " (1/3 expected), odd " << num_odd / 300000.0
+		<< " (scaled doubles odd " << num_scaled_odd / 300000.0 << ")" << endl;
+
+	Uniform_Int_Distribution<int64_t> full( INT64_MIN, INT64_MAX );
+	unsigned num_negative = 0;
+	for( unsigned i = 0; i != 100000; ++i )
+	{
+		num_negative += (full( engine ) < 0);
+	}
+	cout << "Full 64-bit range: negative " << num_negative / 100000.0 << endl;
+
+	// bounded integers versus scaled uniform doubles
+	const unsigned num_numbers = 10000000;
+	vector<int64_t> numbers( num_numbers );
+	Uniform_Int_Distribution<int64_t> d( 0, 999999 );
+	Xoshiro256_Lanes lanes( 43 );
+	Lane_Bits bits( lanes );
+	std::clock_t start = std::clock();
+	d.sample( bits, &numbers[0], num_numbers );
+	const double batch_seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+	start = std::clock();
+	for( unsigned i = 0; i != num_numbers; ++i )
+	{
+		numbers[i] = int64_t( u() * 1000000 );
+	}
+	const double scaled_seconds
+		= double( std::clock() - start ) / CLOCKS_PER_SEC;
+	cout << "   [0,999999] batch: " << num_numbers / 1e6 / batch_seconds
+		<< " million/s, scaled Uniform_Number: "
+		<< num_numbers / 1e6 / scaled_seconds << " million/s" << endl;
+
+	// every position of a shuffled array is equally likely to hold an item
+	vector<unsigned> first_counts( 5 );
+	for( unsigned i = 0; i != 100000; ++i )
+	{
+		unsigned items[5] = { 0, 1, 2, 3, 4 };
+		shuffle( items, items + 5, engine );
+		++first_counts[items[0]];
+	}
+	cout << "Shuffled first items:";
+	for( unsigned i = 0; i != 5; ++i )
+	{
+		cout << " " << first_counts[i];
+	}
+	cout << " (20000 expected)" << endl;
+
+	vector<unsigned> items( num_numbers );
+	for( unsigned i = 0; i != num_numbers; ++i )
+	{
+		items[i] = i;
+	}
+	start = std::clock();
+	shuffle( items.begin(), items.end(), engine );
+	const double shuffle_seconds
+		= double( std::clock() - start ) / CLOCKS_PER_SEC;
+	std::mt19937_64 mersenne( 44 );
+	start = std::clock();
+	std::shuffle( items.begin(), items.end(), mersenne );
+	const double std_seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+	cout << "   shuffle of " << num_numbers << " items: "
+		<< shuffle_seconds * 1e3 << " ms, std::shuffle with mt19937_64: "
+		<< std_seconds * 1e3 << " ms" << endl;
+
+	vector<uint64_t> chosen;
+	sample_without_replacement( engine, 1ULL << 40, 100000, chosen );
+	vector<uint64_t> sorted = chosen;
+	std::sort( sorted.begin(), sorted.end() );
+	cout << "Floyd sampled " << chosen.size() << " of 2^40: distinct "
+		<< (std::unique( sorted.begin(), sorted.end() ) == sorted.end())
+		<< ", in range " << (sorted.back() < (1ULL << 40)) << endl;
+	sample_without_replacement( engine, 10, 10, chosen );
+	std::sort( chosen.begin(), chosen.end() );
+	bool all = true;
+	for( unsigned i = 0; i != 10; ++i )
+	{
+		all = all && (chosen[i] == i);
+	}
+	cout << "Floyd sampled all 10 of 10: " << all << endl << endl;
+}
+
+/**
+	Engine that counts the random numbers drawn from it.
+ */
+struct Counting_Engine
+{
+	Counting_Engine( uint64_t seed )
+	: engine( seed ), count( 0 )
+	{ }
+
+	uint64_t operator()( )
+	{
+		++count;
+		return( engine() );
+	}
+
+	Xoshiro256ss_Engine engine;
+	uint64_t            count;
+};
+
+/**
+	Check that reservoir samples include each item equally often (or in
+	proportion to its weight) and show how few random numbers they use.
+ */
+void test_reservoir( )
+{
+	Xoshiro256ss_Engine engine( 51 );
+	vector<unsigned> items( 100 );
+	for( unsigned i = 0; i != items.size(); ++i )
+	{
+		items[i] = i;
+	}
+	vector<unsigned> counts( items.size() );
+	for( unsigned i = 0; i != 100000; ++i )
+	{
+		const vector<unsigned> sample
+			= reservoir_sample( items.begin(), items.end(), 10, engine );
+		for( unsigned j = 0; j != sample.size(); ++j )
+		{
+			++counts[sample[j]];
+		}
+	}
+	cout << "Reservoir of 10 of 100 items: item 0 " << counts[0] << ", item 10 "
+		<< counts[10] << ", item 99 " << counts[99] << " (10000 expected)"
+		<< endl;
+
+	// a generator can be passed in place of an engine, and then its engine is
+	// used
+	Uniform_Number u( 0, 1, 54 );
+	const vector<unsigned> from_generator
+		= reservoir_sample( items.begin(), items.end(), 5, u );
+	Uniform_Number u_copy( 0, 1, 54 );
+	const vector<unsigned> from_engine
+		= reservoir_sample( items.begin(), items.end(), 5, u_copy.engine() );
+	cout << "Reservoir from a generator matches its engine: "
+		<< (from_generator == from_engine) << endl;
+
+	// a stream of a billion items, of which only the taken ones are read
+	Counting_Engine counter( 52 );
+	Reservoir_Sampler<uint64_t> sampler( 100 );
+	const uint64_t num_items = 1000000000;
+	std::clock_t start = std::clock();
+	while( sampler.count() != num_items )
+	{
+		const uint64_t num_to_skip
+			= std::min( sampler.num_to_skip(), num_items - sampler.count() );
+		if( num_to_skip != 0 )
+		{
+			sampler.skip( num_to_skip );
+		}
+		else
+		{
+			sampler.add( sampler.count(), counter );
+		}
+	}
+	double seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+	cout << "   100 of " << num_items << " items: " << counter.count
+		<< " random numbers, " << seconds * 1e3 << " ms" << endl;
+
+	// weighted: with k = 1, items are chosen in proportion to their weights
+	vector<unsigned> weighted_counts( 4 );
+	for( unsigned i = 0; i != 100000; ++i )
+	{
+		const vector<unsigned> sample = weighted_reservoir_sample(
+				items.begin(), items.begin() + 4, 1,
+				[]( unsigned item ) { return( double( item ) ); }, engine );
+		++weighted_counts[sample[0]];
+	}
+	cout << "Weighted reservoir of 1 of items weighted 0-3:";
+	for( unsigned i = 0; i != 4; ++i )
+	{
+		cout << " " << weighted_counts[i];
+	}
+	cout << " (0, 16667, 33333, 50000 expected)" << endl;
+
+	Counting_Engine weighted_counter( 53 );
+	Weighted_Reservoir_Sampler<unsigned> weighted( 100 );
+	start = std::clock();
+	for( unsigned i = 0; i != 10000000; ++i )
+	{
+		weighted.add( i, 1 + (i % 7), weighted_counter );
+	}
+	seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+	cout << "   100 of 10000000 weighted items: " << weighted_counter.count
+		<< " random numbers, " << seconds * 1e3 << " ms" << endl;
+
+	std::stringstream lines;
+	for( unsigned i = 0; i != 100000; ++i )
+	{
+		lines << "line " << i << "\n";
+	}
+	const vector<string> sampled_lines = sample_lines( lines, 3, engine );
+	cout << "Sampled lines:";
+	for( unsigned i = 0; i != sampled_lines.size(); ++i )
+	{
+		cout << " '" << sampled_lines[i] << "'";
+	}
+	cout << endl;
+
+	Dir_Walker walker( "." );
+	cout << "Sampled " << sample_files( walker, 2, engine ).size()
+		<< " files of the current directory" << endl << endl;
+}
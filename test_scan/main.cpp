@@ -0,0 +1,253 @@
+/**
+	@file   main.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Program test_scan.
+
+	Test searching file contents.
+
+	Copyright (c) 2006 Wade Spires. All rights reserved.
+ */
+
+// c++ headers
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// tools headers
+#include "ws_tools.hpp"
+
+using std::cerr;  using std::cout;  using std::endl;
+using std::string;
+using std::vector;
+
+using namespace ws_tools;
+
+/**
+	@brief Structure for setting command-line options.
+
+	The following is a list of mandatory program options:
+
+	The following is a list of optional program options:
+		'-h' Display usage information.
+ */
+struct CL_Options
+{
+	CL_Options( int argc, char** argv )
+	: prog_name( argv[0] )
+	{
+		// set each option from command-line
+		while( --argc != 0 )
+		{
+			++argv;
+			if( argv == NULL )
+			{
+				print_usage();
+			}
+			string arg = *argv;
+
+			// by convention, options start with a dash
+			if( arg[0] == '-' )
+			{
+				if( arg.size() == 1 )
+				{
+					print_usage();
+				}
+
+				// handle each option type
+				switch( arg[1] )
+				{
+					// set '-h' option
+					case 'h':
+						print_usage();
+						break;
+
+					default:
+						print_usage();
+						break;
+				}
+			}
+		}
+	}
+
+	/**
+		Print error message showing program usage.
+	 */
+	void print_usage( )
+	{
+		cerr << "usage: " << get_file_name( prog_name )
+			<< " [ Options ]" << endl;
+		exit( EXIT_FAILURE );
+	}
+
+	string prog_name;  //< Name of program
+};
+
+void test1( );
+void test2( );
+
+int main( int argc, char** argv )
+{
+	CL_Options options( argc, argv );
+
+	test1();
+	test2();
+
+	return( EXIT_SUCCESS );
+}
+
+/**
+	Compare matcher against a simple search of each position for each pattern.
+	@param[in] text Text to search
+	@param[in] patterns Patterns to find
+	@retval num_errors Number of differences
+ */
+unsigned
+check_matches( const string& text, const vector<string>& patterns )
+{
+	vector<Literal_Matcher::Match> expected;
+	for( size_t i = 0; i != text.size(); ++i )
+	{
+		for( unsigned k = 0; k != patterns.size(); ++k )
+		{
+			if( text.compare( i, patterns[k].size(), patterns[k] ) == 0 )
+			{
+				expected.push_back( Literal_Matcher::Match{ i, k } );
+			}
+		}
+	}
+
+	Literal_Matcher matcher( patterns );
+	vector<Literal_Matcher::Match> matches;
+	matcher.find_all( text.data(), text.size(), matches );
+
+	// matches at the same offset may be in any order
+	auto less = []( const Literal_Matcher::Match& a,
+			const Literal_Matcher::Match& b )
+		{
+			return( a.offset < b.offset
+				|| (a.offset == b.offset && a.pattern < b.pattern) );
+		};
+	std::stable_sort( matches.begin(), matches.end(), less );
+
+	unsigned num_errors = 0;
+	if( matches.size() != expected.size() )
+	{
+		++num_errors;
+	}
+	for( size_t i = 0; i != std::min( matches.size(), expected.size() ); ++i )
+	{
+		if( matches[i].offset != expected[i].offset
+				|| matches[i].pattern != expected[i].pattern )
+		{
+			++num_errors;
+		}
+	}
+	cout << "  " << patterns.size() << " pattern(s): " << matches.size()
+		<< " matches, " << num_errors << " errors" << endl;
+	return( num_errors );
+}
+
+/**
+	Find one and several patterns in random text.
+ */
+void
+test1( )
+{
+	cout << "Test 1 -- literal matching" << endl;
+
+	// small alphabet so that patterns occur often
+	Uniform_Number uniform( 0, 5 );
+	string text;
+	for( unsigned i = 0; i != 100000; ++i )
+	{
+		text += "abcd\n"[ static_cast<unsigned>( uniform.next() ) % 5 ];
+	}
+
+	check_matches( text, vector<string>( 1, "c" ) );
+	check_matches( text, vector<string>( 1, "abca" ) );
+	check_matches( text, vector<string>( 1, "dd\nab" ) );
+
+	vector<string> patterns;
+	patterns.push_back( "abc" );
+	patterns.push_back( "d\nd" );
+	patterns.push_back( "bbbbbb" );
+	check_matches( text, patterns );
+
+	for( unsigned i = 0; i != 20; ++i )
+	{
+		string pattern;
+		for( unsigned j = 0; j != 2 + i % 6; ++j )
+		{
+			pattern += "abcd\n"[ static_cast<unsigned>( uniform.next() ) % 5 ];
+		}
+		patterns.push_back( pattern );
+	}
+	check_matches( text, patterns );
+
+	patterns.push_back( "a" );
+	check_matches( text, patterns );
+
+	Literal_Matcher matcher( patterns );
+	cout << "  contains: " << matcher.contains( text.data(), text.size() )
+		<< " " << matcher.contains( "xyz", 3 ) << endl;
+	cout << endl;
+}
+
+/**
+	Search the files of a directory tree with one thread and with several
+	threads.
+ */
+void
+test2( )
+{
+	cout << "Test 2 -- scanning files" << endl;
+
+	string dir = "scan_dir/sub/";
+	check_dir( dir );
+
+	// a small file and a file large enough to be mapped
+	FILE* fp = open_file( "scan_dir/small.txt", "w" );
+	fprintf( fp, "TODO: one\nnothing\nFIXME two TODO\n" );
+	close_file( fp );
+	fp = open_file( "scan_dir/sub/large.txt", "w" );
+	for( unsigned i = 0; i != 100000; ++i )
+	{
+		fprintf( fp, (i % 25000 == 0) ? "line %u FIXME\n" : "line %u\n", i );
+	}
+	close_file( fp );
+
+	vector<string> patterns;
+	patterns.push_back( "TODO" );
+	patterns.push_back( "FIXME" );
+	const Literal_Matcher matcher( patterns );
+
+	for( unsigned num_threads = 1; num_threads <= 4; num_threads += 3 )
+	{
+		vector<string> files;
+		vector<File_Match> matches = scan_dir( "scan_dir", matcher, files,
+				all_true, num_threads );
+		std::sort( files.begin(), files.end() );
+		matches = scan_files( files, matcher, num_threads );
+
+		cout << "  " << num_threads << " thread(s):" << endl;
+		for( size_t i = 0; i != matches.size(); ++i )
+		{
+			cout << "    " << files[ matches[i].file ] << " @"
+				<< matches[i].offset << ": "
+				<< patterns[ matches[i].pattern ] << endl;
+		}
+	}
+
+	// a file that vanishes is skipped with a warning
+	Mapped_File file;
+	cout << "  missing file opened: "
+		<< file.try_open( "scan_dir/missing.txt" ) << endl;
+	vector<string> files;
+	files.push_back( "scan_dir/missing.txt" );
+	files.push_back( "scan_dir/sub/large.txt" );
+	cout << "  matches with a missing file: "
+		<< scan_files( files, matcher, 2 ).size() << endl;
+	cout << endl;
+}
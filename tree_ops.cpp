@@ -0,0 +1,837 @@
+/**
+	@file   tree_ops.cpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Functions for copying and removing directory trees.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#include "tree_ops.hpp"
+
+// c++ headers
+#include <atomic>
+#include <vector>
+
+// c headers
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+// system headers
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#ifdef __linux__
+	#include <linux/fs.h>
+	#include <sys/ioctl.h>
+	#include <sys/sendfile.h>
+#endif // __linux__
+
+// tools headers
+#include "parallel.hpp"
+
+using std::size_t;
+using std::string;
+using std::vector;
+
+namespace ws_tools
+{
+
+/**
+	@brief File to be copied by copy_tree().
+ */
+struct Copy_Task
+{
+	string          source;       //< Path of file to copy
+	string          destination;  //< Path of the copy
+	struct timespec mtime;        //< Modification time of source
+	mode_t          mode;         //< Permissions of source
+	uint64_t        size;         //< Size of source in bytes
+};
+
+/**
+	Remove the slash from the end of a directory name and add the home area if
+	present, as dir_traverse() does.
+	@param[in] directory_name Name of directory
+	@retval dir_name Cleaned name
+ */
+static string
+clean_dir_name( const string& directory_name )
+{
+	string dir_name = sub_home( directory_name );
+	string::size_type slash_pos = dir_name.find_last_of( '/' );
+	if( slash_pos == dir_name.size() - 1 && slash_pos != 0 )
+	{
+		dir_name.erase( slash_pos );
+	}
+	return( dir_name );
+}
+
+/**
+	Return whether the destination already has a file with the source's size
+	and modification time.
+	@param[in] task File to copy
+	@retval up_to_date Whether the copy can be skipped
+ */
+static bool
+is_up_to_date( const Copy_Task& task )
+{
+	struct stat stat_buf;
+	return( stat( task.destination.c_str(), &stat_buf ) == 0
+		&& S_ISREG( stat_buf.st_mode )
+		&& static_cast<uint64_t>( stat_buf.st_size ) == task.size
+		&& stat_buf.st_mtim.tv_sec == task.mtime.tv_sec
+		&& stat_buf.st_mtim.tv_nsec == task.mtime.tv_nsec );
+}
+
+/**
+	Copy the contents of one open file to another, letting the kernel move
+	the data whenever it can.
+
+	The fastest method available is used: sharing the source's blocks
+	(reflink, on file systems such as Btrfs and XFS), then copy_file_range()
+	(which may copy on the storage device itself), then sendfile(), and
+	finally read() and write() through a buffer.
+
+	@param[in] in Descriptor of source at offset 0
+	@param[in] out Descriptor of empty destination at offset 0
+	@param[in] size Number of bytes in the source
+	@retval success Whether the whole file was copied
+ */
+static bool
+copy_contents( int in, int out, uint64_t size )
+{
+	uint64_t copied = 0;
+
+#ifdef __linux__
+#ifdef FICLONE
+	if( ioctl( out, FICLONE, in ) == 0 )
+	{
+		return( true );
+	}
+#endif // FICLONE
+
+	// stops at the end of the file or when not supported between the files
+	while( copied < size )
+	{
+		const ssize_t n = copy_file_range( in, 0, out, 0, size - copied, 0 );
+		if( n <= 0 )
+		{
+			break;
+		}
+		copied += n;
+	}
+	while( copied < size )
+	{
+		const ssize_t n = sendfile( out, in, 0, size - copied );
+		if( n <= 0 )
+		{
+			break;
+		}
+		copied += n;
+	}
+#endif // __linux__
+
+	// also copies anything written to the file since it was listed
+	vector<char> buffer( 1 << 16 );
+	while( true )
+	{
+		const ssize_t n = read( in, &buffer[0], buffer.size() );
+		if( n < 0 )
+		{
+			return( false );
+		}
+		if( n == 0 )
+		{
+			return( true );
+		}
+		for( ssize_t written = 0; written < n; )
+		{
+			const ssize_t m = write( out, &buffer[written], n - written );
+			if( m < 0 )
+			{
+				return( false );
+			}
+			written += m;
+		}
+	}
+}
+
+/**
+	Copy one file and give the copy the source's modification time and
+	permissions.
+
+	The contents are written to a temporary file in the destination directory
+	that is then renamed over the destination, so an earlier copy is replaced
+	even if it is read-only, and is never left half written.
+	@param[in] task File to copy
+	@retval success Whether the file was copied
+ */
+static bool
+copy_file( const Copy_Task& task )
+{
+	const int in = open( task.source.c_str(), O_RDONLY | O_CLOEXEC );
+	if( in < 0 )
+	{
+		err_warn( "Unable to open file '%s'\n", task.source.c_str() );
+		return( false );
+	}
+
+	// temporary file named after the destination: 'dir/.name.XXXXXX'
+	const size_t slash = task.destination.rfind( '/' ) + 1;
+	string temp_name = task.destination.substr( 0, slash ) + "."
+		+ task.destination.substr( slash ) + ".XXXXXX";
+	const int out = mkstemp( &temp_name[0] );
+	if( out < 0 )
+	{
+		err_warn( "Unable to create file '%s'\n", temp_name.c_str() );
+		close( in );
+		return( false );
+	}
+	fcntl( out, F_SETFD, FD_CLOEXEC );
+
+	bool success = copy_contents( in, out, task.size );
+	if( !success )
+	{
+		err_warn( "Unable to copy file '%s' to '%s'\n", task.source.c_str(),
+				task.destination.c_str() );
+	}
+	else
+	{
+		// the modification time lets later copies skip the file
+		const struct timespec times[2] = { { 0, UTIME_OMIT }, task.mtime };
+		if( futimens( out, times ) != 0 || fchmod( out, task.mode ) != 0 )
+		{
+			err_warn( "Unable to set the time and mode of file '%s'\n",
+					task.destination.c_str() );
+		}
+	}
+
+	close( in );
+	if( close( out ) != 0 )
+	{
+		err_warn( "An error occurred while closing file '%s'\n",
+				task.destination.c_str() );
+		success = false;
+	}
+	if( success && rename( temp_name.c_str(), task.destination.c_str() ) != 0 )
+	{
+		err_warn( "Unable to replace file '%s'\n", task.destination.c_str() );
+		success = false;
+	}
+	if( !success )
+	{
+		unlink( temp_name.c_str() );
+	}
+	return( success );
+}
+
+/**
+	Copy a soft link as a soft link, unless the destination already is one to
+	the same target.
+	@param[in] source Path of link
+	@param[in] destination Path of copy
+	@retval success Whether the link was copied (or already existed)
+ */
+static bool
+copy_link( const string& source, const string& destination )
+{
+	char target[ PATH_MAX + 1 ];
+	const ssize_t n = readlink( source.c_str(), target, PATH_MAX );
+	if( n < 0 )
+	{
+		err_warn( "Unable to read link '%s'\n", source.c_str() );
+		return( false );
+	}
+	target[n] = '\0';
+
+	char old_target[ PATH_MAX + 1 ];
+	const ssize_t m = readlink( destination.c_str(), old_target, PATH_MAX );
+	if( m == n && memcmp( target, old_target, n ) == 0 )
+	{
+		return( true );
+	}
+	unlink( destination.c_str() );
+	if( symlink( target, destination.c_str() ) != 0 )
+	{
+		err_warn( "Unable to create link '%s'\n", destination.c_str() );
+		return( false );
+	}
+	return( true );
+}
+
+/**
+	Copy a directory tree, or bring an earlier copy up to date.
+
+	The source is walked once: each directory is created in the destination
+	as it is reached (so each mkdir() is done once, before any of the
+	directory's files, instead of checking every file's directories as
+	check_dir() would), soft links are copied as links, and regular files are
+	listed. The files are then copied on several threads, skipping those
+	whose copy already has the same size and modification time, and finally
+	the directories are given the source's modes (until then their owner has
+	full access to them, so read-only directories can be filled). Contents are
+	copied by the kernel (see copy_contents()) so they never pass through
+	this process's memory when the system supports it.
+
+	The destination may be inside the source; it is not copied into itself.
+
+	@param[in] source_dir Directory to copy
+	@param[in] destination_dir Directory to copy to (created if needed)
+	@param[in] num_threads Number of threads to copy files with (0 means one
+		per processor)
+	@param[in] filter Predicate function invoked on all regular files--only those
+		files for which the predicate is true are copied
+	@retval stats Number of files copied, skipped, and failed
+ */
+Copy_Stats
+copy_tree( const string& source_dir, const string& destination_dir,
+		unsigned num_threads, bool (*filter)( const string& ) )
+{
+	Copy_Stats stats = { 0, 0, 0, 0 };
+
+	const string source      = clean_dir_name( source_dir );
+	const string destination = clean_dir_name( destination_dir );
+
+	struct stat stat_buf;
+	if( stat( source.c_str(), &stat_buf ) < 0 || !S_ISDIR( stat_buf.st_mode ) )
+	{
+		err_warn( "Unable to access directory '%s'\n", source.c_str() );
+		return( stats );
+	}
+	string dest_parent = destination;
+	check_dir( dest_parent );
+
+	// do not copy the destination into itself
+	struct stat dest_stat;
+	if( stat( destination.c_str(), &dest_stat ) < 0 )
+	{
+		err_warn( "Unable to access directory '%s'\n", destination.c_str() );
+		return( stats );
+	}
+
+	// create the directories and list the files, depth-first
+	vector<Copy_Task>                   tasks;
+	vector< std::pair<string, mode_t> > dir_modes;
+	vector< std::pair<string, string> > dirs( 1,
+			std::make_pair( source, destination ) );
+	while( !dirs.empty() )
+	{
+		const string dir_name  = dirs.back().first + "/";
+		const string dest_name = dirs.back().second + "/";
+		dirs.pop_back();
+
+		DIR* dfp = opendir( dir_name.c_str() );
+		if( dfp == NULL )
+		{
+			err_warn( "Unable to open directory %s\n", dir_name.c_str() );
+			continue;
+		}
+		const int dir_fd = dirfd( dfp );
+
+		dirent* dep;
+		while( (dep = readdir( dfp )) != NULL )
+		{
+			const char* name = dep->d_name;
+			if( strcmp( name, "." ) == 0 || strcmp( name, ".." ) == 0 )
+			{
+				continue;
+			}
+
+			struct stat entry_stat;
+			if( fstatat( dir_fd, name, &entry_stat, AT_SYMLINK_NOFOLLOW ) < 0 )
+			{
+				err_warn( "Unable to access file '%s%s'\n", dir_name.c_str(),
+						name );
+				continue;
+			}
+
+			const string file_name = dir_name + name;
+			const string dest_file = dest_name + name;
+			if( S_ISDIR( entry_stat.st_mode ) )
+			{
+				if( entry_stat.st_dev == dest_stat.st_dev
+						&& entry_stat.st_ino == dest_stat.st_ino )
+				{
+					continue;
+				}
+				// the owner needs full access until the contents are copied
+				const mode_t mode = entry_stat.st_mode & 07777;
+				if( mkdir( dest_file.c_str(), mode | S_IRWXU ) != 0
+						&& (errno != EEXIST
+							|| chmod( dest_file.c_str(), mode | S_IRWXU ) != 0) )
+				{
+					err_warn( "Unable to create directory '%s'\n",
+							dest_file.c_str() );
+					continue;
+				}
+				dirs.push_back( std::make_pair( file_name, dest_file ) );
+				dir_modes.push_back( std::make_pair( dest_file, mode ) );
+			}
+			else if( S_ISLNK( entry_stat.st_mode ) )
+			{
+				if( !copy_link( file_name, dest_file ) )
+				{
+					++stats.num_failed;
+				}
+			}
+			else if( S_ISREG( entry_stat.st_mode ) && filter( file_name ) )
+			{
+				Copy_Task task;
+				task.source      = file_name;
+				task.destination = dest_file;
+				task.mtime       = entry_stat.st_mtim;
+				task.mode        = entry_stat.st_mode & 07777;
+				task.size        = entry_stat.st_size;
+				tasks.push_back( task );
+			}
+		}
+		closedir( dfp );
+	}
+
+	// copy the files
+	std::atomic<size_t>   num_copied( 0 );
+	std::atomic<size_t>   num_skipped( 0 );
+	std::atomic<size_t>   num_failed( 0 );
+	std::atomic<uint64_t> bytes_copied( 0 );
+	parallel_for( tasks.size(), num_threads,
+		[&]( size_t i )
+		{
+			if( is_up_to_date( tasks[i] ) )
+			{
+				++num_skipped;
+			}
+			else if( copy_file( tasks[i] ) )
+			{
+				++num_copied;
+				bytes_copied += tasks[i].size;
+			}
+			else
+			{
+				++num_failed;
+			}
+		} );
+
+	// give the directories their modes, each after its subdirectories
+	for( size_t i = dir_modes.size(); i-- != 0; )
+	{
+		if( chmod( dir_modes[i].first.c_str(), dir_modes[i].second ) != 0 )
+		{
+			err_warn( "Unable to set the mode of directory '%s'\n",
+					dir_modes[i].first.c_str() );
+		}
+	}
+
+	stats.num_copied   = num_copied;
+	stats.num_skipped  = num_skipped;
+	stats.num_failed  += num_failed;
+	stats.bytes_copied = bytes_copied;
+	return( stats );
+}
+
+/**
+	@brief Directory to remove, named relative to its parent's descriptor.
+ */
+struct Remove_Task
+{
+	int    parent_fd;  //< Open directory containing the directory
+	string name;       //< Name of the directory in its parent
+	string path;       //< Path of the directory (for messages)
+};
+
+/**
+	Remove the entries of an open directory except its subdirectories.
+
+	Entries are removed with unlinkat() relative to the directory, so no path
+	is resolved again, and soft links are removed rather than followed.
+
+	@param[in] dir_fd Open directory
+	@param[in] path Path of the directory (for messages)
+	@param[in] dry_run Whether to only count the entries
+	@param[out] subdirs Names of the subdirectories, which are left alone
+	@retval num_removed Number of files removed
+ */
+static size_t
+remove_entries( int dir_fd, const string& path, bool dry_run,
+		vector<string>& subdirs )
+{
+	const int list_fd = dup( dir_fd );
+	DIR* dfp = (list_fd < 0) ? 0 : fdopendir( list_fd );
+	if( dfp == 0 )
+	{
+		if( list_fd >= 0 )
+		{
+			close( list_fd );
+		}
+		err_warn( "Unable to open directory %s\n", path.c_str() );
+		return( 0 );
+	}
+
+	size_t num_removed = 0;
+	dirent* dep;
+	while( (dep = readdir( dfp )) != NULL )
+	{
+		const char* name = dep->d_name;
+		if( strcmp( name, "." ) == 0 || strcmp( name, ".." ) == 0 )
+		{
+			continue;
+		}
+
+		// the entry's type usually comes with it, saving a stat
+		bool is_dir = (dep->d_type == DT_DIR);
+		if( dep->d_type == DT_UNKNOWN )
+		{
+			struct stat stat_buf;
+			is_dir = fstatat( dir_fd, name, &stat_buf, AT_SYMLINK_NOFOLLOW ) == 0
+				&& S_ISDIR( stat_buf.st_mode );
+		}
+
+		if( is_dir )
+		{
+			subdirs.push_back( name );
+		}
+		else if( dry_run || unlinkat( dir_fd, name, 0 ) == 0 )
+		{
+			++num_removed;
+		}
+		else
+		{
+			err_warn( "Unable to remove file '%s/%s'\n", path.c_str(), name );
+		}
+	}
+	closedir( dfp );
+	return( num_removed );
+}
+
+/**
+	@brief Directory on the path being removed by remove_dir_at().
+ */
+struct Remove_Level
+{
+	string         path;     //< Path of the directory (for messages)
+	dev_t          dev;      //< Device of the directory
+	ino_t          ino;      //< Inode of the directory
+	vector<string> subdirs;  //< Names of its subdirectories
+	size_t         next;     //< Next subdirectory to remove
+};
+
+/**
+	Open a directory with O_NOFOLLOW, so if it has been replaced by a soft link,
+	nothing outside the tree is opened.
+	@param[in] parent_fd Open directory containing the directory
+	@param[in] name Name of the directory in its parent
+	@retval fd Descriptor of the directory or -1 on failure
+ */
+static int
+open_dir_at( int parent_fd, const char* name )
+{
+	return( openat( parent_fd, name,
+				O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC ) );
+}
+
+/**
+	Remove a directory and everything in it.
+
+	The tree is walked depth-first with an explicit stack that keeps only the
+	names of each directory's subdirectories, and a single descriptor is open at
+	a time (besides parent_fd): each subdirectory is opened relative to its
+	parent, and the parent is opened again as ".." when the subdirectory has been
+	emptied, so trees of any depth can be removed without running out of
+	descriptors. A parent whose device and inode numbers have changed (because
+	the directory was moved while being removed) stops the removal rather than
+	remove anything outside the tree. Directories are opened with O_NOFOLLOW,
+	so if one has been replaced by a soft link, nothing outside the tree is
+	removed.
+
+	@param[in] parent_fd Open directory containing the directory
+	@param[in] name Name of the directory in its parent
+	@param[in] path Path of the directory (for messages)
+	@param[in] dry_run Whether to only count the entries
+	@retval num_removed Number of files and directories removed
+ */
+static size_t
+remove_dir_at( int parent_fd, const string& name, const string& path,
+		bool dry_run )
+{
+	size_t num_removed = 0;
+	vector<Remove_Level> levels;
+	struct stat stat_buf;
+
+	int fd = open_dir_at( parent_fd, name.c_str() );
+	if( fd < 0 || fstat( fd, &stat_buf ) < 0 )
+	{
+		err_warn( "Unable to open directory %s\n", path.c_str() );
+		if( fd >= 0 )
+		{
+			close( fd );
+		}
+		return( 0 );
+	}
+	levels.push_back( Remove_Level{ path, stat_buf.st_dev, stat_buf.st_ino,
+			vector<string>(), 0 } );
+	num_removed += remove_entries( fd, path, dry_run, levels.back().subdirs );
+
+	while( true )
+	{
+		Remove_Level& level = levels.back();
+
+		// descend into the next subdirectory
+		if( level.next != level.subdirs.size() )
+		{
+			const string& sub_name = level.subdirs[ level.next++ ];
+			string sub_path = level.path + "/" + sub_name;
+			const int sub_fd = open_dir_at( fd, sub_name.c_str() );
+			if( sub_fd < 0 || fstat( sub_fd, &stat_buf ) < 0 )
+			{
+				err_warn( "Unable to open directory %s\n", sub_path.c_str() );
+				if( sub_fd >= 0 )
+				{
+					close( sub_fd );
+				}
+				continue;
+			}
+			close( fd );
+			fd = sub_fd;
+			levels.push_back( Remove_Level{ std::move( sub_path ),
+					stat_buf.st_dev, stat_buf.st_ino, vector<string>(), 0 } );
+			num_removed += remove_entries( fd, levels.back().path, dry_run,
+					levels.back().subdirs );
+			continue;
+		}
+
+		// the directory is empty (unless this is a dry run), so go back to its
+		// parent and remove it there
+		const int up_fd = (levels.size() == 1) ? -1 : open_dir_at( fd, ".." );
+		close( fd );
+		fd = up_fd;
+		const string dir_path = level.path;
+		levels.pop_back();
+		if( levels.empty() )
+		{
+			if( dry_run || unlinkat( parent_fd, name.c_str(), AT_REMOVEDIR ) == 0 )
+			{
+				++num_removed;
+			}
+			else
+			{
+				err_warn( "Unable to remove directory '%s'\n", dir_path.c_str() );
+			}
+			return( num_removed );
+		}
+
+		const Remove_Level& parent = levels.back();
+		if( fd < 0 || fstat( fd, &stat_buf ) < 0
+				|| stat_buf.st_dev != parent.dev || stat_buf.st_ino != parent.ino )
+		{
+			err_warn( "Directory %s moved while being removed\n",
+					parent.path.c_str() );
+			if( fd >= 0 )
+			{
+				close( fd );
+			}
+			return( num_removed );
+		}
+		if( dry_run || unlinkat( fd,
+				parent.subdirs[ parent.next - 1 ].c_str(), AT_REMOVEDIR ) == 0 )
+		{
+			++num_removed;
+		}
+		else
+		{
+			err_warn( "Unable to remove directory '%s'\n", dir_path.c_str() );
+		}
+	}
+}
+
+/**
+	Determine whether removing a directory would remove the root directory or
+	the current directory (or its parent), which 'rm -rf --preserve-root'
+	refuses to do.
+	@param[in] dir_name Name of the directory
+	@param[in] stat_buf Status of the directory (not following soft links)
+	@retval is_protected Whether the directory must not be removed
+ */
+static bool
+is_protected( const string& dir_name, const struct stat& stat_buf )
+{
+	const string::size_type slash_pos = dir_name.find_last_of( '/' );
+	const string last_name = (slash_pos == string::npos) ? dir_name
+		: dir_name.substr( slash_pos + 1 );
+	if( last_name == "." || last_name == ".." )
+	{
+		return( true );
+	}
+
+	// compare the directory itself, so that names such as "//" or "a/../.."
+	// are caught too (a soft link is only removed itself, so it is allowed)
+	if( !S_ISDIR( stat_buf.st_mode ) )
+	{
+		return( false );
+	}
+	const char* protected_dirs[] = { "/", "." };
+	for( unsigned i = 0; i != 2; ++i )
+	{
+		struct stat protected_stat;
+		if( stat( protected_dirs[i], &protected_stat ) == 0
+				&& protected_stat.st_dev == stat_buf.st_dev
+				&& protected_stat.st_ino == stat_buf.st_ino )
+		{
+			return( true );
+		}
+	}
+	return( false );
+}
+
+/**
+	Remove a directory tree, like 'rm -rf'.
+
+	The tree is walked with directory descriptors and each entry is removed
+	with unlinkat() relative to its parent, bottom-up, so paths are never
+	resolved from the top again. Soft links are removed, never followed, and
+	directories are opened with O_NOFOLLOW, so a link (even one swapped in
+	while the tree is being removed) cannot lead outside the tree; if the
+	given name is itself a soft link, only the link is removed. Like
+	'rm -rf --preserve-root', an empty name, the root directory, and names
+	that end in "." or ".." or refer to the current directory are refused.
+
+	With several threads, the top levels of the tree are split into subtrees
+	(until there are a few per thread), which are removed in parallel; the
+	directories above them are removed afterward.
+
+	@param[in] directory_name Directory to remove
+	@param[in] num_threads Number of threads to use (0 means one per
+		processor)
+	@param[in] dry_run Whether to only count what would be removed
+	@retval num_removed Number of files and directories removed (or that would
+		be removed)
+ */
+size_t
+remove_tree( const string& directory_name, unsigned num_threads,
+		bool dry_run )
+{
+	if( directory_name == "" )
+	{
+		err_warn( "Refusing to remove an empty directory name\n" );
+		return( 0 );
+	}
+	const string top = clean_dir_name( directory_name );
+
+	struct stat stat_buf;
+	if( lstat( top.c_str(), &stat_buf ) < 0 )
+	{
+		err_warn( "Unable to access file '%s'\n", top.c_str() );
+		return( 0 );
+	}
+	if( is_protected( top, stat_buf ) )
+	{
+		err_warn( "Refusing to remove '%s'\n", top.c_str() );
+		return( 0 );
+	}
+	if( !S_ISDIR( stat_buf.st_mode ) )
+	{
+		if( dry_run || unlink( top.c_str() ) == 0 )
+		{
+			return( 1 );
+		}
+		err_warn( "Unable to remove file '%s'\n", top.c_str() );
+		return( 0 );
+	}
+
+	const int top_fd = open( top.c_str(),
+			O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC );
+	if( top_fd < 0 )
+	{
+		err_warn( "Unable to open directory %s\n", top.c_str() );
+		return( 0 );
+	}
+	if( num_threads == 0 )
+	{
+		num_threads = default_num_threads();
+	}
+
+	// remove the files at the top and split the subdirectories into subtrees
+	// until there are enough to keep the threads busy
+	vector<string> names;
+	size_t num_removed = remove_entries( top_fd, top, dry_run, names );
+	vector<Remove_Task> tasks;
+	for( size_t i = 0; i != names.size(); ++i )
+	{
+		tasks.push_back( Remove_Task{ top_fd, names[i], top + "/" + names[i] } );
+	}
+
+	vector<Remove_Task> split_dirs;  // directories above the subtrees
+	vector<int>         split_fds;   // open descriptors of split_dirs
+	for( unsigned level = 0; level != 3 && num_threads > 1
+			&& !tasks.empty() && tasks.size() < 4 * num_threads; ++level )
+	{
+		vector<Remove_Task> next_tasks;
+		for( size_t i = 0; i != tasks.size(); ++i )
+		{
+			const int fd = openat( tasks[i].parent_fd, tasks[i].name.c_str(),
+					O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC );
+			if( fd < 0 )
+			{
+				err_warn( "Unable to open directory %s\n",
+						tasks[i].path.c_str() );
+				continue;
+			}
+			split_dirs.push_back( tasks[i] );
+			split_fds.push_back( fd );
+
+			names.clear();
+			num_removed += remove_entries( fd, tasks[i].path, dry_run, names );
+			for( size_t j = 0; j != names.size(); ++j )
+			{
+				next_tasks.push_back( Remove_Task{ fd, names[j],
+						tasks[i].path + "/" + names[j] } );
+			}
+		}
+		tasks.swap( next_tasks );
+	}
+
+	// remove the subtrees
+	std::atomic<size_t> num_subtree_removed( 0 );
+	parallel_for( tasks.size(), num_threads,
+		[&]( size_t i )
+		{
+			num_subtree_removed += remove_dir_at( tasks[i].parent_fd,
+					tasks[i].name, tasks[i].path, dry_run );
+		} );
+	num_removed += num_subtree_removed;
+
+	// remove the directories above the subtrees, deepest first
+	for( size_t i = split_dirs.size(); i-- != 0; )
+	{
+		close( split_fds[i] );
+		if( dry_run || unlinkat( split_dirs[i].parent_fd,
+				split_dirs[i].name.c_str(), AT_REMOVEDIR ) == 0 )
+		{
+			++num_removed;
+		}
+		else
+		{
+			err_warn( "Unable to remove directory '%s'\n",
+					split_dirs[i].path.c_str() );
+		}
+	}
+	close( top_fd );
+
+	if( dry_run || rmdir( top.c_str() ) == 0 )
+	{
+		++num_removed;
+	}
+	else
+	{
+		err_warn( "Unable to remove directory '%s'\n", top.c_str() );
+	}
+	return( num_removed );
+}
+
+} // namespace ws_tools
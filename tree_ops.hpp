@@ -0,0 +1,47 @@
+/**
+	@file   tree_ops.hpp
+	@author Wade Spires
+	@date   2026/10/18
+	@brief  Functions for copying and removing directory trees.
+
+	Copyright 2007 Wade Spires.
+	Distributed under the GNU Lesser General Public License, Version 2.1.
+	(See accompanying file LICENSE.txt or copy at
+	http://www.gnu.org/licenses/lgpl.txt)
+ */
+
+#ifndef _TREE_OPS_HPP
+#define _TREE_OPS_HPP
+
+// c++ headers
+#include <string>
+
+// c headers
+#include <cstddef>
+#include <cstdint>
+
+// tools headers
+#include "util.hpp"
+
+namespace ws_tools
+{
+	/**
+		@brief Counts of what copy_tree() did.
+	 */
+	struct Copy_Stats
+	{
+		std::size_t num_copied;    //< Files copied
+		std::size_t num_skipped;   //< Files already up to date
+		std::size_t num_failed;    //< Files that could not be copied
+		uint64_t    bytes_copied;  //< Bytes in the files copied
+	};
+
+	extern Copy_Stats copy_tree( const std::string&, const std::string&,
+			unsigned = 0, bool (*)( const std::string& ) = all_true );
+
+	extern std::size_t remove_tree( const std::string&, unsigned = 0,
+			bool = false );
+
+} // namespace ws_tools
+
+#endif // _TREE_OPS_HPP
@@ -14,8 +14,18 @@
 
 #include "limits.h"
 
+#include <charconv>
+#include <deque>
 #include <set>
 
+#include "Dir_Walker.hpp"
+
+// vector instructions for case conversion and rounding
+#include "cpu_features.hpp"
+#ifdef __SSE2__
+	#include <emmintrin.h>
+#endif // __SSE2__
+
 using std::set;
 using std::string;
 using std::vector;
@@ -211,9 +221,9 @@ dir_open( const string& directory_name, bool (*filter)( const string& ) )
 	recursively check subdirectories.
 
 	Directory traversal algorithm:
-	Let L represent a list of file names
+	Let L represent a queue of file names
 	Add the initial directory to L, so L holds 1 file name
-	For each file in L
+	While L is not empty, remove the first file from L
 		If file is a regular file
 			Add file to file list
 		If file is a directory that has not already been seen
@@ -221,7 +231,10 @@ dir_open( const string& directory_name, bool (*filter)( const string& ) )
 			For each directory entry
 				If entry is not current or parent directory (i.e., '.' or '..')
 					Create new path name by setting path = file_name/entry_name
-					Add path to L
+					Add path to the end of L
+
+	Directories are listed breadth-first, so L can grow as large as the widest
+	level of the tree; see dir_traverse_depth_first() for large trees.
 
 	@param[in] directory_name Name of directory to search for files
 	@param[in] filter Predicate function invoked on all regular files--only those
@@ -249,14 +262,16 @@ dir_traverse( const string& directory_name,
 		dir_name.erase( slash_pos );
 	}
 
-	// add initial directory to list of files to process
-	vector<string> files_to_process;
+	// add initial directory to queue of files to process
+	std::deque<string> files_to_process;
 	files_to_process.push_back( dir_name );
 
-	// iterate through all files in the list
-	for( unsigned i = 0; i != files_to_process.size(); i++ )
+	// process files in the order found, removing each from the queue so
+	// that it only holds the paths not yet processed
+	while( !files_to_process.empty() )
 	{
-		string file_name = files_to_process[i];
+		string file_name = std::move( files_to_process.front() );
+		files_to_process.pop_front();
 
 		// read file information into status buffer
 		stat_struct stat_buf;
@@ -360,6 +375,76 @@ dir_traverse( const string& directory_name,
 	return( file_list );
 }
 
+/**
+	List the files found by a recursive Dir_Walker, the traversal shared by
+	dir_traverse_depth_first() and dir_traverse_sorted().
+	@param[in] directory_name Name of directory to search for files
+	@param[in] sorted Whether to list files in tree order
+	@param[in] filter Predicate function invoked on all regular files
+	@retval file_list List of all files found
+ */
+static vector<string>
+walk_files( const string& directory_name, bool sorted,
+	bool (*filter)( const string& ) )
+{
+	vector<string> file_list;
+	Dir_Walker walker( directory_name, true, sorted, filter );
+	string file_name;
+	while( walker.next( file_name ) )
+	{
+		file_list.push_back( file_name );
+	}
+	return( file_list );
+}
+
+/**
+	Create list of all files found in the directory directory_name and its
+	subdirectories, walking the tree depth-first with Dir_Walker.
+
+	Which files are listed is the same as for dir_traverse(), except that a
+	directory reached through several soft links is listed once for each (see
+	Dir_Walker), but only the directories on the path to the current one are
+	held while walking, rather than every path found, so memory beyond the
+	result does not grow with the size of the tree. Use dir_traverse_sorted()
+	where links may lead to a directory many times.
+
+	@param[in] directory_name Name of directory to search for files
+	@param[in] filter Predicate function invoked on all regular files--only those
+		file names for which the predicate is true are added to the file list
+	@retval file_list List of all files found
+ */
+vector<string>
+dir_traverse_depth_first( const string& directory_name,
+	bool (*filter)( const string& ) )
+{
+	return( walk_files( directory_name, false, filter ) );
+}
+
+/**
+	Create list of all files found in the directory directory_name and its
+	subdirectories in tree order, i.e., the order of sort_paths(): entries of
+	each directory are sorted by name as the directory is read, and each
+	subdirectory's files are listed before the directory's later entries.
+	The result is the same on every run and file system, without sorting the
+	whole list afterwards.
+
+	Which files are listed is the same as for dir_traverse(): a directory that
+	several soft links lead to is listed once, under the first path to it in
+	tree order, so the memory held while walking grows with the number of
+	directories (see dir_traverse_depth_first() for bounded memory).
+
+	@param[in] directory_name Name of directory to search for files
+	@param[in] filter Predicate function invoked on all regular files--only those
+		file names for which the predicate is true are added to the file list
+	@retval file_list List of all files found
+ */
+vector<string>
+dir_traverse_sorted( const string& directory_name,
+	bool (*filter)( const string& ) )
+{
+	return( walk_files( directory_name, true, filter ) );
+}
+
 /**
 	Determine if file was seen already.
 
@@ -699,14 +784,194 @@ string_to_double( const string& s )
 string
 int_to_string( int i )
 {
-	// stringstream is probably safer but is not on some UNIX systems
-	return( format_string( "%d", i ) );
+	char buf[ INT_BUF_SIZE ];
+	return( string( buf, format_int( buf, i ) ) );
+}
+
+/**
+	Convert double to the shortest string that reads back as the same value.
+	@param d Double to convert
+ */
+string
+double_to_string( double d )
+{
+	char buf[ DOUBLE_BUF_SIZE ];
+	return( string( buf, format_double( buf, d ) ) );
+}
+
+/// Every two-digit number "00" through "99" laid end to end, so that the
+/// digits of (n % 100) start at index 2 * (n % 100)
+static const char digit_pairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+/// Powers of 10 that fit in 64 bits, indexed by exponent
+static const unsigned long long powers_of_10[] =
+{
+	1ULL,
+	10ULL,
+	100ULL,
+	1000ULL,
+	10000ULL,
+	100000ULL,
+	1000000ULL,
+	10000000ULL,
+	100000000ULL,
+	1000000000ULL,
+	10000000000ULL,
+	100000000000ULL,
+	1000000000000ULL,
+	10000000000000ULL,
+	100000000000000ULL,
+	1000000000000000ULL,
+	10000000000000000ULL,
+	100000000000000000ULL,
+	1000000000000000000ULL,
+	10000000000000000000ULL
+};
+
+/**
+	Determine the number of decimal digits in a 64-bit number.
+
+	The bit length gives log2(num); multiplying by 1233 / 4096 (~log10(2))
+	gives a guess at log10(num) that is either exact or one too large, which a
+	single table lookup corrects.
+
+	@param[in] num Number to find the digit count in
+	@retval number_of_digits Number of digits in the given number
+ */
+static inline int
+count_digits_64( unsigned long long num )
+{
+	num |= 1;  // 0 has one digit; also keeps clz defined
+	const int bits = 64 - __builtin_clzll( num );
+	const int t    = (bits * 1233) >> 12;
+	return( t - (num < powers_of_10[t]) + 1 );
+}
+
+/**
+	Write unsigned integer as decimal text into the given buffer.
+
+	Digits are produced two at a time from a table of digit pairs, which halves
+	the number of divisions compared with a digit-by-digit loop.
+
+	@param[out] buf Buffer of at least INT_BUF_SIZE characters
+	@param[in] num Number to write
+	@retval end Pointer to the terminating null written after the last digit
+ */
+char*
+format_uint( char* buf, unsigned long long num )
+{
+	char* const end = buf + count_digits_64( num );
+	char*       p   = end;
+	*p = '\0';
+
+	while( num >= 100 )
+	{
+		const unsigned idx = static_cast<unsigned>( num % 100 ) * 2;
+		num /= 100;
+		*--p = digit_pairs[ idx + 1 ];
+		*--p = digit_pairs[ idx ];
+	}
+	if( num >= 10 )
+	{
+		const unsigned idx = static_cast<unsigned>( num ) * 2;
+		*--p = digit_pairs[ idx + 1 ];
+		*--p = digit_pairs[ idx ];
+	}
+	else
+	{
+		*--p = static_cast<char>( '0' + num );
+	}
+	return( end );
+}
+
+/**
+	Write signed integer as decimal text into the given buffer.
+	@param[out] buf Buffer of at least INT_BUF_SIZE characters
+	@param[in] num Number to write
+	@retval end Pointer to the terminating null written after the last digit
+ */
+char*
+format_int( char* buf, long long num )
+{
+	// negate in unsigned arithmetic so that LLONG_MIN does not overflow
+	unsigned long long mag = static_cast<unsigned long long>( num );
+	if( num < 0 )
+	{
+		*buf++ = '-';
+		mag = 0 - mag;
+	}
+	return( format_uint( buf, mag ) );
+}
+
+/**
+	Write double as the shortest decimal text that reads back (e.g., via
+	string_to_double()) as exactly the same value.
+
+	The conversion is std::to_chars(), which uses the Ryu algorithm in current
+	standard libraries, so no temporary buffer or locale lookup is involved.
+	Fixed or scientific notation is chosen, whichever is shorter.
+
+	@param[out] buf Buffer of at least DOUBLE_BUF_SIZE characters
+	@param[in] d Number to write
+	@retval end Pointer to the terminating null written after the last character
+ */
+char*
+format_double( char* buf, double d )
+{
+	std::to_chars_result result = std::to_chars( buf, buf + DOUBLE_BUF_SIZE - 1,
+			d );
+	*result.ptr = '\0';
+	return( result.ptr );
+}
+
+/**
+	Append integer as decimal text to the end of the given string.
+	@param[in,out] str String to append to
+	@param[in] num Number to write
+	@retval str String with the number appended
+ */
+string&
+append_int( string& str, long long num )
+{
+	char buf[ INT_BUF_SIZE ];
+	return( str.append( buf, format_int( buf, num ) ) );
+}
+
+/**
+	Append unsigned integer as decimal text to the end of the given string.
+	@param[in,out] str String to append to
+	@param[in] num Number to write
+	@retval str String with the number appended
+ */
+string&
+append_uint( string& str, unsigned long long num )
+{
+	char buf[ INT_BUF_SIZE ];
+	return( str.append( buf, format_uint( buf, num ) ) );
+}
 
-	/*
-	char buf[ BUFSIZ ];
-	sprintf( buf, "%d", i );
-	return( string( buf ) );
-	 */
+/**
+	Append double as the shortest round-trip decimal text to the end of the
+	given string.
+	@param[in,out] str String to append to
+	@param[in] d Number to write
+	@retval str String with the number appended
+ */
+string&
+append_double( string& str, double d )
+{
+	char buf[ DOUBLE_BUF_SIZE ];
+	return( str.append( buf, format_double( buf, d ) ) );
 }
 
 /**
@@ -774,79 +1039,741 @@ split_string( const string& str, const string& separators )
 	Create a formatted string object from a C-style string.
 
    String can have conversion specifications (i.e., %d, %s, etc.) since
-   format_string() takes a variable number of arguments.
+   format_string() takes a variable number of arguments. There is no limit on
+	the length of the result.
 
 	@param message -- message to format
  */
 string
-format_string( char* message, ... )
+format_string( const char* message, ... )
 {
-	// stringstream is probably safer but is not on some UNIX systems
-	char buf[ BUFSIZ ];
+	string str;
    va_list v_args;
 
    va_start( v_args, message );
-   int num_bytes = vsnprintf( buf, BUFSIZ, message, v_args );
-	if( num_bytes >= BUFSIZ )
+	vappend_format( str, message, v_args );
+   va_end( v_args );
+
+	return( str );
+}
+
+/**
+	Append formatted message to the end of the given string.
+
+	@param[in,out] str String to append to
+	@param[in] message Message to format
+	@retval str String with the formatted message appended
+ */
+string&
+append_format( string& str, const char* message, ... )
+{
+   va_list v_args;
+
+   va_start( v_args, message );
+	vappend_format( str, message, v_args );
+   va_end( v_args );
+
+	return( str );
+}
+
+/**
+	Append formatted message to the end of the given string using an argument
+	list from the caller.
+
+	The message is first formatted directly into the unused capacity of the
+	string. Only when it does not fit is the string grown to the exact size that
+	vsnprintf() reported and the message formatted a second time, so a string
+	that is cleared and reused settles into making a single vsnprintf() call and
+	no allocations.
+
+	@param[in,out] str String to append to
+	@param[in] message Message to format
+	@param[in] v_args Arguments for the conversion specifications in message
+	@retval str String with the formatted message appended
+ */
+string&
+vappend_format( string& str, const char* message, va_list v_args )
+{
+	// the arguments may be needed twice, so keep a copy for the second pass
+	va_list v_args_copy;
+	va_copy( v_args_copy, v_args );
+
+	// format into the spare capacity (plus the slot for the terminating null)
+	const string::size_type old_size = str.size();
+	string::size_type spare = str.capacity() - old_size;
+	if( spare < 64 )
+	{
+		spare = 64;
+	}
+	str.resize( old_size + spare );
+	const int num_bytes = vsnprintf( &str[old_size], spare + 1, message,
+			v_args );
+
+	if( num_bytes < 0 )
 	{
-		err_quit( "ws_tools::format_string: formatted message exceeded buffer by "
-				"%d bytes\n", num_bytes - BUFSIZ + 1 );
+		str.resize( old_size );
+		err_warn( "ws_tools::vappend_format: unable to format '%s'\n",
+				message );
 	}
+	else if( static_cast<string::size_type>( num_bytes ) <= spare )
+	{
+		str.resize( old_size + num_bytes );
+	}
+	else // too large: grow to the exact size and format again
+	{
+		str.resize( old_size + num_bytes );
+		vsnprintf( &str[old_size], num_bytes + 1, message, v_args_copy );
+	}
+
+	va_end( v_args_copy );
+	return( str );
+}
+
+/**
+	Format message into a buffer owned by the calling thread.
+
+	The returned string is overwritten by the next call to format_temp() from
+	the same thread, so copy it if it must be kept. Since the buffer is reused,
+	repeated calls (e.g., for log messages in a loop) do not allocate.
+
+	@param[in] message Message to format
+	@retval str Formatted message
+ */
+const string&
+format_temp( const char* message, ... )
+{
+	static thread_local string buf;
+	buf.clear();
+
+   va_list v_args;
+   va_start( v_args, message );
+	vappend_format( buf, message, v_args );
    va_end( v_args );
 
-	return( string( buf ) );
+	return( buf );
+}
+
+/// Powers of 10 that are exact as doubles, indexed by exponent
+static const double exact_powers_of_10[] =
+{
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/// Largest precision whose scale factor is exact
+static const prec_type max_exact_prec = 22;
+
+/// Values at or above 2^52 have no fractional bits, and adding then subtracting
+/// 2^52 rounds smaller non-negative values to an integer (ties to even)
+static const double round_magic = 4503599627370496.0;
+
+/// Veltkamp splitting constant (2^27 + 1)
+static const double split_factor = 134217729.0;
+
+/**
+	Change precision of floating-point value by printing and reading it back.
+	This is the definition of the result; double_prec() only uses it for values
+	and precisions that the arithmetic method cannot handle exactly.
+
+	@param d Double value to change precision of
+	@param prec Precision to change value to
+ */
+static double
+double_prec_text( double d, prec_type prec )
+{
+	const string buf = format_string( "%.*f", prec, d );
+	return( strtod( buf.c_str(), NULL ) );
+}
+
+/**
+	@brief Constants for rounding values to a fixed number of decimal places.
+
+	The scale 10^prec is split into high and low halves of 26 bits for the
+	exact product in Dekker's algorithm.
+ */
+struct Prec_Scale
+{
+	Prec_Scale( prec_type prec )
+	: scale( exact_powers_of_10[ prec ] )
+	{
+		const double t = split_factor * scale;
+		scale_hi = t - (t - scale);
+		scale_lo = scale - scale_hi;
+	}
+
+	double scale;     //< 10^prec
+	double scale_hi;  //< High bits of scale
+	double scale_lo;  //< Low bits of scale
+};
+
+/**
+	Round value to a fixed number of decimal places using only arithmetic.
+
+	printf() rounds the exact binary value of d * 10^prec to the nearest integer
+	(ties to even), and reading the digits back divides that integer by 10^prec
+	with correct rounding. The product is computed exactly as q + e with
+	Dekker's algorithm, q is rounded with the 2^52 trick, and e decides the
+	cases where q itself landed exactly halfway between two integers. The
+	final division is correctly rounded by IEEE arithmetic, so the result
+	matches the text round-trip bit for bit.
+
+	@param[in] d Value to round
+	@param[in] ps Scale for the precision (at most max_exact_prec)
+	@param[out] result Rounded value
+	@retval ok False if |d * 10^prec| >= 2^52 or d is not finite, in which case
+		result is not set
+ */
+static inline bool
+round_scaled( double d, const Prec_Scale& ps, double* result )
+{
+	const double q = d * ps.scale;
+	const double a = std::fabs( q );
+	if( !(a < round_magic) )
+	{
+		return( false );
+	}
+
+	// exact error e of the product, so that d * scale == q + e
+	const double t    = split_factor * d;
+	const double d_hi = t - (t - d);
+	const double d_lo = d - d_hi;
+	double e = ((d_hi * ps.scale_hi - q) + d_hi * ps.scale_lo
+			+ d_lo * ps.scale_hi) + d_lo * ps.scale_lo;
+	if( std::signbit( d ) )
+	{
+		e = -e;
+	}
+
+	// round |q| and correct the rounding if the exact value was not a tie
+	double r = (a + round_magic) - round_magic;
+	const double f = a - r;
+	if( f == 0.5 && e > 0 )
+	{
+		r += 1;
+	}
+	else if( f == -0.5 && e < 0 )
+	{
+		r -= 1;
+	}
+
+	*result = std::copysign( r / ps.scale, d );
+	return( true );
 }
 
 /**
 	Change precision of floating-point value.
 
+	The result is the same as printing the value with "%.*f" and reading it
+	back, but is computed with arithmetic (see round_scaled()) rather than
+	text conversion for precisions up to 22 and values whose scaled magnitude
+	is below 2^52.
+
 	@param d Double value to change precision of
-	@param prec Precision to change value to
+	@param prec Precision to change value to (negative means 6, as in printf())
  */
 double
 double_prec( const double d, prec_type prec )
 {
+	if( prec < 0 )
+	{
+		prec = 6;
+	}
+
 	double value = 0;
-	char buf[ BUFSIZ ];
-	sprintf( buf, "%.*lf", prec, d );
-	sscanf( buf, "%lf", &value );
-	return( value );
+	if( prec <= max_exact_prec && round_scaled( d, Prec_Scale( prec ), &value ) )
+	{
+		return( value );
+	}
+	return( double_prec_text( d, prec ) );
+}
+
+#ifdef WS_TOOLS_X86_DISPATCH
+/**
+	Change precision of the values of an array 4 at a time using AVX, as
+	double_prec( double*, std::size_t, prec_type ) does.
+	@param[in,out] values Values to change precision of
+	@param[in] n Number of values
+	@param[in] ps Scale of the precision
+	@param[in] prec Precision to change values to
+	@retval i Number of values changed (a multiple of 4)
+ */
+static WS_TOOLS_TARGET( "avx" ) std::size_t
+double_prec_avx( double* values, std::size_t n, const Prec_Scale& ps,
+		prec_type prec )
+{
+	std::size_t i = 0;
+
+	const __m256d scale    = _mm256_set1_pd( ps.scale );
+	const __m256d scale_hi = _mm256_set1_pd( ps.scale_hi );
+	const __m256d scale_lo = _mm256_set1_pd( ps.scale_lo );
+	const __m256d split    = _mm256_set1_pd( split_factor );
+	const __m256d magic    = _mm256_set1_pd( round_magic );
+	const __m256d half     = _mm256_set1_pd( 0.5 );
+	const __m256d one      = _mm256_set1_pd( 1.0 );
+	const __m256d zero     = _mm256_setzero_pd();
+	const __m256d sign     = _mm256_set1_pd( -0.0 );
+
+	for( ; i + 4 <= n; i += 4 )
+	{
+		const __m256d d = _mm256_loadu_pd( values + i );
+		const __m256d q = _mm256_mul_pd( d, scale );
+		const __m256d d_sign = _mm256_and_pd( d, sign );
+		const __m256d a = _mm256_andnot_pd( sign, q );
+		const __m256d in_range = _mm256_cmp_pd( a, magic, _CMP_LT_OQ );
+
+		const __m256d t    = _mm256_mul_pd( split, d );
+		const __m256d d_hi = _mm256_sub_pd( t, _mm256_sub_pd( t, d ) );
+		const __m256d d_lo = _mm256_sub_pd( d, d_hi );
+		__m256d e = _mm256_sub_pd( _mm256_mul_pd( d_hi, scale_hi ), q );
+		e = _mm256_add_pd( e, _mm256_mul_pd( d_hi, scale_lo ) );
+		e = _mm256_add_pd( e, _mm256_mul_pd( d_lo, scale_hi ) );
+		e = _mm256_add_pd( e, _mm256_mul_pd( d_lo, scale_lo ) );
+		e = _mm256_xor_pd( e, d_sign );
+
+		__m256d r = _mm256_sub_pd( _mm256_add_pd( a, magic ), magic );
+		const __m256d f = _mm256_sub_pd( a, r );
+		const __m256d up = _mm256_and_pd(
+				_mm256_cmp_pd( f, half, _CMP_EQ_OQ ),
+				_mm256_cmp_pd( e, zero, _CMP_GT_OQ ) );
+		const __m256d down = _mm256_and_pd(
+				_mm256_cmp_pd( f, _mm256_xor_pd( half, sign ), _CMP_EQ_OQ ),
+				_mm256_cmp_pd( e, zero, _CMP_LT_OQ ) );
+		r = _mm256_add_pd( r, _mm256_and_pd( up, one ) );
+		r = _mm256_sub_pd( r, _mm256_and_pd( down, one ) );
+
+		const __m256d result = _mm256_or_pd( _mm256_div_pd( r, scale ),
+				d_sign );
+
+		const int ok = _mm256_movemask_pd( in_range );
+		if( ok == 0xF )
+		{
+			_mm256_storeu_pd( values + i, result );
+		}
+		else
+		{
+			double tmp[ 4 ];
+			_mm256_storeu_pd( tmp, result );
+			for( unsigned j = 0; j != 4; ++j )
+			{
+				values[ i + j ] = (ok & (1 << j)) ? tmp[j]
+					: double_prec_text( values[ i + j ], prec );
+			}
+		}
+	}
+	return( i );
+}
+#endif // WS_TOOLS_X86_DISPATCH
+
+/**
+	Change precision of each floating-point value in an array.
+
+	Each value is rounded exactly as by double_prec( values[i], prec ). The
+	arithmetic of round_scaled() is done on 4 (AVX, if the processor has it) or
+	2 (SSE2) values at a time without branches; the rare values that need the
+	text conversion are redone one at a time.
+
+	@param[in,out] values Values to change precision of
+	@param[in] n Number of values
+	@param[in] prec Precision to change values to (negative means 6)
+ */
+void
+double_prec( double* values, std::size_t n, prec_type prec )
+{
+	if( prec < 0 )
+	{
+		prec = 6;
+	}
+	if( prec > max_exact_prec )
+	{
+		for( std::size_t i = 0; i != n; ++i )
+		{
+			values[i] = double_prec_text( values[i], prec );
+		}
+		return;
+	}
+
+	const Prec_Scale ps( prec );
+	std::size_t i = 0;
+
+#ifdef WS_TOOLS_X86_DISPATCH
+	if( cpu_has_avx() )
+	{
+		i = double_prec_avx( values, n, ps, prec );
+	}
+#endif // WS_TOOLS_X86_DISPATCH
+
+#ifdef __SSE2__
+	{
+		const __m128d scale    = _mm_set1_pd( ps.scale );
+		const __m128d scale_hi = _mm_set1_pd( ps.scale_hi );
+		const __m128d scale_lo = _mm_set1_pd( ps.scale_lo );
+		const __m128d split    = _mm_set1_pd( split_factor );
+		const __m128d magic    = _mm_set1_pd( round_magic );
+		const __m128d half     = _mm_set1_pd( 0.5 );
+		const __m128d one      = _mm_set1_pd( 1.0 );
+		const __m128d zero     = _mm_setzero_pd();
+		const __m128d sign     = _mm_set1_pd( -0.0 );
+
+		for( ; i + 2 <= n; i += 2 )
+		{
+			const __m128d d = _mm_loadu_pd( values + i );
+			const __m128d q = _mm_mul_pd( d, scale );
+			const __m128d d_sign = _mm_and_pd( d, sign );
+			const __m128d a = _mm_andnot_pd( sign, q );
+			const __m128d in_range = _mm_cmplt_pd( a, magic );
+
+			const __m128d t    = _mm_mul_pd( split, d );
+			const __m128d d_hi = _mm_sub_pd( t, _mm_sub_pd( t, d ) );
+			const __m128d d_lo = _mm_sub_pd( d, d_hi );
+			__m128d e = _mm_sub_pd( _mm_mul_pd( d_hi, scale_hi ), q );
+			e = _mm_add_pd( e, _mm_mul_pd( d_hi, scale_lo ) );
+			e = _mm_add_pd( e, _mm_mul_pd( d_lo, scale_hi ) );
+			e = _mm_add_pd( e, _mm_mul_pd( d_lo, scale_lo ) );
+			e = _mm_xor_pd( e, d_sign );
+
+			__m128d r = _mm_sub_pd( _mm_add_pd( a, magic ), magic );
+			const __m128d f = _mm_sub_pd( a, r );
+			const __m128d up = _mm_and_pd( _mm_cmpeq_pd( f, half ),
+					_mm_cmpgt_pd( e, zero ) );
+			const __m128d down = _mm_and_pd(
+					_mm_cmpeq_pd( f, _mm_xor_pd( half, sign ) ),
+					_mm_cmplt_pd( e, zero ) );
+			r = _mm_add_pd( r, _mm_and_pd( up, one ) );
+			r = _mm_sub_pd( r, _mm_and_pd( down, one ) );
+
+			const __m128d result = _mm_or_pd( _mm_div_pd( r, scale ), d_sign );
+
+			const int ok = _mm_movemask_pd( in_range );
+			if( ok == 0x3 )
+			{
+				_mm_storeu_pd( values + i, result );
+			}
+			else
+			{
+				double tmp[ 2 ];
+				_mm_storeu_pd( tmp, result );
+				for( unsigned j = 0; j != 2; ++j )
+				{
+					values[ i + j ] = (ok & (1 << j)) ? tmp[j]
+						: double_prec_text( values[ i + j ], prec );
+				}
+			}
+		}
+	}
+#endif // __SSE2__
+
+	// remaining values (or all of them without SSE2)
+	for( ; i != n; ++i )
+	{
+		double value = 0;
+		values[i] = round_scaled( values[i], ps, &value ) ? value
+			: double_prec_text( values[i], prec );
+	}
+}
+
+/**
+	Convert the bytes not handled by the ASCII fast path using the current
+	locale, which only matters for single-byte locales such as ISO-8859-1 (in
+	the "C" and UTF-8 locales, toupper() leaves these bytes unchanged).
+	@param[in,out] p Bytes to convert
+	@param[in] n Number of bytes
+	@param[in] convert Locale conversion function, i.e., toupper() or tolower()
+ */
+static inline void
+convert_non_ascii( char* p, std::size_t n, int (*convert)( int ) )
+{
+	for( std::size_t i = 0; i != n; ++i )
+	{
+		const unsigned char c = static_cast<unsigned char>( p[i] );
+		if( c >= 0x80 )
+		{
+			p[i] = static_cast<char>( convert( c ) );
+		}
+	}
+}
+
+#ifdef WS_TOOLS_X86_DISPATCH
+/**
+	Flip the case of the letters in whole 32-byte blocks using AVX2, as
+	flip_ascii_case() does.
+	@param[in,out] p Bytes to convert
+	@param[in] n Number of bytes
+	@param[in] first First letter of the case to convert from ('a' or 'A')
+	@param[in] last Last letter of the case to convert from ('z' or 'Z')
+	@param[in] convert Locale conversion function for non-ASCII bytes
+	@retval i Number of bytes converted (a multiple of 32)
+ */
+static WS_TOOLS_TARGET( "avx2" ) std::size_t
+flip_ascii_case_avx2( char* p, std::size_t n, char first, char last,
+		int (*convert)( int ) )
+{
+	std::size_t i = 0;
+
+	const __m256i lo   = _mm256_set1_epi8( first - 1 );
+	const __m256i hi   = _mm256_set1_epi8( last + 1 );
+	const __m256i flip = _mm256_set1_epi8( 0x20 );
+	for( ; i + 32 <= n; i += 32 )
+	{
+		__m256i v = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>( p + i ) );
+		const __m256i is_letter = _mm256_and_si256(
+				_mm256_cmpgt_epi8( v, lo ), _mm256_cmpgt_epi8( hi, v ) );
+		v = _mm256_xor_si256( v, _mm256_and_si256( is_letter, flip ) );
+		_mm256_storeu_si256( reinterpret_cast<__m256i*>( p + i ), v );
+		if( _mm256_movemask_epi8( v ) != 0 )
+		{
+			convert_non_ascii( p + i, 32, convert );
+		}
+	}
+	return( i );
+}
+#endif // WS_TOOLS_X86_DISPATCH
+
+/**
+	Flip the case bit (0x20) of every byte in [first, last] in the given
+	buffer.
+
+	ASCII letters differ from their other case only in bit 0x20, so each vector
+	compare picks out the letters of one case in 16 or 32 bytes at a time and a
+	single XOR converts them. Bytes with the high bit set are never matched by
+	the signed compares; blocks containing such bytes are passed on to the
+	locale for just those bytes.
+
+	@param[in,out] p Bytes to convert
+	@param[in] n Number of bytes
+	@param[in] first First letter of the case to convert from ('a' or 'A')
+	@param[in] last Last letter of the case to convert from ('z' or 'Z')
+	@param[in] convert Locale conversion function for non-ASCII bytes
+ */
+static void
+flip_ascii_case( char* p, std::size_t n, char first, char last,
+		int (*convert)( int ) )
+{
+	std::size_t i = 0;
+
+#ifdef WS_TOOLS_X86_DISPATCH
+	if( cpu_has_avx2() )
+	{
+		i = flip_ascii_case_avx2( p, n, first, last, convert );
+	}
+#endif // WS_TOOLS_X86_DISPATCH
+
+#ifdef __SSE2__
+	{
+		const __m128i lo   = _mm_set1_epi8( first - 1 );
+		const __m128i hi   = _mm_set1_epi8( last + 1 );
+		const __m128i flip = _mm_set1_epi8( 0x20 );
+		for( ; i + 16 <= n; i += 16 )
+		{
+			__m128i v = _mm_loadu_si128(
+					reinterpret_cast<const __m128i*>( p + i ) );
+			const __m128i is_letter = _mm_and_si128(
+					_mm_cmpgt_epi8( v, lo ), _mm_cmplt_epi8( v, hi ) );
+			v = _mm_xor_si128( v, _mm_and_si128( is_letter, flip ) );
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( p + i ), v );
+			if( _mm_movemask_epi8( v ) != 0 )
+			{
+				convert_non_ascii( p + i, 16, convert );
+			}
+		}
+	}
+#endif // __SSE2__
+
+	// remaining bytes (or all of them without SSE2)
+	for( ; i != n; ++i )
+	{
+		const unsigned char c = static_cast<unsigned char>( p[i] );
+		if( c >= static_cast<unsigned char>( first )
+				&& c <= static_cast<unsigned char>( last ) )
+		{
+			p[i] = static_cast<char>( c ^ 0x20 );
+		}
+		else if( c >= 0x80 )
+		{
+			p[i] = static_cast<char>( convert( c ) );
+		}
+	}
 }
 
 /**
 	Convert string to uppercase.
+
+	ASCII letters are converted with vector instructions. Other bytes are left
+	to toupper(), so single-byte locales (e.g., ISO-8859-1) still have their
+	accented letters converted; multi-byte (UTF-8) text is only converted in its
+	ASCII letters, which is what toupper() did as well.
+
 	@param[in,out] str String to convert
 	@retval str Converted string
  */
 string&
 to_upper( string& str )
 {
-	for( unsigned i = 0; i != str.size(); ++i )
+	if( !str.empty() )
 	{
-		if( islower( str[i] ) )
-		{
-			str[i] = toupper( (int) str[i] );
-		}
+		flip_ascii_case( &str[0], str.size(), 'a', 'z', toupper );
 	}
 	return( str );
 }
 
 /**
 	Convert string to lowercase.
+
+	ASCII letters are converted with vector instructions; see to_upper() for
+	how other bytes are handled.
+
 	@param[in,out] str String to convert
 	@retval str Converted string
  */
 string&
 to_lower( string& str )
 {
-	for( unsigned i = 0; i != str.size(); ++i )
+	if( !str.empty() )
+	{
+		flip_ascii_case( &str[0], str.size(), 'A', 'Z', tolower );
+	}
+	return( str );
+}
+
+/**
+	Convert the ASCII uppercase letters in 8 bytes to lowercase at once.
+
+	Each byte is treated as a 7-bit number so that adding a constant to the
+	whole word cannot carry between bytes; the high bit of each byte then tells
+	whether the byte is >= 'A' and whether it is > 'Z'.
+
+	@param[in] w 8 bytes
+	@retval w 8 bytes with 'A'-'Z' replaced by 'a'-'z'
+ */
+static inline uint64_t
+fold_word( uint64_t w )
+{
+	const uint64_t ones      = 0x0101010101010101ULL;
+	const uint64_t high_bits = 0x8080808080808080ULL;
+
+	const uint64_t heptets  = w & ~high_bits;
+	const uint64_t is_ge_A  = heptets + (0x80 - 'A') * ones;
+	const uint64_t is_gt_Z  = heptets + (0x7F - 'Z') * ones;
+	const uint64_t is_upper = ~w & (is_ge_A ^ is_gt_Z) & high_bits;
+	return( w | (is_upper >> 2) );
+}
+
+/**
+	Convert a single ASCII uppercase letter to lowercase.
+	@param[in] c Byte
+	@retval c Folded byte
+ */
+static inline unsigned char
+fold_char( unsigned char c )
+{
+	return( (c >= 'A' && c <= 'Z') ? (c | 0x20) : c );
+}
+
+/**
+	Determine the length of the prefix of a and b that is equal ignoring ASCII
+	case.
+	@param[in] a First bytes
+	@param[in] b Second bytes
+	@param[in] n Number of bytes in each
+	@retval i Index of the first difference or n if none
+ */
+static std::size_t
+nocase_prefix( const char* a, const char* b, std::size_t n )
+{
+	std::size_t i = 0;
+
+	// compare 8 bytes at a time until a word differs
+	for( ; i + 8 <= n; i += 8 )
 	{
-		if( isupper( str[i] ) )
+		uint64_t wa, wb;
+		memcpy( &wa, a + i, 8 );
+		memcpy( &wb, b + i, 8 );
+		if( wa != wb && fold_word( wa ) != fold_word( wb ) )
 		{
-			str[i] = tolower( (int) str[i] );
+			break;
 		}
 	}
-	return( str );
+
+	for( ; i != n; ++i )
+	{
+		if( fold_char( a[i] ) != fold_char( b[i] ) )
+		{
+			break;
+		}
+	}
+	return( i );
+}
+
+/**
+	Determine if strings are equal ignoring the case of ASCII letters.
+	@param[in] a First string
+	@param[in] b Second string
+	@retval equal Whether the strings are equal
+ */
+bool
+equal_nocase( const string& a, const string& b )
+{
+	return( a.size() == b.size()
+			&& nocase_prefix( a.data(), b.data(), a.size() ) == a.size() );
+}
+
+/**
+	Compare strings ignoring the case of ASCII letters, as strcasecmp() does in
+	the "C" locale.
+	@param[in] a First string
+	@param[in] b Second string
+	@retval result Negative, zero, or positive if a is less than, equal to, or
+		greater than b
+ */
+int
+compare_nocase( const string& a, const string& b )
+{
+	const std::size_t n = std::min( a.size(), b.size() );
+	const std::size_t i = nocase_prefix( a.data(), b.data(), n );
+	if( i != n )
+	{
+		return( static_cast<int>( fold_char( a[i] ) )
+				- static_cast<int>( fold_char( b[i] ) ) );
+	}
+	return( (a.size() < b.size()) ? -1 : (a.size() > b.size()) );
+}
+
+/**
+	Hash string ignoring the case of ASCII letters, so that strings that are
+	equal_nocase() have the same hash.
+
+	Words of 8 bytes are folded and mixed at a time rather than byte by byte.
+
+	@param[in] str String to hash
+	@retval hash Hash value
+ */
+std::size_t
+hash_nocase( const string& str )
+{
+	const uint64_t mult = 0x9E3779B97F4A7C15ULL;
+	const char*    p    = str.data();
+	std::size_t    n    = str.size();
+
+	uint64_t h = n * mult;
+	for( ; n >= 8; p += 8, n -= 8 )
+	{
+		uint64_t w;
+		memcpy( &w, p, 8 );
+		h = (h ^ fold_word( w )) * mult;
+		h ^= h >> 29;
+	}
+	if( n != 0 )
+	{
+		uint64_t w = 0;
+		memcpy( &w, p, n );
+		h = (h ^ fold_word( w )) * mult;
+	}
+
+	// final avalanche (from MurmurHash3)
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDULL;
+	h ^= h >> 33;
+	return( static_cast<std::size_t>( h ) );
 }
 
 /**
@@ -987,6 +1914,154 @@ merge_quoted_words( vector<string>& words )
 	return( new_words );
 }
 
+/**
+	Split line into words in a single pass, skipping comments and keeping
+	quoted text together, i.e., the work of remove_comments(), split_string(),
+	and merge_quoted_words() combined.
+
+	Words are separated by any of the separator characters. A comment character
+	ends the line unless it is inside quotes. Text inside single quotes is taken
+	exactly as written. Text inside double quotes is also taken as written
+	except that a backslash escapes a following '"' or '\' and "\n" and "\t"
+	become a newline and tab. An unmatched quote extends to the end of the line.
+
+	The result differs from that of the three functions in these ways:
+	- A comment character inside quotes is kept (remove_comments() cuts the
+	  line at it).
+	- Quoted text joins any unquoted text it touches, e.g., dir='~/some  dir'/x
+	  is the single word dir=~/some  dir/x (merge_quoted_words() splits off the
+	  text before the quote and keeps the text after it as a separate word).
+	- '' is an empty word (merge_quoted_words() drops it).
+	- '"' is a quote character as well as '\'' (merge_quoted_words() treats it
+	  as an ordinary character).
+	Whitespace inside quotes is kept exactly, whereas merge_quoted_words()
+	joins the quoted words with single spaces.
+
+	Only the first num_words strings of words are set. The strings after them
+	are left in place, so calling lex_line() on each line of a file with the
+	same vector stops allocating once the vector and its strings are large
+	enough.
+
+	@param[in] line Line to split
+	@param[in,out] words List of words from line in the order that they
+		appeared (previous contents are replaced)
+	@param[in] comment_chars Characters that begin a comment
+	@param[in] separators Characters that separate words
+	@retval num_words Number of words found, i.e., the number of strings at the
+		start of words that were set
+ */
+unsigned
+lex_line( const string& line, vector<string>& words,
+		const string& comment_chars, const string& separators )
+{
+	enum Lex_State { Between_Words, In_Word, In_Single_Quote, In_Double_Quote };
+
+	// table lookups replace the find() calls on every character
+	enum { Other = 0, Separator, Comment };
+	unsigned char char_class[ 256 ] = { Other };
+	for( unsigned i = 0; i != separators.size(); ++i )
+	{
+		char_class[ static_cast<unsigned char>( separators[i] ) ] = Separator;
+	}
+	for( unsigned i = 0; i != comment_chars.size(); ++i )
+	{
+		char_class[ static_cast<unsigned char>( comment_chars[i] ) ] = Comment;
+	}
+
+	unsigned  num_words = 0;
+	string*   word      = 0;  // word being built
+	Lex_State state     = Between_Words;
+
+	const string::size_type n = line.size();
+	string::size_type       i = 0;
+	for( ; i != n; ++i )
+	{
+		const char c = line[i];
+
+		if( state == In_Single_Quote )
+		{
+			if( c == '\'' )
+			{
+				state = In_Word;
+			}
+			else
+			{
+				*word += c;
+			}
+			continue;
+		}
+
+		if( state == In_Double_Quote )
+		{
+			if( c == '"' )
+			{
+				state = In_Word;
+			}
+			else if( c == '\\' && i + 1 != n )
+			{
+				const char next = line[ i + 1 ];
+				switch( next )
+				{
+					case '"':
+					case '\\': *word += next; ++i; break;
+					case 'n':  *word += '\n'; ++i; break;
+					case 't':  *word += '\t'; ++i; break;
+					default:   *word += c;    break;
+				}
+			}
+			else
+			{
+				*word += c;
+			}
+			continue;
+		}
+
+		// unquoted character
+		const unsigned char type = char_class[ static_cast<unsigned char>( c ) ];
+		if( type == Comment )
+		{
+			break;
+		}
+		else if( type == Separator )
+		{
+			state = Between_Words;
+			continue;
+		}
+
+		// start a new word, reusing a previous string if there is one
+		if( state == Between_Words )
+		{
+			if( num_words == words.size() )
+			{
+				words.push_back( string() );
+			}
+			word = &words[ num_words++ ];
+			word->clear();
+			state = In_Word;
+		}
+
+		if( c == '\'' )
+		{
+			state = In_Single_Quote;
+		}
+		else if( c == '"' )
+		{
+			state = In_Double_Quote;
+		}
+		else
+		{
+			*word += c;
+		}
+	}
+
+	if( state == In_Single_Quote || state == In_Double_Quote )
+	{
+		err_warn( "Missing matching quote: Using remainder of line\n" );
+	}
+
+	return( num_words );
+}
+
 /**
 	Determine the number of digits in the given number.
 	@param[in] num Number to find the digit count in
@@ -995,14 +2070,7 @@ merge_quoted_words( vector<string>& words )
 int
 count_digits( unsigned num )
 {
-	// iterate i through the numbers 9, 99, 999, etc. until i is larger than
-	// the given number
-	int number_of_digits = 1;
-	for( int i = 9; i < static_cast<int>( num ); i = (i * 10 + 9) )
-	{
-		++number_of_digits;
-	}
-	return( number_of_digits );
+	return( count_digits_64( num ) );
 }
 
 } // namespace ws_tools
@@ -14,15 +14,18 @@
 #define __UTIL_HPP
 
 // c++ headers
+#include <algorithm>
 #include <exception>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 // c headers
 #include <cerrno>
 #include <cmath>
 #include <cstdarg>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -33,10 +36,19 @@
 #include <dirent.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 // local headers
 #include "err_mesg.h"
 
+// let the compiler check printf-style format strings against their arguments
+#ifdef __GNUC__
+	#define WS_PRINTF_FORMAT(fmt_idx, arg_idx) \
+		__attribute__(( format( printf, fmt_idx, arg_idx ) ))
+#else
+	#define WS_PRINTF_FORMAT(fmt_idx, arg_idx)
+#endif // __GNUC__
+
 namespace ws_tools
 {
 	/**
@@ -58,6 +70,14 @@ namespace ws_tools
 			const std::string& directory_name,
 			bool (*f)( const std::string& ) = all_true );
 
+	extern std::vector<std::string> dir_traverse_depth_first(
+			const std::string& directory_name,
+			bool (*f)( const std::string& ) = all_true );
+
+	extern std::vector<std::string> dir_traverse_sorted(
+			const std::string& directory_name,
+			bool (*f)( const std::string& ) = all_true );
+
 	extern void check_dir( std::string&, bool = true );
 
 	extern std::string sub_home( const std::string& );
@@ -79,16 +99,119 @@ namespace ws_tools
 	extern std::string get_base( const std::string& );
 	extern std::string get_ext(  const std::string& );
 
+	/// Size of a buffer large enough to hold any integer written by
+	/// format_int() or format_uint(), including the sign and terminating null
+	const unsigned INT_BUF_SIZE = 21;
+
+	/// Size of a buffer large enough to hold any double written by
+	/// format_double(), including the terminating null
+	const unsigned DOUBLE_BUF_SIZE = 32;
+
 	extern double string_to_double( const std::string& );
 	extern std::string int_to_string( const int );
+	extern std::string double_to_string( const double );
+
+	/*
+		Write numbers as text directly into a caller's buffer or onto the end of
+		a string without going through the printf() family.
+	 */
+	extern char* format_uint( char*, unsigned long long );
+	extern char* format_int( char*, long long );
+	extern char* format_double( char*, double );
+	extern std::string& append_int( std::string&, long long );
+	extern std::string& append_uint( std::string&, unsigned long long );
+	extern std::string& append_double( std::string&, double );
 	extern double double_prec( const double, prec_type );
+	extern void double_prec( double*, std::size_t, prec_type );
 
 	extern std::string& remove_comments( std::string&,
 			const std::string& = "#" );
 	extern std::vector<std::string> split_string( const std::string&,
 			const std::string& = " \t\n\r" );
 
-	extern std::string format_string( char*, ... );
+	/*
+		printf-style formatting of any length. append_format() writes onto the
+		end of an existing string, so a caller that clears and reuses the same
+		string does not allocate once its capacity has grown large enough.
+		format_temp() does the same with a buffer owned by the calling thread.
+	 */
+	extern std::string format_string( const char*, ... ) WS_PRINTF_FORMAT(1, 2);
+	extern std::string& append_format( std::string&, const char*, ... )
+		WS_PRINTF_FORMAT(2, 3);
+	extern std::string& vappend_format( std::string&, const char*, va_list )
+		WS_PRINTF_FORMAT(2, 0);
+	extern const std::string& format_temp( const char*, ... )
+		WS_PRINTF_FORMAT(1, 2);
+
+	/**
+		Append a single value as text to the end of the given string.
+
+		Characters and strings are copied, integers and floating-point values are
+		written with append_int(), append_uint(), and append_double(). Any other
+		type fails to compile, unlike a mismatched printf() conversion.
+
+		@param[in,out] str String to append to
+		@param[in] value Value to write
+		@retval str String with the value appended
+	 */
+	template<typename T>
+	inline std::string&
+	append_value( std::string& str, const T& value )
+	{
+		if constexpr( std::is_same<T, char>::value )
+		{
+			str += value;
+		}
+		else if constexpr( std::is_integral<T>::value
+				&& std::is_signed<T>::value )
+		{
+			append_int( str, value );
+		}
+		else if constexpr( std::is_integral<T>::value )
+		{
+			append_uint( str, value );
+		}
+		else if constexpr( std::is_floating_point<T>::value )
+		{
+			append_double( str, value );
+		}
+		else
+		{
+			// strings, string literals, and C-style strings
+			str += value;
+		}
+		return( str );
+	}
+
+	/**
+		Append each value as text to the end of the given string, e.g.,
+		append_values( line, "x=", x, ", n=", n ).
+		@param[in,out] str String to append to
+		@param[in] values Values to write in order
+		@retval str String with the values appended
+	 */
+	template<typename... Args>
+	inline std::string&
+	append_values( std::string& str, const Args&... values )
+	{
+		( append_value( str, values ), ... );
+		return( str );
+	}
+
+	/**
+		Create a string from the text of each value, e.g.,
+		concat_values( "Line ", line_num, ": ", message ).
+		@param[in] values Values to write in order
+		@retval str New string
+	 */
+	template<typename... Args>
+	inline std::string
+	concat_values( const Args&... values )
+	{
+		std::string str;
+		append_values( str, values... );
+		return( str );
+	}
 
 	/**
 		Determine if value is odd.
@@ -187,9 +310,44 @@ namespace ws_tools
 	 */
 	extern std::string& to_lower( std::string& );
 
+	/*
+		Compare and hash strings while ignoring the case of ASCII letters,
+		without making lowercase copies. Bytes outside of ASCII compare exactly.
+	 */
+	extern bool equal_nocase( const std::string&, const std::string& );
+	extern int compare_nocase( const std::string&, const std::string& );
+	extern std::size_t hash_nocase( const std::string& );
+
+	/**
+		@brief Hash function object for case-insensitive keys, e.g.,
+		std::unordered_map<std::string, T, Hash_Nocase, Equal_Nocase>.
+	 */
+	struct Hash_Nocase
+	{
+		std::size_t operator()( const std::string& str ) const
+		{
+			return( hash_nocase( str ) );
+		}
+	};
+
+	/**
+		@brief Equality function object for case-insensitive keys.
+	 */
+	struct Equal_Nocase
+	{
+		bool operator()( const std::string& a, const std::string& b ) const
+		{
+			return( equal_nocase( a, b ) );
+		}
+	};
+
 	extern std::vector<std::string> merge_quoted_words(
 			std::vector<std::string>& );
 
+	extern unsigned lex_line( const std::string&,
+			std::vector<std::string>&, const std::string& = "#",
+			const std::string& = " \t\n\r" );
+
 	/**
 		Determine the number of digits in the given number.
 		@param[in] num Number to find the digit count in
@@ -18,6 +18,23 @@
 #include "util.hpp"
 #include "Progress_Bar.hpp"
 #include "Config_File.hpp"
+#include "Random_Engine.hpp"
 #include "Random_Number.hpp"
+#include "Ziggurat.hpp"
+#include "Random_Distribution.hpp"
+#include "parallel.hpp"
+#include "cpu_features.hpp"
+#include "Mapped_File.hpp"
+#include "Delimited_Reader.hpp"
+#include "Line_Index.hpp"
+#include "Literal_Matcher.hpp"
+#include "file_scan.hpp"
+#include "string_sort.hpp"
+#include "Dir_Walker.hpp"
+#include "File_Table.hpp"
+#include "snapshot_diff.hpp"
+#include "tree_ops.hpp"
+#include "Glob_Pattern.hpp"
+#include "Reservoir_Sampler.hpp"
 
 #endif // _WS_TOOLS_HPP